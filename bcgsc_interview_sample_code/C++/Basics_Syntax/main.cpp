@@ -1,8 +1,12 @@
 /***
 *	Main Program for Assignment 1.
 *	Files: student_main.cpp, student_meth.cpp, string.cpp, string1.h, student.h
+*	       ../utilities/slot_map.h, ../utilities/dynamic_stack.h
 *	Author: Malachi Griffith
 *	Date: Feb 2, 2002.
+*	Compile: gcc -c ../../C/utilities/text_compare.c ../../C/utilities/simd_search.c
+*	         g++ -I../utilities -I../../C/utilities main.cpp student.cpp
+*	         string1.cpp text_compare.o simd_search.o
 ***/
 
 
@@ -12,10 +16,13 @@ using namespace std;
 #include "student.h"  // Unless using namespaces, use 'traditional' #include
                       // <file_name.h> looks for in compiler set directories
                       // "file_name.h" looks for in *current* directory.
+#include "slot_map.h" // Growable student table, O(1) add and remove.
 
 // Global Constants.
-const int MAX_NUM_STUDENTS = 100; // At most 100 students.
 const int MAX_STR_LENGTH = 100; // Max length of strings utilized.
+
+// The master list.  No size limit, students are packed densely in memory.
+typedef SlotMap<Student*> StudentTable;
 
 // Menu choices available to user.
 enum MenuChoiceEnum {ADD_STUDENT=1, REMOVE_STUDENT=2, PRINT_STUDENT=3, 
@@ -28,39 +35,35 @@ enum MenuChoiceEnum {ADD_STUDENT=1, REMOVE_STUDENT=2, PRINT_STUDENT=3,
 MenuChoiceEnum get_menu_choice();
 
 // Carries out menu action entered by user.
-void perform_menu_action(MenuChoiceEnum menuChoice, Student *list[],
-						 int &size);
+void perform_menu_action(MenuChoiceEnum menuChoice, StudentTable &list);
 
 // Functions for dealing with student objects.
 Student* create_student();
-int find_student(Student* list[], int &size);
-bool add_student(Student *s, Student* list[], int &size, int maxSize);
-void remove_student(Student* list[], int &size);
-void print_student(Student* list[], int &size);
-void print_list(Student* list[], int &size);
+int find_student(StudentTable &list);
+bool add_student(Student *s, StudentTable &list);
+void remove_student(StudentTable &list);
+void print_student(StudentTable &list);
+void print_list(StudentTable &list);
 
 int 
 main()
 {
-	Student *mList[MAX_NUM_STUDENTS]; // Array of pointers to students.
+	StudentTable mList;				  // Table of pointers to students.
 	MenuChoiceEnum  menuChoice;		  // User defined enumerated type var.
 	
-	// Size of array, will be passed to all other functions as a reference.
-	int numStudents = 0;			  
-									 
 	// Continue to ask user for a selection until they select 'EXIT'.
 	do
 	{
 		menuChoice = get_menu_choice();
-		perform_menu_action( menuChoice, mList, numStudents );
+		perform_menu_action( menuChoice, mList );
 	}
 	while (menuChoice != EXIT);
   
 	// Now delete any remaining students in the list.
-	for (int i = 0; i < numStudents; i++)
+	for (size_t i = 0; i < mList.size(); i++)
 		delete mList[i];
 
-	numStudents = 0;  // Just a good practice.
+	mList.clear();  // Just a good practice.
 	
 	return 0;
 }
@@ -109,7 +112,7 @@ get_menu_choice()
 ***/
 
 void 
-perform_menu_action(MenuChoiceEnum menuChoice, Student *list[], int &size)
+perform_menu_action(MenuChoiceEnum menuChoice, StudentTable &list)
 {
 	Student temp_student;
 
@@ -121,27 +124,27 @@ perform_menu_action(MenuChoiceEnum menuChoice, Student *list[], int &size)
 		Student *tempStudent;
 		tempStudent = create_student();	
     
-		test = add_student(tempStudent, list, size, MAX_NUM_STUDENTS); 
+		test = add_student(tempStudent, list); 
 		
 		if (test == false)
 		{
 			// Student not added.
 			cerr << "\n*** Student Not Added to List ***" << endl;
-			cerr << "*** Array is Full or Student Pointer is Null ***\n";
+			cerr << "*** Student Pointer is Null ***\n";
 		}
 
 		break;
 	
 	case REMOVE_STUDENT:
-		remove_student(list, size);
+		remove_student(list);
 		break;
 
 	case PRINT_STUDENT:
-		print_student(list, size);
+		print_student(list);
 		break;
 
 	case PRINT_LIST:
-		print_list(list, size);
+		print_list(list);
 		break;
   }
 }
@@ -194,23 +197,20 @@ create_student()
 
 
 /***
-*	If the Student pointer is not NULL, and the array of students is
-*	not full, add the student to the end of the pointer array,
-*	increment the 'size' argument accordingly.  Return 'true' is the
+*	If the Student pointer is not NULL, add the student to the table.
+*	The table grows as needed so it is never full.  Return 'true' is the
 *   student was added, otherwise return false and print an error message.
-*	Pre: A student object s, the student list[], the size of the array,
-*		 and the max size allowed are all defined.  Size will be updated
-*		 by reference, and the master list is also updated.
+*	Pre: A student object s and the student list are defined.  The
+*		 master list is updated by reference.
 *	Post: A boolean value (true or false is returned).
 ***/
 
 bool 
-add_student(Student *s, Student* list[], int &size, int maxSize)
+add_student(Student *s, StudentTable &list)
 {
-	if (s != NULL && size <= maxSize)
+	if (s != NULL)
 	{
-		list[size] = s;  // Add student to the master list.
-		size++;			 // Adjust the size of the master list.
+		list.insert(s);  // Add student to the master list.
 		return true;	 // Student added successfully.
 	}
 	else 
@@ -223,13 +223,12 @@ add_student(Student *s, Student* list[], int &size, int maxSize)
 *	student with that number and returns the index of the array that
 *	matches that student number.  Returns -1 is no student of that 
 *	number is found.
-*	Pre: The student list[] (array of pointers) and the size reference
-*		 are defined.
+*	Pre: The student list (table of pointers) is defined.
 *	Post: An integer value is returned.
 ***/
 
 int 
-find_student(Student* list[], int &size)
+find_student(StudentTable &list)
 {
 	int queryIndex = -1; // Location of target student in the master list.
 	unsigned long studentNumQuery; // Student # to search for in list.
@@ -239,7 +238,7 @@ find_student(Student* list[], int &size)
 	cout << "\nEnter the student # > ";
 	cin >> studentNumQuery;
 	
-	for (i = 0; i < size; i++)
+	for (i = 0; i < (int)list.size(); i++)
 	{
 		// Get a student # from list and compare to query student #.
 		tempStudentNumber = list[i]->get_student_number();
@@ -258,30 +257,23 @@ find_student(Student* list[], int &size)
 /***
 *	First calls the find_student() function to find the student object
 *   to be targeted for removal.  If the student is found that student object 
-*	is deleted from the array.  This leaves an empty space in the array so
-*   a for loop is used to shift all of the students following the space so
-*   that the array no longer contains any empty elements internally.  If the 
-*   student was not found an error message to that effect is displayed.
-*	Pre: The student list[] (array of pointers) and the size reference
-*		 are defined.
+*	is deleted and its place in the table is filled by the last student, so
+*   removal costs the same however long the list is (nothing is shifted).
+*   If the student was not found an error message to that effect is displayed.
+*	Pre: The student list (table of pointers) is defined.
 ***/
 
 void 
-remove_student(Student* list[], int &size)
+remove_student(StudentTable &list)
 {
 	int indexValue;  // Index location of student to be removed.
-	int i;			 // Loop control variable.
 
-	indexValue = find_student(list, size);
+	indexValue = find_student(list);
 
 	if (indexValue != -1)  // ie. if the student was found!
 	{
 		delete list[indexValue]; // Delete memory for that object.
-
-		// Fill in the empty space created by shifting values "up".
-		for (i = indexValue; i <= size; i++)
-			list[i] = list[i+1];
-		size--;
+		list.erase_at(indexValue); // Last student moves into the gap.
 	}
 	else
 		cerr << "\n*** No Student of that Number in the List ***" << endl;
@@ -293,16 +285,15 @@ remove_student(Student* list[], int &size)
 *   to be displayed to the user.  If it is found, the student is printed
 *   using the print() behaviour of the Student Class.  If the student #
 *	is not found, an error message to that effect is displayed.
-*	Pre: The student list[] (array of pointers) and the size reference
-*		 are defined.
+*	Pre: The student list (table of pointers) is defined.
 ***/
 
 void 
-print_student(Student* list[], int &size)
+print_student(StudentTable &list)
 {
 	int indexValue; // Array location of student to be printed.
 	
-	indexValue = find_student(list, size);
+	indexValue = find_student(list);
 
 	// Now print the student using the print behaviour of the student object.
 	if (indexValue != -1)  // ie. if the student was found!
@@ -319,18 +310,17 @@ print_student(Student* list[], int &size)
 *	removed.  It will also be helpful when sorting or other more involved
 *	functions are added to the program (ie. for future feature developement).
 *	If the list is empty, the user is informed.
-*	Pre: The student list[] (array of pointers) and the size reference
-*		 are defined.
+*	Pre: The student list (table of pointers) is defined.
 ***/
 
 void 
-print_list(Student* list[], int &size)
+print_list(StudentTable &list)
 {
-	int i;  // Loop control variable.
+	size_t i;  // Loop control variable.
 
-	for (i = 0; i < size; i++)
+	for (i = 0; i < list.size(); i++)
 		list[i]->print();  // Print behaviour of student object.
 
-	if (size == 0)
+	if (list.empty())
 		cerr << "\n*** The list is Empty ***" << endl;
 }
@@ -1,9 +1,11 @@
 #include <iostream>
+#include <cstring>
 using namespace std;
 
 #include "string1.h" // Have changed name because my Visual C++ Studio
 					 // already has a string.h and it was being included
 					 // by default.
+#include "text_compare.h"
 
 
 #define errMsg "<Error> String::" 
@@ -109,3 +111,28 @@ void String::set_to_empty_string()
 
 
 
+/****
+  Equality: same length and characters.
+*****/
+bool operator==(const String &a, const String &b)
+{
+  return TextEqual(a.get_data(), a.length(), b.get_data(), b.length()) != 0;
+}
+
+bool operator!=(const String &a, const String &b)
+{
+  return !(a == b);
+}
+
+
+/****
+  Ordering: by the first differing character (as unsigned char), then
+  the shorter first.
+*****/
+bool operator<(const String &a, const String &b)
+{
+  return TextCompare(a.get_data(), a.length(), b.get_data(), b.length()) < 0;
+}
+
+
+
@@ -25,4 +25,10 @@ private:
   char*	dm_data;
 };
 
+// Comparisons, by ../../C/utilities/text_compare.c: == checks the
+// lengths before any characters; < is byte order with a prefix first.
+bool operator==(const String &a, const String &b);
+bool operator!=(const String &a, const String &b);
+bool operator<(const String &a, const String &b);
+
 #endif
@@ -2,13 +2,23 @@
 *	Main Program for Assignment 3.
 *	Files: main.cpp, student.cpp, course.cpp, my_string.cpp, person.cpp
 *	       student.h, course.h, my_string.h, person.h
+*	       ../utilities/probe.h, ../utilities/probe.cpp
 *	Author: Malachi Griffith
 *	Date: March 11, 2002.
+*	Compile: gcc -c ../../C/utilities/text_compare.c ../../C/utilities/simd_search.c
+*	         g++ -std=c++11 -I../utilities -I../../C/utilities main.cpp
+*	         student.cpp course.cpp my_string.cpp person.cpp
+*	         ../utilities/probe.cpp text_compare.o simd_search.o
+*	Probe timings for the list searches, course loading and printing are
+*	written to stderr on exit (or on SIGUSR1), see probe.h.
 ***/
 
 #include <iostream>
 #include <fstream>
 #include <list>  // The STL list class will be used to hold the objects
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 using namespace std;
 
 /***  I have included all of the classes being used in this file.  Even though
@@ -19,6 +29,7 @@ using namespace std;
 ***/
 #include "student.h"  
 #include "course.h"
+#include "probe.h"	// PROBE_SCOPE() timing of the hot paths.
 
 // Global Constants and Variables
 static list<Student*> g_StudentList;  // Creates the default empty student list
@@ -52,6 +63,7 @@ void print_list();
 list<Course*>& master_course_list();
 void init_courses(list<Course*> &cList, String &fileName);
 list<Course*>::iterator find_course(list<Course*> &cList);
+list<Course*>::iterator find_course_by_name(list<Course*> &cList, const String &name);
 void add_course(list<Student*> &sList, list<Course*> &cList);
 void remove_course(list<Student*> &sList);
 void print_course();
@@ -377,7 +389,7 @@ add_student()
 *	find_student():
 *	Asks the user for a student number, searches the array for a 
 *	student with that number and returns an iterator to the target student
-*	with that student number.  Returns null(0) if no student of that 
+*	with that student number.  Returns sList.end() if no student of that 
 *	number is found.
 *	Pre: A reference to the master list is passed is defined.
 *	Post: An interator value is returned.  This specifies the location (by
@@ -396,6 +408,8 @@ find_student(list<Student*> &sList)
 	// Ask user for student #
 	cout << "\nEnter the student # > ";
 	cin >> studentNumQuery;
+
+	PROBE_SCOPE("find_student");  // Time the search, not the typing.
 	
 	while (itr != sList.end())
 	{
@@ -410,7 +424,7 @@ find_student(list<Student*> &sList)
 		itr++;  // If not found, advance to next element in the list.
 	}
 
-	return 0;  // Return null if student not found.
+	return sList.end();  // Student not found.
 }
 
 
@@ -445,7 +459,7 @@ remove_student()
 	// Get the iterator value (address) for that element in the list.
 	studentFound = find_student(sList);
 
-	if (studentFound == 0)  // ie. if the student was not found!
+	if (studentFound == sList.end())  // ie. if the student was not found!
 	{
 		cerr << "\n*** No Student of that Number in the List ***" << endl;
 		return;
@@ -509,7 +523,7 @@ print_student()
 	// Get iterator for target student.
 	studentFound = find_student(sList);
 
-	if (studentFound == 0)  // ie. if the student was not found!
+	if (studentFound == sList.end())  // ie. if the student was not found!
 	{
 		cerr << "\n*** No Student of that Number in the List ***" << endl;
 		return;
@@ -519,6 +533,7 @@ print_student()
 	studentPtr = *studentFound;  // Get pointer to that student using iterator
 
 	// Print the student info using the student object print() behaviour.
+	PROBE_SCOPE("print_student");
 	studentPtr->print();
 }
 
@@ -536,6 +551,7 @@ print_student()
 void 
 print_list()
 {
+	PROBE_SCOPE("print_list");
 	list<Student*> &sList = master_student_list(); // reference to student list.
 	list<Course*> &cList = master_course_list();   // reference to course list.
 	Student *studentPtr;  // local pointer to student object
@@ -606,6 +622,7 @@ list<Course*>& master_course_list()
 void 
 init_courses(list<Course*> &cList, String &fileName)
 {
+	PROBE_SCOPE("init_courses");
 	int numEntries;			// Number of course entries specified in the file.
 	char tempName[1000];	// Temp array for input of course names.
 	char junk[5];			// For dealing with input buffer problems.
@@ -635,6 +652,11 @@ init_courses(list<Course*> &cList, String &fileName)
 	{
 		iFile.getline(tempName, 999);
 
+		// Drop the '\r' of a DOS line end, or the name could not be typed.
+		int nameLen = strlen(tempName);
+		if (nameLen > 0 && tempName[nameLen - 1] == '\r')
+			tempName[nameLen - 1] = '\0';
+
 		// Create Course objects via Dynamic Memory Allocation
 		c = new Course(tempName);
 
@@ -655,9 +677,9 @@ init_courses(list<Course*> &cList, String &fileName)
 /***
 *	find_course():
 *	Displays the given list of courses available in the master course list,
-*	asks the user to select one (by index # starting at 1) then it finds the 
-*   corresponding iterator in the STL list and returns this iterator value (an
-*	address).  Returns null (0) if course not found,
+*	asks the user to select one (by index # starting at 1, or by name) then it
+*   finds the corresponding iterator in the STL list and returns this iterator
+*	value (an address).  Returns cList.end() if course not found,
 *	ie. in this case if the user selects a number that is not in the list.
 *	Pre: A reference to the master course list is defined.
 *	Post: An list<Course*> iterator value is returned.
@@ -669,6 +691,7 @@ find_course(list<Course*> &cList)
 	int counter = 1; // Helper counting variable. 
 	int index = -1;	 // Index of course selected. (initialize to -1)
 	Course *c;		 // Local pointer to course object.
+	char entry[MAX_STR_LENGTH];	// Course number or name typed.
 
 
 	// First display the courses available to the user:
@@ -685,14 +708,26 @@ find_course(list<Course*> &cList)
 		itr++;
 	}
 
-	cout << "Select a Course > ";
-	cin >> index;
+	cout << "Select a Course (number or name) > ";
+	cin >> ws;  // Skip the end of the line before.
+	cin.getline(entry, MAX_STR_LENGTH-1);
+
+	// Anything not starting with a digit is taken as a course name.
+	if (!isdigit((unsigned char)entry[0]))
+	{
+		itr = find_course_by_name(cList, String(entry));
+		if (itr != cList.end())
+			return itr;
+		index = 0;  // No such course, refused below.
+	}
+	else
+		index = atoi(entry);
 
-	// Make sure their entry was valid, otherwise return 0
+	// Make sure their entry was valid, otherwise return cList.end()
 	if (index <= 0 || index > cList.size())  // ie. not 1-5.
 	{
 		cerr << "\n*** Not a Valid Course Entry ***" << endl;
-		return 0;
+		return cList.end();
 	}
 
 	// Now loop through the list again and grab the iterator corresponding to
@@ -709,7 +744,36 @@ find_course(list<Course*> &cList)
 		itr++;
 	}
 
-	return 0; // Return Null if course not found.
+	return cList.end(); // Course not found.
+}
+
+
+/***
+*	find_course_by_name():
+*	Searches the given course list for the course called name and returns
+*	its iterator, or cList.end() if there is none.  Each course name keeps
+*	its hash once it has been worked out, so the courses passed over cost
+*	one compare of two numbers each; the text is only compared (String ==)
+*	when the hashes agree.
+*	Pre: A reference to the master course list and a name are defined.
+***/
+
+list<Course*>::iterator
+find_course_by_name(list<Course*> &cList, const String &name)
+{
+	PROBE_SCOPE("find_course_by_name");
+	unsigned long long key = name.hash();
+	list<Course*>::iterator itr = cList.begin();
+
+	while (itr != cList.end())
+	{
+		const String &courseName = (*itr)->get_name();
+
+		if (courseName.hash() == key && courseName == name)
+			return itr;
+		itr++;
+	}
+	return cList.end();
 }
 
 
@@ -752,7 +816,7 @@ add_course(list<Student*> &sList, list<Course*> &cList)
 	studentFound = find_student(sList);
 
 	// If that student was not found, display error message and return.
-	if (studentFound == 0)
+	if (studentFound == sList.end())
 	{
 		cerr << "\n*** No Student of that Number in the List ***" << endl;
 		return;
@@ -765,7 +829,7 @@ add_course(list<Student*> &sList, list<Course*> &cList)
 	courseFound = find_course(cList);
 
 	// If that course was not found, return.
-	if (courseFound == 0)
+	if (courseFound == cList.end())
 		return;
 	
 	// Get pointer to course object using iterator returned by find_course()
@@ -808,7 +872,7 @@ remove_course(list<Student*> &sList)
 	studentFound = find_student(sList);
 	
 	// If the student was not found display error message and return.
-	if (studentFound == 0)
+	if (studentFound == sList.end())
 	{
 		cerr << "\n*** No Student of that Number in the List ***" << endl;
 		return;
@@ -831,7 +895,7 @@ remove_course(list<Student*> &sList)
 	courseFound = find_course(cList);
 
 	// If that course was not found, return.
-	if (courseFound == 0)
+	if (courseFound == cList.end())
 		return;
 	
 	// Get pointer to course object using iterator returned by find_course()
@@ -869,12 +933,13 @@ void print_course()
 	courseFound = find_course(cList);
 
 	// Check for error in find_course result.
-	if (courseFound == 0)
+	if (courseFound == cList.end())
 		return;  // Error message already displayed in find_course()
 
 	tempCourse = *courseFound;
 
 	// Display Course's student list using the method designed to do just that.
+	PROBE_SCOPE("print_course");
 	tempCourse->print_students();
 }
 
@@ -1,7 +1,9 @@
 #include <iostream>
+#include <cstring>
 using namespace std;
 
 #include "my_string.h"
+#include "text_compare.h"
 
 #define errMsg "<Error> String::"
 
@@ -31,6 +33,8 @@ String::String(const String &s)
     dm_len = s.dm_len;
     dm_data = new char[dm_len+1];
     strcpy(dm_data, s.dm_data);
+    dm_hash = s.dm_hashed ? s.dm_hash : 0;
+    dm_hashed = s.dm_hashed;
   }
   else {
     set_to_empty_string();
@@ -57,6 +61,8 @@ String::String(const char* s)
     dm_len = strlen(s);
     dm_data = new char[dm_len+1];
     strcpy(dm_data, s); 
+    dm_hash = 0;
+    dm_hashed = false;
   }
 }
 
@@ -119,6 +125,7 @@ void String::set_data(const char *s)
     delete [] dm_data;
     dm_data = new char[dm_len+1];
     strcpy(dm_data, s);
+    dm_hashed = false;
   }
 }
 
@@ -126,17 +133,29 @@ void String::set_data(const char *s)
 /****
 
 *****/
-char& String::operator[]( int idx )
+String::char_ref String::operator[]( int idx )
 {
   if ( idx<0 || idx>=dm_len )
   {
     static char tmp;	// static so it doesn't go away...
     cerr << errMsg << "operator[]" << endl;
     cerr << " out of bounds:"<<idx<<endl;
-    return tmp; 
+    return char_ref(*this, &tmp); 
   }
 
-  return dm_data[idx];
+  return char_ref(*this, dm_data + idx);
+}
+
+
+/****
+  Writing a character through operator[] - the kept hash no longer
+  matches, so it goes.
+*****/
+String::char_ref& String::char_ref::operator=(char c)
+{
+  *dm_char = c;
+  dm_str.dm_hashed = false;
+  return *this;
 }
 
 
@@ -164,6 +183,52 @@ void String::set_to_empty_string()
   dm_len = 0;
   dm_data = new char[1];
   dm_data[0] = '\0';
+  dm_hash = 0;
+  dm_hashed = false;
+}
+
+
+/****
+  hash() - TextHash() of the characters, kept for next time.
+*****/
+unsigned long long String::hash() const
+{
+  if ( !dm_hashed )
+  {
+    dm_hash = TextHash(dm_data, dm_len);
+    dm_hashed = true;
+  }
+  return dm_hash;
+}
+
+
+/****
+  Equality: same length and characters.  Hashes are only compared when
+  both strings already have one, so a single comparison costs no
+  hashing.
+*****/
+bool operator==(const String &a, const String &b)
+{
+  if ( a.dm_len != b.dm_len )
+    return false;
+  if ( a.dm_hashed && b.dm_hashed && a.dm_hash != b.dm_hash )
+    return false;
+  return TextEqual(a.dm_data, a.dm_len, b.dm_data, b.dm_len) != 0;
+}
+
+bool operator!=(const String &a, const String &b)
+{
+  return !(a == b);
+}
+
+
+/****
+  Ordering: by the first differing character (as unsigned char), then
+  the shorter first.
+*****/
+bool operator<(const String &a, const String &b)
+{
+  return TextCompare(a.data(), a.length(), b.data(), b.length()) < 0;
 }
 
 
@@ -24,7 +24,25 @@ public:
   const String& operator=(const String &s);
   const String& operator=(const char *s);
 
-  char& operator[]( int idx );
+  // What the non-const operator[] hands out.  It reads as a char, and a
+  // write through it also drops the kept hash, however long after the
+  // call it is made.
+  class char_ref
+  {
+  public:
+    char_ref(String &s, char *c) : dm_str(s), dm_char(c) {}
+
+    operator char() const { return *dm_char; }
+    char_ref& operator=(char c);
+    char_ref& operator=(const char_ref &r) { return *this = char(r); }
+
+  private:
+    String&	dm_str;
+    char*	dm_char;
+  };
+  friend class char_ref;
+
+  char_ref operator[]( int idx );
   char  operator[]( int idx ) const;
 
   int length() const { return dm_len; };
@@ -34,12 +52,28 @@ public:
   void  set_data(const char *s);
   void  set_data(const String &s);
 
+  // Worked out the first time it is asked for and kept until the string
+  // changes.  Two strings that have both been hashed and whose hashes
+  // differ are unequal without a look at their text.
+  unsigned long long hash() const;
+
+  friend bool operator==(const String &a, const String &b);
+
 private:
   void set_to_empty_string();
 
   int		dm_len;
   char*	dm_data;
+  mutable unsigned long long dm_hash;
+  mutable bool dm_hashed;
 };
 
+// Comparisons use ../../C/utilities/text_compare.c: equality checks the
+// lengths (and kept hashes) first, then the bytes 32 at a time; < is
+// byte order with a prefix first, as strcmp().
+bool operator==(const String &a, const String &b);
+bool operator!=(const String &a, const String &b);
+bool operator<(const String &a, const String &b);
+
 
 #endif
@@ -0,0 +1,731 @@
+/***
+*	Benchmark for the registry operations of Assignment 3.
+*	Files: registry_bench.cpp, student.cpp, course.cpp, my_string.cpp,
+*	       person.cpp (not main.cpp, which is the interactive program).
+*	Author: Malachi Griffith
+*	Date: Oct. 19 2026
+*	Compile: gcc -O2 -c ../../C/utilities/text_compare.c
+*	         ../../C/utilities/simd_search.c
+*	         g++ -std=c++11 -O2 -I../../C/utilities -o registry_bench
+*	         registry_bench.cpp student.cpp course.cpp person.cpp my_string.cpp
+*	         text_compare.o simd_search.o
+*
+*	Builds a registry of N students and M courses, enrols every student
+*	in K courses picked uniformly or by a Zipf law (a few very popular
+*	courses), and times each class of operation:
+*		add_student			create a student and push it on the master list.
+*		add_course			main.cpp's add_course(): find the student by
+*							number, find the course by index, enrol both ways.
+*		course_add_student	Course::add_student() alone.
+*		find_student		main.cpp's find_student() search by number.
+*		find_course_name	main.cpp's find_course_by_name(): hashes
+*							first, then String == on a hash match.
+*		remove_student		main.cpp's remove_student(): find, drop from
+*							every course, erase, delete.
+*	Each is run 'warmup' times unmeasured then 'reps' times measured, and
+*	min / median / mean / max ns per operation are written as CSV or JSON.
+*
+*	Usage: registry_bench [-n students] [-m courses] [-k per_student]
+*	       [-d uniform|zipf] [-s zipf_exponent] [-q queries] [-x removals]
+*	       [-w warmup] [-r reps] [-f csv|json] [-o file] [-S seed]
+***/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <list>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+using namespace std;
+
+#include "student.h"
+#include "course.h"
+
+// Benchmark settings, filled in from the command line.
+struct BenchConfig
+{
+	long numStudents;
+	long numCourses;
+	long perStudent;	// Courses each student enrols in.
+	bool zipf;
+	double zipfExponent;
+	long numQueries;
+	long numRemovals;
+	int warmup;
+	int reps;
+	bool json;
+	string outFile;
+	unsigned long seed;
+};
+
+// Result of one operation class over all measured repetitions.
+struct BenchResult
+{
+	string operation;
+	long opsPerRep;
+	vector<double> nsPerOp;		// One entry per measured repetition.
+};
+
+// A registry under test, same containers as main.cpp.
+struct Registry
+{
+	list<Student*> students;
+	list<Course*> courses;
+};
+
+// Timings of a single repetition, in total nanoseconds.
+struct RepTimes
+{
+	double addStudent;
+	double addCourse;
+	double courseAddStudent;
+	double findStudent;
+	double findCourseName;
+	double removeStudent;
+};
+
+// *** FUNCTION PROTOTYPES *** //
+
+bool parse_args(int argc, char *argv[], BenchConfig &cfg);
+vector< vector<long> > make_enrolments(const BenchConfig &cfg, mt19937_64 &rng);
+list<Student*>::iterator locate_student(list<Student*> &sList, unsigned long number);
+list<Course*>::iterator locate_course(list<Course*> &cList, long index);
+list<Course*>::iterator locate_course_by_name(list<Course*> &cList, const String &name);
+void enrol(list<Student*> &sList, list<Course*> &cList, unsigned long number, long index);
+void drop_student(Registry &reg, unsigned long number);
+RepTimes run_once(const BenchConfig &cfg, const vector< vector<long> > &enrolments,
+				  mt19937_64 &rng);
+void clear_registry(Registry &reg);
+void write_csv(ostream &os, const BenchConfig &cfg, const vector<BenchResult> &results);
+void write_json(ostream &os, const BenchConfig &cfg, const vector<BenchResult> &results);
+
+static void usage(const char *prog);
+static bool parse_count(const char *val, long &count);
+static bool parse_count(const char *val, int &count);
+static bool parse_exponent(const char *val, double &exponent);
+static bool parse_seed(const char *val, unsigned long &seed);
+static long draw_course(const vector<double> &tree, long step, double u);
+static double elapsed_ns(chrono::steady_clock::time_point start);
+static void summarize(const vector<double> &v, double &mn, double &med,
+					  double &mean, double &mx);
+
+// Swallows the "Course Added" chatter while timing.  The formatting is
+// still done, so it is still counted as part of the operation.
+class NullBuffer : public streambuf
+{
+protected:
+	int overflow(int c) {return c;}
+	streamsize xsputn(const char *, streamsize n) {return n;}
+};
+
+
+// *** MAIN *** //
+
+int
+main(int argc, char *argv[])
+{
+	BenchConfig cfg;
+
+	if (!parse_args(argc, argv, cfg))
+		return 1;
+
+	mt19937_64 rng(cfg.seed);
+	vector< vector<long> > enrolments = make_enrolments(cfg, rng);
+
+	BenchResult results[6];
+	results[0].operation = "add_student";
+	results[0].opsPerRep = cfg.numStudents;
+	results[1].operation = "add_course";
+	results[1].opsPerRep = cfg.numStudents * cfg.perStudent;
+	results[2].operation = "course_add_student";
+	results[2].opsPerRep = cfg.numStudents * cfg.perStudent;
+	results[3].operation = "find_student";
+	results[3].opsPerRep = cfg.numQueries;
+	results[4].operation = "find_course_name";
+	results[4].opsPerRep = cfg.numQueries;
+	results[5].operation = "remove_student";
+	results[5].opsPerRep = cfg.numRemovals;
+
+	// Quieten cout/cerr while the registry classes run.
+	NullBuffer nullBuf;
+	streambuf *oldOut = cout.rdbuf(&nullBuf);
+	streambuf *oldErr = cerr.rdbuf(&nullBuf);
+
+	for (int rep = 0; rep < cfg.warmup + cfg.reps; rep++)
+	{
+		RepTimes t = run_once(cfg, enrolments, rng);
+
+		if (rep < cfg.warmup)
+			continue;
+
+		double totals[6] = {t.addStudent, t.addCourse, t.courseAddStudent,
+							t.findStudent, t.findCourseName, t.removeStudent};
+		for (int i = 0; i < 6; i++)
+			if (results[i].opsPerRep > 0)
+				results[i].nsPerOp.push_back(totals[i] / results[i].opsPerRep);
+	}
+
+	cout.rdbuf(oldOut);
+	cerr.rdbuf(oldErr);
+
+	vector<BenchResult> kept;
+	for (int i = 0; i < 6; i++)
+		if (results[i].opsPerRep > 0)
+			kept.push_back(results[i]);
+
+	ofstream oFile;
+	if (!cfg.outFile.empty())
+	{
+		oFile.open(cfg.outFile.c_str());
+		if (!oFile.is_open())
+		{
+			cerr << "\n*** Could not open " << cfg.outFile << " ***" << endl;
+			return 1;
+		}
+	}
+	ostream &os = cfg.outFile.empty() ? cout : oFile;
+
+	if (cfg.json)
+		write_json(os, cfg, kept);
+	else
+		write_csv(os, cfg, kept);
+
+	return 0;
+}
+
+
+/***
+*	parse_args():
+*	Fills in cfg from the command line, starting from defaults.  Returns
+*	false (after printing usage) on a bad option or value: a count that
+*	is not a whole number of 0 or more, an exponent that is not a finite
+*	number of 0 or more, or a name not in the list.
+***/
+
+bool
+parse_args(int argc, char *argv[], BenchConfig &cfg)
+{
+	cfg.numStudents = 2000;
+	cfg.numCourses = 200;
+	cfg.perStudent = 5;
+	cfg.zipf = false;
+	cfg.zipfExponent = 1.0;
+	cfg.numQueries = 2000;
+	cfg.numRemovals = 200;
+	cfg.warmup = 1;
+	cfg.reps = 5;
+	cfg.json = false;
+	cfg.seed = 12345;
+
+	for (int i = 1; i < argc; i++)
+	{
+		string opt = argv[i];
+
+		if (i + 1 >= argc || opt.size() != 2 || opt[0] != '-')
+		{
+			usage(argv[0]);
+			return false;
+		}
+
+		const char *val = argv[++i];
+		bool ok = true;
+
+		switch (opt[1])
+		{
+		case 'n': ok = parse_count(val, cfg.numStudents); break;
+		case 'm': ok = parse_count(val, cfg.numCourses); break;
+		case 'k': ok = parse_count(val, cfg.perStudent); break;
+		case 'd':
+			ok = (strcmp(val, "zipf") == 0 || strcmp(val, "uniform") == 0);
+			cfg.zipf = (strcmp(val, "zipf") == 0);
+			break;
+		case 's': ok = parse_exponent(val, cfg.zipfExponent); break;
+		case 'q': ok = parse_count(val, cfg.numQueries); break;
+		case 'x': ok = parse_count(val, cfg.numRemovals); break;
+		case 'w': ok = parse_count(val, cfg.warmup); break;
+		case 'r': ok = parse_count(val, cfg.reps); break;
+		case 'f':
+			ok = (strcmp(val, "json") == 0 || strcmp(val, "csv") == 0);
+			cfg.json = (strcmp(val, "json") == 0);
+			break;
+		case 'o': cfg.outFile = val; break;
+		case 'S': ok = parse_seed(val, cfg.seed); break;
+		default:
+			cerr << "\n*** Unknown option " << opt << " ***" << endl;
+			usage(argv[0]);
+			return false;
+		}
+
+		if (!ok)
+		{
+			cerr << "\n*** Bad value " << val << " for " << opt << " ***" << endl;
+			usage(argv[0]);
+			return false;
+		}
+	}
+
+	if (cfg.numStudents < 1 || cfg.numCourses < 1 || cfg.reps < 1)
+	{
+		cerr << "\n*** Need at least one student, course and rep ***" << endl;
+		usage(argv[0]);
+		return false;
+	}
+
+	// A student can not take the same course twice.
+	if (cfg.perStudent > cfg.numCourses)
+		cfg.perStudent = cfg.numCourses;
+	if (cfg.numRemovals > cfg.numStudents)
+		cfg.numRemovals = cfg.numStudents;
+
+	return true;
+}
+
+
+/***
+*	make_enrolments():
+*	For every student picks perStudent distinct course indexes (1 based,
+*	as find_course() numbers them).  Zipf: course r is picked with
+*	probability proportional to 1 / r^s, so course 1 is the most popular.
+*	The courses are drawn one at a time without replacement: the weights
+*	sit in a Fenwick tree, a course drawn has its weight taken out so it
+*	can not come up again, and the nodes changed are copied back from the
+*	untouched tree for the next student.  So a draw is O(log M) however
+*	few courses are left, even when -k is close to -m.
+***/
+
+vector< vector<long> >
+make_enrolments(const BenchConfig &cfg, mt19937_64 &rng)
+{
+	long m = cfg.numCourses;
+	vector<double> weight(m + 1), full(m + 1, 0.0);
+	double total = 0.0;
+
+	// full[c] sums the weights of courses c - lowbit(c) + 1 to c.
+	for (long c = 1; c <= m; c++)
+	{
+		weight[c] = cfg.zipf ? 1.0 / pow((double)c, cfg.zipfExponent) : 1.0;
+		total += weight[c];
+		full[c] += weight[c];
+		if (c + (c & -c) <= m)
+			full[c + (c & -c)] += full[c];
+	}
+
+	long step = 1;
+	while (step * 2 <= m)
+		step *= 2;
+
+	uniform_real_distribution<double> unit(0.0, 1.0);
+	vector< vector<long> > enrolments(cfg.numStudents);
+	vector<double> tree(full);
+	vector<char> taken(m + 1, 0);
+
+	for (long s = 0; s < cfg.numStudents; s++)
+	{
+		vector<long> &mine = enrolments[s];
+		double left = total;
+
+		while ((long)mine.size() < cfg.perStudent)
+		{
+			long c = draw_course(tree, step, unit(rng) * left);
+
+			// Rounding can leave a crumb of a taken course's weight.
+			if (taken[c])
+				continue;
+
+			taken[c] = 1;
+			mine.push_back(c);
+			left -= weight[c];
+			for (long i = c; i <= m; i += i & -i)
+				tree[i] -= weight[c];
+		}
+
+		for (size_t k = 0; k < mine.size(); k++)
+		{
+			taken[mine[k]] = 0;
+			for (long i = mine[k]; i <= m; i += i & -i)
+				tree[i] = full[i];
+		}
+	}
+
+	return enrolments;
+}
+
+
+/***
+*	locate_student() / locate_course() / locate_course_by_name():
+*	The search loops of main.cpp's find_student(), find_course() and
+*	find_course_by_name(), without the prompts.  Return end() when not
+*	found.
+***/
+
+list<Student*>::iterator
+locate_student(list<Student*> &sList, unsigned long number)
+{
+	list<Student*>::iterator itr = sList.begin();
+
+	while (itr != sList.end())
+	{
+		if ((*itr)->get_student_number() == number)
+			return itr;
+		itr++;
+	}
+	return sList.end();
+}
+
+list<Course*>::iterator
+locate_course(list<Course*> &cList, long index)
+{
+	list<Course*>::iterator itr = cList.begin();
+	long counter = 1;
+
+	while (itr != cList.end())
+	{
+		if (counter == index)
+			return itr;
+		counter++;
+		itr++;
+	}
+	return cList.end();
+}
+
+list<Course*>::iterator
+locate_course_by_name(list<Course*> &cList, const String &name)
+{
+	unsigned long long key = name.hash();
+	list<Course*>::iterator itr = cList.begin();
+
+	while (itr != cList.end())
+	{
+		const String &courseName = (*itr)->get_name();
+
+		if (courseName.hash() == key && courseName == name)
+			return itr;
+		itr++;
+	}
+	return cList.end();
+}
+
+// main.cpp's add_course() with the student and course already chosen.
+void
+enrol(list<Student*> &sList, list<Course*> &cList, unsigned long number, long index)
+{
+	list<Student*>::iterator studentFound = locate_student(sList, number);
+	list<Course*>::iterator courseFound = locate_course(cList, index);
+
+	if (studentFound == sList.end() || courseFound == cList.end())
+		return;
+
+	(*studentFound)->add_course(*courseFound);
+	(*courseFound)->add_student(*studentFound);
+}
+
+// main.cpp's remove_student() with the student number already chosen.
+void
+drop_student(Registry &reg, unsigned long number)
+{
+	list<Student*>::iterator studentFound = locate_student(reg.students, number);
+
+	if (studentFound == reg.students.end())
+		return;
+
+	Student *tempStudent = *studentFound;
+	list<Course*>::iterator itr = reg.courses.begin();
+
+	while (itr != reg.courses.end())
+	{
+		(*itr)->remove_student(tempStudent);
+		itr++;
+	}
+
+	reg.students.erase(studentFound);
+	delete tempStudent;
+}
+
+
+/***
+*	run_once():
+*	One repetition: builds a fresh registry and times every phase.
+*	Student numbers are 1..N.
+***/
+
+RepTimes
+run_once(const BenchConfig &cfg, const vector< vector<long> > &enrolments,
+		 mt19937_64 &rng)
+{
+	RepTimes t;
+	Registry reg;
+	Registry shadow;	// Second set of courses for Course::add_student() alone.
+	chrono::steady_clock::time_point start;
+
+	for (long c = 0; c < cfg.numCourses; c++)
+	{
+		ostringstream name;
+		name << "Course " << (c + 1);
+		reg.courses.push_back(new Course(name.str().c_str()));
+		shadow.courses.push_back(new Course(name.str().c_str()));
+	}
+
+	vector<Course*> shadowCourses(shadow.courses.begin(), shadow.courses.end());
+
+	// add_student
+	start = chrono::steady_clock::now();
+	for (long s = 0; s < cfg.numStudents; s++)
+	{
+		Student *newStudent = new UnderGradStudent("Benchmark project");
+		newStudent->set_name("Student");
+		newStudent->set_address("Address");
+		newStudent->set_student_number(s + 1);
+		reg.students.push_back(newStudent);
+	}
+	t.addStudent = elapsed_ns(start);
+
+	vector<Student*> byNumber(reg.students.begin(), reg.students.end());
+
+	// add_course
+	start = chrono::steady_clock::now();
+	for (long s = 0; s < cfg.numStudents; s++)
+		for (size_t i = 0; i < enrolments[s].size(); i++)
+			enrol(reg.students, reg.courses, s + 1, enrolments[s][i]);
+	t.addCourse = elapsed_ns(start);
+
+	// course_add_student
+	start = chrono::steady_clock::now();
+	for (long s = 0; s < cfg.numStudents; s++)
+		for (size_t i = 0; i < enrolments[s].size(); i++)
+			shadowCourses[enrolments[s][i] - 1]->add_student(byNumber[s]);
+	t.courseAddStudent = elapsed_ns(start);
+
+	// find_student
+	uniform_int_distribution<unsigned long> pick(1, cfg.numStudents);
+	vector<unsigned long> queries(cfg.numQueries);
+	for (long q = 0; q < cfg.numQueries; q++)
+		queries[q] = pick(rng);
+
+	volatile unsigned long hits = 0;
+	start = chrono::steady_clock::now();
+	for (long q = 0; q < cfg.numQueries; q++)
+		if (locate_student(reg.students, queries[q]) != reg.students.end())
+			hits = hits + 1;
+	t.findStudent = elapsed_ns(start);
+
+	// find_course_name (the names asked for are made up front, as typed)
+	uniform_int_distribution<long> pickCourse(1, cfg.numCourses);
+	vector<String> names;
+	names.reserve(cfg.numQueries);
+	for (long q = 0; q < cfg.numQueries; q++)
+	{
+		ostringstream name;
+		name << "Course " << pickCourse(rng);
+		names.push_back(String(name.str().c_str()));
+	}
+
+	start = chrono::steady_clock::now();
+	for (long q = 0; q < cfg.numQueries; q++)
+		if (locate_course_by_name(reg.courses, names[q]) != reg.courses.end())
+			hits = hits + 1;
+	t.findCourseName = elapsed_ns(start);
+
+	// remove_student (distinct students, so each removal finds its target)
+	vector<unsigned long> victims(cfg.numStudents);
+	for (long s = 0; s < cfg.numStudents; s++)
+		victims[s] = s + 1;
+	shuffle(victims.begin(), victims.end(), rng);
+
+	start = chrono::steady_clock::now();
+	for (long r = 0; r < cfg.numRemovals; r++)
+		drop_student(reg, victims[r]);
+	t.removeStudent = elapsed_ns(start);
+
+	clear_registry(shadow);		// Shadow courses point at reg's students,
+	clear_registry(reg);		// so free them first.
+
+	return t;
+}
+
+void
+clear_registry(Registry &reg)
+{
+	list<Student*>::iterator s = reg.students.begin();
+	while (s != reg.students.end())
+	{
+		delete *s;
+		s++;
+	}
+	reg.students.clear();
+
+	list<Course*>::iterator c = reg.courses.begin();
+	while (c != reg.courses.end())
+	{
+		delete *c;
+		c++;
+	}
+	reg.courses.clear();
+}
+
+
+// *** OUTPUT *** //
+
+void
+write_csv(ostream &os, const BenchConfig &cfg, const vector<BenchResult> &results)
+{
+	os << "operation,students,courses,per_student,distribution,zipf_exponent,"
+	   << "reps,ops_per_rep,min_ns_per_op,median_ns_per_op,mean_ns_per_op,"
+	   << "max_ns_per_op\n";
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		double mn, med, mean, mx;
+		summarize(results[i].nsPerOp, mn, med, mean, mx);
+
+		os << results[i].operation << ',' << cfg.numStudents << ','
+		   << cfg.numCourses << ',' << cfg.perStudent << ','
+		   << (cfg.zipf ? "zipf" : "uniform") << ',' << cfg.zipfExponent << ','
+		   << cfg.reps << ',' << results[i].opsPerRep << ','
+		   << mn << ',' << med << ',' << mean << ',' << mx << '\n';
+	}
+}
+
+void
+write_json(ostream &os, const BenchConfig &cfg, const vector<BenchResult> &results)
+{
+	os << "{\n  \"benchmark\": \"registry\",\n"
+	   << "  \"students\": " << cfg.numStudents << ",\n"
+	   << "  \"courses\": " << cfg.numCourses << ",\n"
+	   << "  \"per_student\": " << cfg.perStudent << ",\n"
+	   << "  \"distribution\": \"" << (cfg.zipf ? "zipf" : "uniform") << "\",\n"
+	   << "  \"zipf_exponent\": " << cfg.zipfExponent << ",\n"
+	   << "  \"warmup\": " << cfg.warmup << ",\n"
+	   << "  \"reps\": " << cfg.reps << ",\n"
+	   << "  \"seed\": " << cfg.seed << ",\n"
+	   << "  \"results\": [\n";
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		double mn, med, mean, mx;
+		summarize(results[i].nsPerOp, mn, med, mean, mx);
+
+		os << "    {\"operation\": \"" << results[i].operation << "\", "
+		   << "\"ops_per_rep\": " << results[i].opsPerRep << ", "
+		   << "\"min_ns_per_op\": " << mn << ", "
+		   << "\"median_ns_per_op\": " << med << ", "
+		   << "\"mean_ns_per_op\": " << mean << ", "
+		   << "\"max_ns_per_op\": " << mx << "}"
+		   << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	os << "  ]\n}\n";
+}
+
+static void
+usage(const char *prog)
+{
+	cerr << "Usage: " << prog << " [-n students] [-m courses]"
+		 << " [-k per_student] [-d uniform|zipf] [-s zipf_exponent]"
+		 << " [-q queries] [-x removals] [-w warmup] [-r reps]"
+		 << " [-f csv|json] [-o file] [-S seed]" << endl;
+}
+
+// A whole number of 0 or more with nothing after it, else false.
+static bool
+parse_count(const char *val, long &count)
+{
+	char *end;
+
+	errno = 0;
+	long n = strtol(val, &end, 10);
+	if (end == val || *end != '\0' || errno == ERANGE || n < 0)
+		return false;
+	count = n;
+	return true;
+}
+
+// The same for an int.
+static bool
+parse_count(const char *val, int &count)
+{
+	long n;
+
+	if (!parse_count(val, n) || n > INT_MAX)
+		return false;
+	count = (int)n;
+	return true;
+}
+
+// A finite number of 0 or more with nothing after it, else false.
+static bool
+parse_exponent(const char *val, double &exponent)
+{
+	char *end;
+
+	errno = 0;
+	double x = strtod(val, &end);
+	if (end == val || *end != '\0' || errno == ERANGE || !std::isfinite(x) ||
+		x < 0)
+		return false;
+	exponent = x;
+	return true;
+}
+
+// A whole number that fits an unsigned long; strtoul() would take "-1".
+static bool
+parse_seed(const char *val, unsigned long &seed)
+{
+	char *end;
+
+	errno = 0;
+	unsigned long n = strtoul(val, &end, 10);
+	if (end == val || *end != '\0' || errno == ERANGE || strchr(val, '-'))
+		return false;
+	seed = n;
+	return true;
+}
+
+// The course (1 based) whose share of the cumulative weights holds u,
+// walking down the Fenwick tree; step is the largest power of two no
+// more than the number of courses.
+static long
+draw_course(const vector<double> &tree, long step, double u)
+{
+	long m = (long)tree.size() - 1, pos = 0;
+
+	for (; step > 0; step /= 2)
+	{
+		if (pos + step <= m && tree[pos + step] <= u)
+		{
+			pos += step;
+			u -= tree[pos];
+		}
+	}
+	return pos < m ? pos + 1 : m;
+}
+
+static double
+elapsed_ns(chrono::steady_clock::time_point start)
+{
+	return (double)chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now() - start).count();
+}
+
+static void
+summarize(const vector<double> &v, double &mn, double &med, double &mean, double &mx)
+{
+	vector<double> sorted(v);
+	double sum = 0.0;
+
+	sort(sorted.begin(), sorted.end());
+	for (size_t i = 0; i < sorted.size(); i++)
+		sum += sorted[i];
+
+	mn = sorted.front();
+	mx = sorted.back();
+	mean = sum / sorted.size();
+	med = (sorted.size() % 2) ? sorted[sorted.size() / 2]
+		: (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+}
@@ -4,9 +4,13 @@
 *	       student.h, course.h, my_string.h, linked_list.h
 *	Author: Malachi Griffith
 *	Date: March 11, 2002.
+*	Compile: gcc -c ../../C/utilities/text_compare.c ../../C/utilities/simd_search.c
+*	         g++ -I../../C/utilities *.cpp text_compare.o simd_search.o
 ***/
 
 #include <iostream>
+#include <cctype>
+#include <cstdlib>
 using namespace std;
 
 /***  I have included all of the classes being used in this file.  Even though
@@ -51,6 +55,7 @@ void print_list();
 LinkedList & master_course_list();
 void init_courses(LinkedList &cList);
 int find_course(const LinkedList &cList);
+int find_course_by_name(const LinkedList &cList, const String &name);
 void add_course(LinkedList &sList, LinkedList &cList);
 void remove_course(LinkedList &sList);
 
@@ -499,8 +504,8 @@ init_courses(LinkedList &cList)
 /***
 *	find_course():
 *	Displays the given list of courses available in the master course list,
-*	asks the user to select one (by index # starting at 1) returns the 
-*	selected *list* index, starting at 0.  Returns -1 if course not found,
+*	asks the user to select one (by index # starting at 1, or by name) returns
+*	the selected *list* index, starting at 0.  Returns -1 if course not found,
 *	ie. in this case if the user selects a number that is not in the list.
 *	Pre: A reference to the master course list is defined.
 *	Post: An integer value is returned.  This integer specifies the index of the
@@ -512,6 +517,7 @@ find_course(const LinkedList &cList)
 {
 	int index = -1;	// Index of course selected. (initialize to -1)
 	Course *c;		// Local pointer to course object.
+	char entry[MAX_STR_LENGTH];	// Course number or name typed.
 
 
 	// First display the courses available to the user:
@@ -523,8 +529,15 @@ find_course(const LinkedList &cList)
 		cout << i+1 << ". - " << (*c) << endl;
 	}
 
-	cout << "Select a Course > ";
-	cin >> index;
+	cout << "Select a Course (number or name) > ";
+	cin >> ws;  // Skip the end of the line before.
+	cin.getline(entry, MAX_STR_LENGTH-1);
+
+	// Anything not starting with a digit is taken as a course name.
+	if (!isdigit((unsigned char)entry[0]))
+		index = find_course_by_name(cList, String(entry)) + 1;
+	else
+		index = atoi(entry);
 
 	// Make sure their entry was valid, otherwise return -1
 	if (index <= 0 || index > cList.size())  // ie. not 1-5.
@@ -537,6 +550,32 @@ find_course(const LinkedList &cList)
 }
 
 
+/***
+*	find_course_by_name():
+*	Returns the list index (from 0) of the course called name, or -1 if
+*	there is none.  Each course name keeps its hash once it has been
+*	worked out, so the courses passed over cost one compare of two
+*	numbers each; the text is only compared (String ==) when the hashes
+*	agree.
+*	Pre: A reference to the master course list and a name are defined.
+***/
+
+int
+find_course_by_name(const LinkedList &cList, const String &name)
+{
+	unsigned long long key = name.hash();
+
+	for (int i = 0; i < cList.size(); i++)
+	{
+		const String &courseName = ((const Course*)cList[i])->get_name();
+
+		if (courseName.hash() == key && courseName == name)
+			return i;
+	}
+	return -1;
+}
+
+
 
 /***
 *	add_course():
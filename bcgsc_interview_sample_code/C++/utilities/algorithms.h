@@ -0,0 +1,549 @@
+#ifndef _ALGORITHMS_H_	// To avoid multiple and recursive inclusions
+#define _ALGORITHMS_H_
+
+#include <cstddef>	// size_t
+#include <algorithm>	// std::swap, std::iter_swap
+#include <functional>	// std::less, std::greater
+#include <iterator>	// std::iterator_traits
+#include <type_traits>	// std::is_same, std::is_arithmetic
+#include <vector>
+
+#include "parallel_sort.h"
+#include "simd_search.h"
+
+/***
+*	A small algorithms library grown out of the swap / bubble_sort
+*	templates of uofw_courses_code/cpp/basics/template_functions.cpp.
+*	Every algorithm takes an iterator range and, optionally, a comparison
+*	('less', any function or functor taking two values, returning bool)
+*	or a predicate.  Defaults are operator<.
+*
+*	algo_sort(first, last [, less])		Not stable.
+*	algo_stable_sort(first, last [, less])	Equal items keep their order.
+*	algo_partial_sort(first, middle, last [, less])
+*		Just [first, middle) sorted, holding the smallest items.
+*	algo_lower_bound(first, last, value [, less])
+*	algo_binary_search(first, last, value [, less])	true if found.
+*	algo_merge(first1, last1, first2, last2, out [, less])
+*		Two sorted ranges into out, stable.  Returns the end of out.
+*	algo_partition(first, last, pred)
+*		Items for which pred() is true to the front, returns the first
+*		of the rest.  Not stable.
+*
+*	The range and comparison types pick the code at compile time:
+*	  - int or double items in contiguous memory (pointers or vector
+*	    iterators) with std::less / std::greater (or the default) are
+*	    sorted by radix_sort(), so linear time.  Only ints for
+*	    algo_stable_sort(), since -0.0 == 0.0 but the radix sort moves
+*	    them apart.
+*	  - algo_binary_search() on such ranges narrows down to a few dozen
+*	    items, then looks for the value with the vector search kernels
+*	    of simd_search.c.
+*	  - algo_merge() and algo_partition() on any arithmetic type use
+*	    loops with no data dependent branches.
+*	  - anything else takes the general template: introsort
+*	    (parallel_sort), bottom up merge sort, a heap, and so on.
+*
+*	Compile: g++ -I../utilities -I../../C/utilities ... with the C files
+*	from ../../C/utilities built by gcc:
+*		gcc -std=c11 -c sort_lib.c thread_pool.c work_deque.c simd_search.c
+*	and link with -pthread.  Needs C++14 (std::less<>).
+***/
+
+template <class RandomIt, class Less>
+void algo_sort(RandomIt first, RandomIt last, Less less);
+template <class RandomIt>
+void algo_sort(RandomIt first, RandomIt last);
+
+template <class RandomIt, class Less>
+void algo_stable_sort(RandomIt first, RandomIt last, Less less);
+template <class RandomIt>
+void algo_stable_sort(RandomIt first, RandomIt last);
+
+template <class RandomIt, class Less>
+void algo_partial_sort(RandomIt first, RandomIt middle, RandomIt last,
+	Less less);
+template <class RandomIt>
+void algo_partial_sort(RandomIt first, RandomIt middle, RandomIt last);
+
+template <class RandomIt, class T, class Less>
+RandomIt algo_lower_bound(RandomIt first, RandomIt last, const T &value,
+	Less less);
+template <class RandomIt, class T>
+RandomIt algo_lower_bound(RandomIt first, RandomIt last, const T &value);
+
+template <class RandomIt, class T, class Less>
+bool algo_binary_search(RandomIt first, RandomIt last, const T &value,
+	Less less);
+template <class RandomIt, class T>
+bool algo_binary_search(RandomIt first, RandomIt last, const T &value);
+
+template <class InIt1, class InIt2, class OutIt, class Less>
+OutIt algo_merge(InIt1 first1, InIt1 last1, InIt2 first2, InIt2 last2,
+	OutIt out, Less less);
+template <class InIt1, class InIt2, class OutIt>
+OutIt algo_merge(InIt1 first1, InIt1 last1, InIt2 first2, InIt2 last2,
+	OutIt out);
+
+template <class It, class Pred>
+It algo_partition(It first, It last, Pred pred);
+
+
+// *** Implementation *** //
+
+const size_t ALGO_RUN = 16;		// Stable sort: insertion sorted runs.
+const ptrdiff_t ALGO_SEARCH_WINDOW = 32;	// Binary search: left to the kernel.
+
+const int ALGO_UNKNOWN_ORDER = 0;
+const int ALGO_ASCENDING = 1;
+const int ALGO_DESCENDING = 2;
+
+// Which path to take, as a type, so the choice is made by overloading.
+template <bool Fast>
+struct AlgoPath {};
+
+// The order a comparison gives values of type V, if it is a known one.
+template <class Less, class V>
+struct AlgoOrder
+{
+	static const int value =
+		std::is_same<Less, std::less<V> >::value ||
+		std::is_same<Less, std::less<> >::value ||
+		std::is_same<Less, PsortLess<V> >::value ? ALGO_ASCENDING :
+		std::is_same<Less, std::greater<V> >::value ||
+		std::is_same<Less, std::greater<> >::value ? ALGO_DESCENDING :
+		ALGO_UNKNOWN_ORDER;
+};
+
+// True if It walks V's that lie next to each other in memory.
+template <class It, class V>
+struct AlgoContiguous
+{
+	static const bool value = std::is_same<It, V*>::value ||
+		std::is_same<It, typename std::vector<V>::iterator>::value;
+};
+
+// True if [first, last) of It can be put in 'less' order by radix_sort().
+template <class It, class Less, bool Doubles>
+struct AlgoRadixable
+{
+	static const bool value =
+		(AlgoContiguous<It, int>::value &&
+			AlgoOrder<Less, int>::value != ALGO_UNKNOWN_ORDER) ||
+		(Doubles && AlgoContiguous<It, double>::value &&
+			AlgoOrder<Less, double>::value != ALGO_UNKNOWN_ORDER);
+};
+
+// True if It holds numbers, for the branch free loops.
+template <class It>
+struct AlgoArithmetic
+{
+	static const bool value = std::is_arithmetic<
+		typename std::iterator_traits<It>::value_type>::value;
+};
+
+// * algo_sort * //
+
+template <class RandomIt, class Less>
+void
+algo_sort_path(RandomIt first, RandomIt last, Less, AlgoPath<true>)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	if (last - first < 2)
+		return;
+	radix_sort(&*first, &*first + (last - first),
+		AlgoOrder<Less, V>::value == ALGO_DESCENDING);
+}
+
+template <class RandomIt, class Less>
+void
+algo_sort_path(RandomIt first, RandomIt last, Less less, AlgoPath<false>)
+{
+	parallel_sort(first, last, less);
+}
+
+template <class RandomIt, class Less>
+void
+algo_sort(RandomIt first, RandomIt last, Less less)
+{
+	algo_sort_path(first, last, less,
+		AlgoPath<AlgoRadixable<RandomIt, Less, true>::value>());
+}
+
+template <class RandomIt>
+void
+algo_sort(RandomIt first, RandomIt last)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	algo_sort(first, last, std::less<V>());
+}
+
+// * algo_stable_sort * //
+
+// Insertion sort of one run, moving each item only once.
+template <class RandomIt, class Less>
+void
+algo_insertion_sort(RandomIt first, RandomIt last, Less less)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	for (RandomIt i = first + (first != last); i < last; ++i)
+	{
+		V item = *i;
+		RandomIt j = i;
+
+		for (; j > first && less(item, *(j - 1)); --j)
+			*j = *(j - 1);
+		*j = item;
+	}
+}
+
+// One bottom up pass: merges neighbouring runs of 'width' from src to dst.
+template <class InIt, class OutIt, class Less>
+void
+algo_merge_pass(InIt src, size_t count, OutIt dst, size_t width, Less less)
+{
+	for (size_t start = 0; start < count; start += 2 * width)
+	{
+		size_t middle = start + width < count ? start + width : count;
+		size_t end = start + 2 * width < count ? start + 2 * width : count;
+
+		algo_merge(src + start, src + middle, src + middle, src + end,
+			dst + start, less);
+	}
+}
+
+template <class RandomIt, class Less>
+void
+algo_stable_sort_path(RandomIt first, RandomIt last, Less less,
+	AlgoPath<true>)
+{
+	algo_sort_path(first, last, less, AlgoPath<true>());
+}
+
+// Insertion sorted runs of ALGO_RUN, then merge passes that go back and
+// forth between the range and one buffer the same size.
+template <class RandomIt, class Less>
+void
+algo_stable_sort_path(RandomIt first, RandomIt last, Less less,
+	AlgoPath<false>)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	size_t count = last - first;
+	if (count < 2)
+		return;
+
+	for (size_t start = 0; start < count; start += ALGO_RUN)
+		algo_insertion_sort(first + start,
+			first + (start + ALGO_RUN < count ? start + ALGO_RUN : count),
+			less);
+	if (count <= ALGO_RUN)
+		return;
+
+	std::vector<V> buffer(first, last);
+	bool inBuffer = false;
+
+	for (size_t width = ALGO_RUN; width < count; width *= 2)
+	{
+		if (inBuffer)
+			algo_merge_pass(buffer.begin(), count, first, width, less);
+		else
+			algo_merge_pass(first, count, buffer.begin(), width, less);
+		inBuffer = !inBuffer;
+	}
+
+	if (inBuffer)
+		std::copy(buffer.begin(), buffer.end(), first);
+}
+
+template <class RandomIt, class Less>
+void
+algo_stable_sort(RandomIt first, RandomIt last, Less less)
+{
+	algo_stable_sort_path(first, last, less,
+		AlgoPath<AlgoRadixable<RandomIt, Less, false>::value>());
+}
+
+template <class RandomIt>
+void
+algo_stable_sort(RandomIt first, RandomIt last)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	algo_stable_sort(first, last, std::less<V>());
+}
+
+// * algo_partial_sort * //
+
+// A heap of [first, middle) with the largest at the top; each later item
+// smaller than the top replaces it.  Then the heap is sorted.  O(n log k).
+template <class RandomIt, class Less>
+void
+algo_partial_sort(RandomIt first, RandomIt middle, RandomIt last, Less less)
+{
+	size_t k = middle - first;
+	if (k == 0)
+		return;
+
+	for (size_t i = k / 2; i > 0; i--)
+		psort_sift_down(first, i - 1, k, less);
+
+	for (RandomIt i = middle; i < last; ++i)
+		if (less(*i, *first))
+		{
+			std::iter_swap(i, first);
+			psort_sift_down(first, 0, k, less);
+		}
+
+	for (size_t i = k - 1; i > 0; i--)
+	{
+		std::iter_swap(first, first + i);
+		psort_sift_down(first, 0, i, less);
+	}
+}
+
+template <class RandomIt>
+void
+algo_partial_sort(RandomIt first, RandomIt middle, RandomIt last)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	algo_partial_sort(first, middle, last, std::less<V>());
+}
+
+// * algo_lower_bound and algo_binary_search * //
+
+// Halves the range without branching on the comparison, stopping once
+// 'stop' items are left.  The answer is then in [*first, *first + *count].
+template <class RandomIt, class T, class Less>
+void
+algo_narrow(RandomIt *first, ptrdiff_t *count, const T &value, Less less,
+	ptrdiff_t stop)
+{
+	RandomIt base = *first;
+	ptrdiff_t n = *count;
+
+	while (n > stop)
+	{
+		ptrdiff_t half = n / 2;
+		base += less(base[half], value) ? half : 0;
+		n -= half;
+	}
+	*first = base;
+	*count = n;
+}
+
+template <class RandomIt, class T, class Less>
+RandomIt
+algo_lower_bound(RandomIt first, RandomIt last, const T &value, Less less)
+{
+	ptrdiff_t n = last - first;
+
+	if (n == 0)
+		return first;
+	algo_narrow(&first, &n, value, less, 1);
+	return first + less(*first, value);
+}
+
+template <class RandomIt, class T>
+RandomIt
+algo_lower_bound(RandomIt first, RandomIt last, const T &value)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	return algo_lower_bound(first, last, value, std::less<V>());
+}
+
+inline long
+algo_find(const int *values, size_t count, int key)
+{
+	return FindInt(values, count, key);
+}
+
+inline long
+algo_find(const double *values, size_t count, double key)
+{
+	return FindDouble(values, count, key);
+}
+
+template <class RandomIt, class T, class Less>
+bool
+algo_binary_search_path(RandomIt first, RandomIt last, const T &value,
+	Less less, AlgoPath<true>)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	ptrdiff_t n = last - first;
+	if (n == 0)
+		return false;
+
+	algo_narrow(&first, &n, value, less, ALGO_SEARCH_WINDOW);
+
+	// The first item >= value may be the one just past the window.
+	if (n < last - first)
+		n++;
+	return algo_find(&*first, n, static_cast<V>(value)) >= 0;
+}
+
+template <class RandomIt, class T, class Less>
+bool
+algo_binary_search_path(RandomIt first, RandomIt last, const T &value,
+	Less less, AlgoPath<false>)
+{
+	first = algo_lower_bound(first, last, value, less);
+	return first != last && !less(value, *first);
+}
+
+template <class RandomIt, class T, class Less>
+bool
+algo_binary_search(RandomIt first, RandomIt last, const T &value, Less less)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	// The kernels compare with ==, which is only the same as "neither is
+	// less" for an ascending order of the array's own type.
+	return algo_binary_search_path(first, last, value, less, AlgoPath<
+		AlgoRadixable<RandomIt, Less, true>::value &&
+		AlgoOrder<Less, V>::value == ALGO_ASCENDING &&
+		std::is_same<T, V>::value>());
+}
+
+template <class RandomIt, class T>
+bool
+algo_binary_search(RandomIt first, RandomIt last, const T &value)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type V;
+
+	return algo_binary_search(first, last, value, std::less<V>());
+}
+
+// * algo_merge * //
+
+// Numbers: pick the smaller with a select, and step the side it came from.
+template <class InIt1, class InIt2, class OutIt, class Less>
+OutIt
+algo_merge_path(InIt1 first1, InIt1 last1, InIt2 first2, InIt2 last2,
+	OutIt out, Less less, AlgoPath<true>)
+{
+	while (first1 != last1 && first2 != last2)
+	{
+		bool second = less(*first2, *first1);
+
+		*out = second ? *first2 : *first1;
+		++out;
+		first2 += second;
+		first1 += !second;
+	}
+	out = std::copy(first1, last1, out);
+	return std::copy(first2, last2, out);
+}
+
+template <class InIt1, class InIt2, class OutIt, class Less>
+OutIt
+algo_merge_path(InIt1 first1, InIt1 last1, InIt2 first2, InIt2 last2,
+	OutIt out, Less less, AlgoPath<false>)
+{
+	while (first1 != last1 && first2 != last2)
+	{
+		if (less(*first2, *first1))
+		{
+			*out = *first2;
+			++first2;
+		}
+		else
+		{
+			*out = *first1;
+			++first1;
+		}
+		++out;
+	}
+	out = std::copy(first1, last1, out);
+	return std::copy(first2, last2, out);
+}
+
+template <class InIt1, class InIt2, class OutIt, class Less>
+OutIt
+algo_merge(InIt1 first1, InIt1 last1, InIt2 first2, InIt2 last2, OutIt out,
+	Less less)
+{
+	// The select needs random access to step by a bool.
+	const bool fast = AlgoArithmetic<InIt1>::value &&
+		AlgoArithmetic<InIt2>::value &&
+		std::is_same<typename std::iterator_traits<InIt1>::iterator_category,
+			std::random_access_iterator_tag>::value &&
+		std::is_same<typename std::iterator_traits<InIt2>::iterator_category,
+			std::random_access_iterator_tag>::value;
+
+	return algo_merge_path(first1, last1, first2, last2, out, less,
+		AlgoPath<fast>());
+}
+
+template <class InIt1, class InIt2, class OutIt>
+OutIt
+algo_merge(InIt1 first1, InIt1 last1, InIt2 first2, InIt2 last2, OutIt out)
+{
+	typedef typename std::iterator_traits<InIt1>::value_type V;
+
+	return algo_merge(first1, last1, first2, last2, out, std::less<V>());
+}
+
+// * algo_partition * //
+
+// Numbers: every item is swapped with the first 'false' one, and the
+// boundary moves on only when the item was 'true'.
+template <class It, class Pred>
+It
+algo_partition_path(It first, It last, Pred pred, AlgoPath<true>)
+{
+	typedef typename std::iterator_traits<It>::value_type V;
+
+	It boundary = first;
+	for (It i = first; i != last; ++i)
+	{
+		V item = *i;
+		bool front = pred(item);
+
+		*i = *boundary;
+		*boundary = item;
+		boundary += front;
+	}
+	return boundary;
+}
+
+// Anything else: scan in from both ends, swapping pairs in the wrong half.
+template <class It, class Pred>
+It
+algo_partition_path(It first, It last, Pred pred, AlgoPath<false>)
+{
+	for (;;)
+	{
+		while (first != last && pred(*first))
+			++first;
+		if (first == last)
+			return first;
+		do
+		{
+			--last;
+			if (first == last)
+				return first;
+		} while (!pred(*last));
+		std::iter_swap(first, last);
+		++first;
+	}
+}
+
+template <class It, class Pred>
+It
+algo_partition(It first, It last, Pred pred)
+{
+	const bool fast = AlgoArithmetic<It>::value &&
+		std::is_same<typename std::iterator_traits<It>::iterator_category,
+			std::random_access_iterator_tag>::value;
+
+	return algo_partition_path(first, last, pred, AlgoPath<fast>());
+}
+
+#endif
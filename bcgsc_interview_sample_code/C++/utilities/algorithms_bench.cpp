@@ -0,0 +1,319 @@
+/***
+*	Benchmark for algorithms.h against the standard library.
+*	Author: Malachi Griffith
+*	Date: Oct. 19 2026
+*	Compile: gcc -std=c11 -O2 -c ../../C/utilities/sort_lib.c
+*	         ../../C/utilities/thread_pool.c ../../C/utilities/work_deque.c
+*	         ../../C/utilities/simd_search.c
+*	         g++ -std=c++14 -O2 -I. -I../../C/utilities -o algorithms_bench
+*	         algorithms_bench.cpp sort_lib.o thread_pool.o work_deque.o
+*	         simd_search.o -pthread
+*
+*	Each test runs the std:: algorithm and the algo_ one on copies of the
+*	same random data (n items, or n queries for the searches), checks the
+*	results agree, and reports the best of 'reps' runs in milliseconds:
+*		sort int / double / string, sort int descending,
+*		stable_sort int / record (int key, ties kept in order),
+*		partial_sort (k smallest ints), binary_search int / double,
+*		merge int / string, partition int / string.
+*	Strings and records take the general templates, the rest the radix,
+*	vector kernel or branch free paths.
+*
+*	Usage: algorithms_bench [-n count] [-k partial] [-r reps] [-S seed]
+***/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+
+#include "algorithms.h"
+
+// Benchmark settings, filled in from the command line.
+struct BenchConfig
+{
+	size_t count;
+	size_t partial;		// k for partial_sort.
+	int reps;
+	unsigned long seed;
+};
+
+// A record sorted by key alone, seq tells whether ties kept their order.
+struct Record
+{
+	int key;
+	int seq;
+	char payload[24];
+};
+
+struct RecordLess
+{
+	bool operator()(const Record &a, const Record &b) const
+	{
+		return a.key < b.key;
+	}
+};
+
+bool operator==(const Record &a, const Record &b)
+{
+	return a.key == b.key && a.seq == b.seq;
+}
+
+static bool parse_args(int argc, char *argv[], BenchConfig &config);
+static double now_ms();
+static void report(const string &name, double stdMs, double algoMs, bool same);
+
+// Runs 'work' on a fresh copy of 'input' reps times, returns the best time
+// and leaves the last result in 'output'.
+template <class Container, class Work>
+double
+best_of(int reps, const Container &input, Container &output, Work work)
+{
+	double best = 0;
+
+	for (int r = 0; r < reps; r++)
+	{
+		output = input;
+		double start = now_ms();
+		work(output);
+		double took = now_ms() - start;
+		if (r == 0 || took < best)
+			best = took;
+	}
+	return best;
+}
+
+// One sorting test: std_sort and algo_sort are the two ways to do it.
+template <class Container, class StdWork, class AlgoWork>
+void
+sort_test(const string &name, const BenchConfig &config, const Container &input,
+	StdWork stdWork, AlgoWork algoWork)
+{
+	Container a, b;
+	double stdMs = best_of(config.reps, input, a, stdWork);
+	double algoMs = best_of(config.reps, input, b, algoWork);
+	report(name, stdMs, algoMs, a == b);
+}
+
+// Looks up every query in sorted 'values' both ways.
+template <class T>
+void
+search_test(const string &name, const BenchConfig &config,
+	const vector<T> &values, const vector<T> &queries)
+{
+	double stdMs = 0, algoMs = 0;
+	size_t stdHits = 0, algoHits = 0;
+
+	for (int r = 0; r < config.reps; r++)
+	{
+		size_t hits = 0;
+		double start = now_ms();
+		for (size_t i = 0; i < queries.size(); i++)
+			hits += binary_search(values.begin(), values.end(), queries[i]);
+		double took = now_ms() - start;
+		if (r == 0 || took < stdMs)
+			stdMs = took;
+		stdHits = hits;
+
+		hits = 0;
+		start = now_ms();
+		for (size_t i = 0; i < queries.size(); i++)
+			hits += algo_binary_search(values.begin(), values.end(), queries[i]);
+		took = now_ms() - start;
+		if (r == 0 || took < algoMs)
+			algoMs = took;
+		algoHits = hits;
+	}
+	report(name, stdMs, algoMs, stdHits == algoHits);
+}
+
+// Merges the sorted halves of 'input' both ways.
+template <class T>
+void
+merge_test(const string &name, const BenchConfig &config, vector<T> input)
+{
+	size_t half = input.size() / 2;
+	sort(input.begin(), input.begin() + half);
+	sort(input.begin() + half, input.end());
+
+	vector<T> a(input.size()), b(input.size());
+	double stdMs = 0, algoMs = 0;
+
+	for (int r = 0; r < config.reps; r++)
+	{
+		double start = now_ms();
+		merge(input.begin(), input.begin() + half, input.begin() + half,
+			input.end(), a.begin());
+		double took = now_ms() - start;
+		if (r == 0 || took < stdMs)
+			stdMs = took;
+
+		start = now_ms();
+		algo_merge(input.begin(), input.begin() + half, input.begin() + half,
+			input.end(), b.begin());
+		took = now_ms() - start;
+		if (r == 0 || took < algoMs)
+			algoMs = took;
+	}
+	report(name, stdMs, algoMs, a == b);
+}
+
+// Partitions around 'pivot' both ways; the halves are compared as sets.
+template <class T>
+void
+partition_test(const string &name, const BenchConfig &config,
+	const vector<T> &input, const T &pivot)
+{
+	vector<T> a, b;
+	size_t stdFront = 0, algoFront = 0;
+	auto front = [&pivot](const T &x) {return x < pivot;};
+
+	double stdMs = best_of(config.reps, input, a, [&](vector<T> &v) {
+		stdFront = partition(v.begin(), v.end(), front) - v.begin();});
+	double algoMs = best_of(config.reps, input, b, [&](vector<T> &v) {
+		algoFront = algo_partition(v.begin(), v.end(), front) - v.begin();});
+
+	sort(a.begin(), a.begin() + stdFront);
+	sort(b.begin(), b.begin() + algoFront);
+	report(name, stdMs, algoMs, stdFront == algoFront &&
+		equal(a.begin(), a.begin() + stdFront, b.begin()));
+}
+
+int
+main(int argc, char *argv[])
+{
+	BenchConfig config;
+
+	if (!parse_args(argc, argv, config))
+	{
+		cerr << "Usage: algorithms_bench [-n count] [-k partial] [-r reps] "
+			<< "[-S seed]" << endl;
+		return 1;
+	}
+
+	mt19937_64 random(config.seed);
+	size_t n = config.count;
+
+	vector<int> ints(n);
+	vector<double> doubles(n);
+	vector<string> strings(n);
+	vector<Record> records(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		ints[i] = (int)(random() >> 32);
+		doubles[i] = (double)(random() >> 11) / 9007199254740992.0 * 1e6;
+		strings[i] = to_string(random() % (n + 1));
+		records[i].key = (int)(random() % (n / 16 + 1));
+		records[i].seq = (int)i;
+		memset(records[i].payload, 0, sizeof(records[i].payload));
+	}
+
+	cout << "n = " << n << ", best of " << config.reps << " runs" << endl;
+	cout << left << setw(26) << "test" << right << setw(12) << "std ms"
+		<< setw(12) << "algo ms" << setw(10) << "speedup" << endl;
+
+	sort_test("sort int", config, ints,
+		[](vector<int> &v) {sort(v.begin(), v.end());},
+		[](vector<int> &v) {algo_sort(v.begin(), v.end());});
+	sort_test("sort int descending", config, ints,
+		[](vector<int> &v) {sort(v.begin(), v.end(), greater<int>());},
+		[](vector<int> &v) {algo_sort(v.begin(), v.end(), greater<int>());});
+	sort_test("sort double", config, doubles,
+		[](vector<double> &v) {sort(v.begin(), v.end());},
+		[](vector<double> &v) {algo_sort(v.begin(), v.end());});
+	sort_test("sort string", config, strings,
+		[](vector<string> &v) {sort(v.begin(), v.end());},
+		[](vector<string> &v) {algo_sort(v.begin(), v.end());});
+
+	sort_test("stable_sort int", config, ints,
+		[](vector<int> &v) {stable_sort(v.begin(), v.end());},
+		[](vector<int> &v) {algo_stable_sort(v.begin(), v.end());});
+	sort_test("stable_sort record", config, records,
+		[](vector<Record> &v) {stable_sort(v.begin(), v.end(), RecordLess());},
+		[](vector<Record> &v) {
+			algo_stable_sort(v.begin(), v.end(), RecordLess());});
+
+	size_t k = config.partial < n ? config.partial : n;
+	vector<int> a, b;
+	double stdMs = best_of(config.reps, ints, a, [k](vector<int> &v) {
+		partial_sort(v.begin(), v.begin() + k, v.end());});
+	double algoMs = best_of(config.reps, ints, b, [k](vector<int> &v) {
+		algo_partial_sort(v.begin(), v.begin() + k, v.end());});
+	report("partial_sort int k=" + to_string(k), stdMs, algoMs,
+		equal(a.begin(), a.begin() + k, b.begin()));
+
+	// Half the queries are in the array.
+	vector<int> sortedInts(ints), intQueries(n);
+	vector<double> sortedDoubles(doubles), doubleQueries(n);
+	sort(sortedInts.begin(), sortedInts.end());
+	sort(sortedDoubles.begin(), sortedDoubles.end());
+	for (size_t i = 0; i < n; i++)
+	{
+		intQueries[i] = (i & 1) ? ints[random() % n] : (int)(random() >> 32);
+		doubleQueries[i] = (i & 1) ? doubles[random() % n] : doubles[i] + 0.5;
+	}
+	search_test("binary_search int", config, sortedInts, intQueries);
+	search_test("binary_search double", config, sortedDoubles, doubleQueries);
+
+	merge_test("merge int", config, ints);
+	merge_test("merge string", config, strings);
+
+	partition_test("partition int", config, ints, 0);
+	partition_test("partition string", config, strings, string("5"));
+
+	return 0;
+}
+
+static bool
+parse_args(int argc, char *argv[], BenchConfig &config)
+{
+	config.count = 1000000;
+	config.partial = 100;
+	config.reps = 3;
+	config.seed = 42;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' ||
+			i + 1 >= argc)
+			return false;
+
+		const char *value = argv[++i];
+		switch (argv[i - 1][1])
+		{
+		case 'n': config.count = strtoul(value, 0, 10); break;
+		case 'k': config.partial = strtoul(value, 0, 10); break;
+		case 'r': config.reps = atoi(value); break;
+		case 'S': config.seed = strtoul(value, 0, 10); break;
+		default: return false;
+		}
+	}
+	if (config.count < 2)
+		config.count = 2;
+	if (config.reps < 1)
+		config.reps = 1;
+	return true;
+}
+
+static double
+now_ms()
+{
+	return chrono::duration<double, milli>(
+		chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void
+report(const string &name, double stdMs, double algoMs, bool same)
+{
+	cout << left << setw(26) << name << right << fixed << setprecision(2)
+		<< setw(12) << stdMs << setw(12) << algoMs << setw(9)
+		<< (algoMs > 0 ? stdMs / algoMs : 0) << "x"
+		<< (same ? "" : "  RESULTS DIFFER") << endl;
+}
@@ -0,0 +1,228 @@
+#ifndef _DYNAMIC_STACK_H_	// To avoid multiple and recursive inclusions
+#define _DYNAMIC_STACK_H_
+
+#include <new>		// Placement new.
+#include <cstddef>	// size_t
+#include <functional>	// std::less, to compare unrelated pointers.
+
+/***
+*	class: DynamicStack<T>
+*
+*	A stack of any type held in one contiguous block of memory.  When the
+*	block fills up it is replaced by one twice the size, so pushing is
+*	amortised O(1) and there is no fixed SIZE limit as in stack_class.cpp.
+*	This is the C++ flavour of utilities/dyn_stack.c in the C samples.
+*	Behaviours:
+*		push / pop single items.
+*		push_bulk / pop_bulk for many items in one call.
+*		reserve room ahead of time.
+*		Index from the bottom (0) to the top (size() - 1).
+***/
+
+template <class T>
+class DynamicStack
+{
+public:
+
+  // Constructors and Destructors.
+  DynamicStack();
+  DynamicStack(const DynamicStack<T> &s);	// Copy constructor.
+  ~DynamicStack();
+
+  DynamicStack<T>& operator=(const DynamicStack<T> &s);
+
+  // Mutators.
+  void reserve(size_t capacity);
+  void push(const T &item);
+  void push_bulk(const T items[], size_t count);
+  T pop();					// Pop on an empty stack returns T().
+  size_t pop_bulk(T items[], size_t count);	// items[0] is the old top.
+  void clear();
+
+  // Accessors.
+  T& top() {return dm_data[dm_size - 1];}
+  const T& top() const {return dm_data[dm_size - 1];}
+  T& operator[](size_t i) {return dm_data[i];}
+  const T& operator[](size_t i) const {return dm_data[i];}
+  T* data() {return dm_data;}
+  const T* data() const {return dm_data;}
+  size_t size() const {return dm_size;}
+  size_t capacity() const {return dm_capacity;}
+  bool empty() const {return dm_size == 0;}
+
+private:
+  void grow_for(size_t needed);	// utility function
+
+  T* dm_data;		// Raw block, only [0, dm_size) are constructed.
+  size_t dm_size;
+  size_t dm_capacity;
+};
+
+
+// *** Implementation *** //
+
+template <class T>
+DynamicStack<T>::DynamicStack()
+{
+	dm_data = 0;
+	dm_size = 0;
+	dm_capacity = 0;
+}
+
+template <class T>
+DynamicStack<T>::DynamicStack(const DynamicStack<T> &s)
+{
+	dm_data = 0;
+	dm_size = 0;
+	dm_capacity = 0;
+
+	push_bulk(s.dm_data, s.dm_size);
+}
+
+template <class T>
+DynamicStack<T>::~DynamicStack()
+{
+	clear();
+	::operator delete(dm_data);
+}
+
+template <class T>
+DynamicStack<T>&
+DynamicStack<T>::operator=(const DynamicStack<T> &s)
+{
+	if (this != &s)
+	{
+		clear();
+		push_bulk(s.dm_data, s.dm_size);
+	}
+	return *this;
+}
+
+/***
+*	reserve():
+*	Makes sure 'capacity' items will fit without another reallocation.
+*	Items are copied into the new block and the old copies destroyed.
+***/
+
+template <class T>
+void
+DynamicStack<T>::reserve(size_t capacity)
+{
+	if (capacity <= dm_capacity)
+		return;
+
+	T *newData = static_cast<T*>(::operator new(capacity * sizeof(T)));
+
+	for (size_t i = 0; i < dm_size; i++)
+	{
+		new (&newData[i]) T(dm_data[i]);
+		dm_data[i].~T();
+	}
+
+	::operator delete(dm_data);
+	dm_data = newData;
+	dm_capacity = capacity;
+}
+
+// Doubles the capacity until 'needed' more items fit.
+template <class T>
+void
+DynamicStack<T>::grow_for(size_t needed)
+{
+	if (dm_size + needed <= dm_capacity)
+		return;
+
+	size_t capacity = (dm_capacity > 0) ? dm_capacity : 16;
+	while (capacity < dm_size + needed)
+		capacity *= 2;
+
+	reserve(capacity);
+}
+
+template <class T>
+void
+DynamicStack<T>::push(const T &item)
+{
+	if (dm_size == dm_capacity)
+	{
+		T copy(item);	// item may live inside the block being replaced.
+		grow_for(1);
+		new (&dm_data[dm_size]) T(copy);
+	}
+	else
+		new (&dm_data[dm_size]) T(item);
+
+	dm_size++;
+}
+
+// items[0] is pushed first so items[count-1] ends up on top.  items may
+// be part of this stack (to push copies of its top, say): it is found
+// again in the new block if the old one is replaced.
+template <class T>
+void
+DynamicStack<T>::push_bulk(const T items[], size_t count)
+{
+	std::less<const T*> before;
+
+	if (dm_size + count > dm_capacity && count > 0 &&
+		!before(items, dm_data) && before(items, dm_data + dm_size))
+	{
+		size_t offset = items - dm_data;
+
+		grow_for(count);
+		items = dm_data + offset;
+	}
+	else
+		grow_for(count);
+
+	for (size_t i = 0; i < count; i++)
+		new (&dm_data[dm_size + i]) T(items[i]);
+
+	dm_size += count;
+}
+
+template <class T>
+T
+DynamicStack<T>::pop()
+{
+	if (dm_size == 0)
+		return T();
+
+	dm_size--;
+	T item(dm_data[dm_size]);
+	dm_data[dm_size].~T();
+
+	return item;
+}
+
+// Pops up to 'count' items, returns how many were actually popped.
+template <class T>
+size_t
+DynamicStack<T>::pop_bulk(T items[], size_t count)
+{
+	if (count > dm_size)
+		count = dm_size;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		dm_size--;
+		items[i] = dm_data[dm_size];
+		dm_data[dm_size].~T();
+	}
+
+	return count;
+}
+
+// Empties the stack, the block is kept for reuse.
+template <class T>
+void
+DynamicStack<T>::clear()
+{
+	while (dm_size > 0)
+	{
+		dm_size--;
+		dm_data[dm_size].~T();
+	}
+}
+
+#endif
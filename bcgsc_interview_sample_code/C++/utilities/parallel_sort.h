@@ -0,0 +1,256 @@
+#ifndef _PARALLEL_SORT_H_	// To avoid multiple and recursive inclusions
+#define _PARALLEL_SORT_H_
+
+#include <cstddef>	// size_t
+#include <algorithm>	// std::swap
+#include <iterator>	// std::iterator_traits
+
+#include "thread_pool.h"
+#include "sort_lib.h"
+
+/***
+*	Sorting for the C++ samples.  The C++ flavour of C/utilities/sort_lib.c,
+*	which it shares the thread pool and the radix sort with.
+*
+*	parallel_sort(first, last)		operator< order.
+*	parallel_sort(first, last, less)	'less' is any function or functor
+*						taking two T's, returning bool.
+*		first and last are pointers or any random access iterators.
+*		Introsort, as SortIntro() but templated so the comparison is
+*		inlined.  Large pieces are sorted on the default pool.  Not
+*		stable.
+*	radix_sort(first, last [, descending])	int and double arrays only.
+*		Forwards to SortInts() / SortDoubles().
+*
+*	Compile: g++ -I../utilities -I../../C/utilities ... with the C files
+*	from ../../C/utilities built by gcc:
+*		gcc -std=c11 -c sort_lib.c thread_pool.c work_deque.c
+*	and link with -pthread.
+***/
+
+template <class RandomIt, class Less>
+void parallel_sort(RandomIt first, RandomIt last, Less less);
+
+template <class RandomIt>
+void parallel_sort(RandomIt first, RandomIt last);
+
+inline void radix_sort(int *first, int *last, bool descending = false);
+inline void radix_sort(double *first, double *last, bool descending = false);
+
+
+// *** Implementation *** //
+
+const size_t PSORT_INSERTION_MAX = 16;
+const size_t PSORT_PARALLEL_MIN = 8192;
+
+// operator< as a functor.
+template <class T>
+struct PsortLess
+{
+	bool operator()(const T &a, const T &b) const {return a < b;}
+};
+
+template <class RandomIt, class Less>
+void psort_loop(ThreadPool *pool, RandomIt first, size_t count, Less less,
+	int depth);
+
+// One piece of the array handed to the pool.
+template <class RandomIt, class Less>
+struct PsortJob
+{
+	ThreadPool *pool;
+	RandomIt first;
+	size_t count;
+	Less less;
+	int depth;
+
+	PsortJob(ThreadPool *p, RandomIt f, size_t c, Less l, int d)
+		: pool(p), first(f), count(c), less(l), depth(d) {}
+
+	static void run(void *arg)
+	{
+		PsortJob<RandomIt, Less> *job =
+			static_cast<PsortJob<RandomIt, Less>*>(arg);
+		psort_loop(job->pool, job->first, job->count, job->less, job->depth);
+		delete job;
+	}
+};
+
+template <class RandomIt, class Less>
+void
+psort_insertion(RandomIt first, size_t count, Less less)
+{
+	for (size_t i = 1; i < count; i++)
+		for (size_t j = i; j > 0 && less(first[j], first[j - 1]); j--)
+			std::swap(first[j], first[j - 1]);
+}
+
+template <class RandomIt, class Less>
+void
+psort_sift_down(RandomIt first, size_t root, size_t count, Less less)
+{
+	size_t child;
+
+	while ((child = 2 * root + 1) < count)
+	{
+		if (child + 1 < count && less(first[child], first[child + 1]))
+			child++;
+		if (!less(first[root], first[child]))
+			return;
+		std::swap(first[root], first[child]);
+		root = child;
+	}
+}
+
+template <class RandomIt, class Less>
+void
+psort_heap(RandomIt first, size_t count, Less less)
+{
+	for (size_t i = count / 2; i > 0; i--)
+		psort_sift_down(first, i - 1, count, less);
+
+	for (size_t i = count - 1; i > 0; i--)
+	{
+		std::swap(first[0], first[i]);
+		psort_sift_down(first, 0, i, less);
+	}
+}
+
+// Median of three to the front, then partition around it.  Returns the
+// pivot's final position.  See Partition() in sort_lib.c.
+template <class RandomIt, class Less>
+size_t
+psort_partition(RandomIt first, size_t count, Less less)
+{
+	size_t mid = count / 2;
+	size_t last = count - 1;
+
+	if (less(first[mid], first[0]))
+		std::swap(first[mid], first[0]);
+	if (less(first[last], first[mid]))
+	{
+		std::swap(first[last], first[mid]);
+		if (less(first[mid], first[0]))
+			std::swap(first[mid], first[0]);
+	}
+	std::swap(first[0], first[mid]);
+
+	size_t i = 1;
+	size_t j = last;
+	for (;;)
+	{
+		while (less(first[i], first[0]))
+			i++;
+		while (less(first[0], first[j]))
+			j--;
+		if (i >= j)
+			break;
+		std::swap(first[i], first[j]);
+		i++;
+		j--;
+	}
+
+	std::swap(first[0], first[j]);
+	return j;
+}
+
+// Partition, spawn (or recurse on) the smaller side, loop on the larger.
+template <class RandomIt, class Less>
+void
+psort_loop(ThreadPool *pool, RandomIt first, size_t count, Less less,
+	int depth)
+{
+	TaskGroup group;
+	TaskGroupInit(&group);
+
+	while (count > PSORT_INSERTION_MAX)
+	{
+		if (depth == 0)
+		{
+			psort_heap(first, count, less);
+			count = 0;
+			break;
+		}
+		depth--;
+
+		size_t pivot = psort_partition(first, count, less);
+		RandomIt smallFirst;
+		size_t smallCount;
+
+		if (pivot < count - pivot - 1)
+		{
+			smallFirst = first;
+			smallCount = pivot;
+			first += pivot + 1;
+			count -= pivot + 1;
+		}
+		else
+		{
+			smallFirst = first + pivot + 1;
+			smallCount = count - pivot - 1;
+			count = pivot;
+		}
+
+		if (pool != 0 && smallCount >= PSORT_PARALLEL_MIN)
+		{
+			PsortJob<RandomIt, Less> *job = new PsortJob<RandomIt, Less>(pool,
+				smallFirst, smallCount, less, depth);
+			PoolSpawn(pool, &group, PsortJob<RandomIt, Less>::run, job);
+		}
+		else
+			psort_loop((ThreadPool*)0, smallFirst, smallCount, less, depth);
+	}
+
+	if (count > 1)
+		psort_insertion(first, count, less);
+
+	if (pool != 0)
+		PoolJoin(pool, &group);
+}
+
+template <class RandomIt, class Less>
+void
+parallel_sort(RandomIt first, RandomIt last, Less less)
+{
+	size_t count = last - first;
+	ThreadPool *pool = 0;
+	int depth = 0;
+
+	if (count < 2)
+		return;
+
+	for (size_t n = count; n > 1; n >>= 1)
+		depth += 2;
+
+	if (count >= 2 * PSORT_PARALLEL_MIN)
+	{
+		pool = PoolDefault();
+		if (pool != 0 && PoolNumThreads(pool) < 2)
+			pool = 0;
+	}
+
+	psort_loop(pool, first, count, less, depth);
+}
+
+template <class RandomIt>
+void
+parallel_sort(RandomIt first, RandomIt last)
+{
+	typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+	parallel_sort(first, last, PsortLess<T>());
+}
+
+inline void
+radix_sort(int *first, int *last, bool descending)
+{
+	SortInts(first, last - first, descending ? SORT_DESCENDING : SORT_ASCENDING);
+}
+
+inline void
+radix_sort(double *first, double *last, bool descending)
+{
+	SortDoubles(first, last - first, descending ? SORT_DESCENDING : SORT_ASCENDING);
+}
+
+#endif
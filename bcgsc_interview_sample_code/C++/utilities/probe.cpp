@@ -0,0 +1,463 @@
+/***
+*	Hot path timing, see probe.h.
+*
+*	Each thread owns a table of histograms indexed by probe id.  Only the
+*	owner writes to it (relaxed atomic stores, no read-modify-write), so
+*	another thread may read it for a dump at any time.  When a thread
+*	ends, its table is folded into a 'retired' table so nothing is lost.
+*
+*	Histogram buckets are log-linear: below 8ns one bucket per ns, above
+*	that 8 buckets per power of two.  Percentiles are therefore accurate
+*	to within 12.5%, which is plenty to spot a hot path.
+***/
+
+#include "probe.h"
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
+#include <csignal>
+
+#ifdef PROBE_USE_RDTSC
+#include <x86intrin.h>
+#endif
+
+using namespace std;
+
+std::atomic<int> g_probeDumpRequested(0);
+
+static const int SUB_BUCKETS = 8;	// Buckets per power of two.
+static const int NUM_BUCKETS = 64 * SUB_BUCKETS;
+
+/***
+*	struct: Histogram
+*	Times for one probe on one thread, in nanoseconds.
+***/
+
+struct Histogram
+{
+	Histogram() {clear();}
+	void clear();
+	void add(unsigned long long ns);
+	void merge_into(Histogram &sum) const;
+
+	atomic<unsigned long long> count;
+	atomic<unsigned long long> total;
+	atomic<unsigned long long> max;
+	atomic<unsigned long long> buckets[NUM_BUCKETS];
+};
+
+/***
+*	struct: ThreadTable
+*	One per thread, made on that thread's first probe.
+***/
+
+struct ThreadTable
+{
+	ThreadTable();
+	~ThreadTable();
+	Histogram& get(int id);
+
+	mutex lock;		// Held to grow 'hist', or to read it from another thread.
+	vector<Histogram*> hist;
+};
+
+/***
+*	struct: Registry
+*	Probe names, live thread tables, and histograms of finished threads.
+*	Made on the heap and never freed, so it outlives every static and
+*	thread_local destructor that might still record or dump.
+***/
+
+struct Registry
+{
+	mutex lock;
+	vector<const char*> names;
+	vector<ThreadTable*> live;
+	vector<Histogram*> retired;
+};
+
+static Registry& registry();
+static void dump_at_exit();
+static void on_dump_signal(int sig);
+static int bucket_of(unsigned long long ns);
+static unsigned long long bucket_high(int b);
+static unsigned long long percentile(const Histogram &h, double p);
+
+static thread_local ThreadTable t_table;
+
+
+// *** Clock *** //
+
+#ifdef PROBE_USE_RDTSC
+
+unsigned long long
+probe_now()
+{
+	return __rdtsc();
+}
+
+// Counts TSC ticks over ~20ms of steady_clock time.
+static double
+calibrate_tsc()
+{
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	unsigned long long c0 = __rdtsc();
+	chrono::steady_clock::time_point t1;
+
+	do
+		t1 = chrono::steady_clock::now();
+	while (t1 - t0 < chrono::milliseconds(20));
+
+	unsigned long long c1 = __rdtsc();
+	double ns = (double)chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count();
+
+	return ns / (double)(c1 - c0);
+}
+
+double
+probe_tick_ns()
+{
+	static const double tickNs = calibrate_tsc();
+	return tickNs;
+}
+
+#else
+
+unsigned long long
+probe_now()
+{
+	return (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double
+probe_tick_ns()
+{
+	return 1.0;
+}
+
+#endif
+
+
+// *** Histogram *** //
+
+void
+Histogram::clear()
+{
+	count.store(0);
+	total.store(0);
+	max.store(0);
+	for (int i = 0; i < NUM_BUCKETS; i++)
+		buckets[i].store(0);
+}
+
+// Owner thread only, so a plain load then store is enough.
+void
+Histogram::add(unsigned long long ns)
+{
+	count.store(count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+	total.store(total.load(memory_order_relaxed) + ns, memory_order_relaxed);
+	if (ns > max.load(memory_order_relaxed))
+		max.store(ns, memory_order_relaxed);
+
+	atomic<unsigned long long> &b = buckets[bucket_of(ns)];
+	b.store(b.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+void
+Histogram::merge_into(Histogram &sum) const
+{
+	sum.count.store(sum.count.load() + count.load(memory_order_relaxed));
+	sum.total.store(sum.total.load() + total.load(memory_order_relaxed));
+	if (max.load(memory_order_relaxed) > sum.max.load())
+		sum.max.store(max.load(memory_order_relaxed));
+
+	for (int i = 0; i < NUM_BUCKETS; i++)
+		sum.buckets[i].store(sum.buckets[i].load() +
+			buckets[i].load(memory_order_relaxed));
+}
+
+static int
+bucket_of(unsigned long long ns)
+{
+	if (ns < (unsigned long long)SUB_BUCKETS)
+		return (int)ns;
+
+	int msb = 63 - __builtin_clzll(ns);
+	int sub = (int)((ns >> (msb - 3)) & (SUB_BUCKETS - 1));
+
+	return (msb - 2) * SUB_BUCKETS + sub;
+}
+
+// Largest value that falls in bucket b.
+static unsigned long long
+bucket_high(int b)
+{
+	int group = b / SUB_BUCKETS;
+	int sub = b % SUB_BUCKETS;
+
+	if (group == 0)
+		return (unsigned long long)sub;
+
+	int msb = group + 2;
+	unsigned long long low = (unsigned long long)(SUB_BUCKETS + sub) << (msb - 3);
+
+	return low + (1ULL << (msb - 3)) - 1;
+}
+
+static unsigned long long
+percentile(const Histogram &h, double p)
+{
+	unsigned long long n = h.count.load();
+	unsigned long long want = (unsigned long long)(p * (double)n + 0.999999);
+	unsigned long long seen = 0;
+
+	if (want == 0)
+		want = 1;
+
+	for (int b = 0; b < NUM_BUCKETS; b++)
+	{
+		seen += h.buckets[b].load();
+		if (seen >= want)
+		{
+			unsigned long long high = bucket_high(b);
+			return high < h.max.load() ? high : h.max.load();
+		}
+	}
+
+	return h.max.load();
+}
+
+
+// *** Per thread tables *** //
+
+ThreadTable::ThreadTable()
+{
+	Registry &r = registry();
+	lock_guard<mutex> guard(r.lock);
+	r.live.push_back(this);
+}
+
+// The thread is ending, hand its counts to the registry.
+ThreadTable::~ThreadTable()
+{
+	Registry &r = registry();
+	lock_guard<mutex> guard(r.lock);
+
+	for (size_t i = 0; i < r.live.size(); i++)
+	{
+		if (r.live[i] == this)
+		{
+			r.live.erase(r.live.begin() + i);
+			break;
+		}
+	}
+
+	for (size_t id = 0; id < hist.size(); id++)
+	{
+		if (hist[id] == 0)
+			continue;
+
+		if (r.retired.size() <= id)
+			r.retired.resize(id + 1, (Histogram*)0);
+		if (r.retired[id] == 0)
+			r.retired[id] = new Histogram();
+
+		hist[id]->merge_into(*r.retired[id]);
+		delete hist[id];
+	}
+	hist.clear();
+}
+
+Histogram&
+ThreadTable::get(int id)
+{
+	if ((size_t)id < hist.size() && hist[id] != 0)
+		return *hist[id];
+
+	lock_guard<mutex> guard(lock);
+	if ((size_t)id >= hist.size())
+		hist.resize(id + 1, (Histogram*)0);
+	if (hist[id] == 0)
+		hist[id] = new Histogram();
+
+	return *hist[id];
+}
+
+
+// *** Registry *** //
+
+static Registry&
+registry()
+{
+	static Registry *r = new Registry();
+	return *r;
+}
+
+/***
+*	ProbeSite():
+*	Gives the name an id.  The first site also arranges the exit dump
+*	and the SIGUSR1 handler (unless the program already handles it).
+***/
+
+ProbeSite::ProbeSite(const char *name)
+{
+	static once_flag setupOnce;
+	Registry &r = registry();
+
+	dm_name = name;
+	{
+		lock_guard<mutex> guard(r.lock);
+		dm_id = (int)r.names.size();
+		r.names.push_back(name);
+	}
+
+	call_once(setupOnce, []() {
+		atexit(dump_at_exit);
+
+		void (*old)(int) = signal(SIGUSR1, on_dump_signal);
+		if (old != SIG_DFL && old != SIG_ERR)
+			signal(SIGUSR1, old);
+	});
+}
+
+void
+probe_record(const ProbeSite &site, unsigned long long ticks)
+{
+	unsigned long long ns = ticks;
+
+#ifdef PROBE_USE_RDTSC
+	ns = (unsigned long long)((double)ticks * probe_tick_ns());
+#endif
+
+	t_table.get(site.get_id()).add(ns);
+}
+
+
+// *** Reporting *** //
+
+void
+probe_dump(ostream &out)
+{
+	Registry &r = registry();
+	lock_guard<mutex> guard(r.lock);
+	size_t numProbes = r.names.size();
+	vector<Histogram*> sum(numProbes, (Histogram*)0);
+
+	for (size_t id = 0; id < numProbes; id++)
+	{
+		sum[id] = new Histogram();
+		if (id < r.retired.size() && r.retired[id] != 0)
+			r.retired[id]->merge_into(*sum[id]);
+	}
+
+	for (size_t t = 0; t < r.live.size(); t++)
+	{
+		ThreadTable *table = r.live[t];
+		lock_guard<mutex> tableGuard(table->lock);
+
+		for (size_t id = 0; id < table->hist.size() && id < numProbes; id++)
+			if (table->hist[id] != 0)
+				table->hist[id]->merge_into(*sum[id]);
+	}
+
+	ios::fmtflags oldFlags = out.flags();
+	streamsize oldPrecision = out.precision();
+
+	out << "\n*** Probe timings (" << r.live.size() << " live threads) ***\n";
+	out << left << setw(24) << "PROBE" << right
+		<< setw(10) << "COUNT" << setw(12) << "TOTAL ms"
+		<< setw(11) << "MEAN us" << setw(11) << "P50 us"
+		<< setw(11) << "P99 us" << setw(11) << "MAX us" << "\n";
+	out << fixed << setprecision(3);
+
+	for (size_t id = 0; id < numProbes; id++)
+	{
+		Histogram &h = *sum[id];
+		unsigned long long n = h.count.load();
+
+		if (n > 0)
+		{
+			out << left << setw(24) << r.names[id] << right
+				<< setw(10) << n
+				<< setw(12) << h.total.load() / 1e6
+				<< setw(11) << (double)h.total.load() / n / 1e3
+				<< setw(11) << percentile(h, 0.50) / 1e3
+				<< setw(11) << percentile(h, 0.99) / 1e3
+				<< setw(11) << h.max.load() / 1e3 << "\n";
+		}
+		delete sum[id];
+	}
+	out << flush;
+
+	out.flags(oldFlags);
+	out.precision(oldPrecision);
+}
+
+// Zeroes every histogram.  Other threads should be idle while this runs.
+void
+probe_reset()
+{
+	Registry &r = registry();
+	lock_guard<mutex> guard(r.lock);
+
+	for (size_t id = 0; id < r.retired.size(); id++)
+	{
+		delete r.retired[id];
+		r.retired[id] = 0;
+	}
+
+	for (size_t t = 0; t < r.live.size(); t++)
+	{
+		lock_guard<mutex> tableGuard(r.live[t]->lock);
+		vector<Histogram*> &hist = r.live[t]->hist;
+
+		for (size_t id = 0; id < hist.size(); id++)
+			if (hist[id] != 0)
+				hist[id]->clear();
+	}
+}
+
+// Writes a dump to $PROBE_OUTPUT (appending) or to stderr.
+static void
+dump_to_output()
+{
+	const char *fileName = getenv("PROBE_OUTPUT");
+
+	if (fileName != 0 && *fileName != '\0')
+	{
+		ofstream oFile(fileName, ios::app);
+		if (oFile.is_open())
+		{
+			probe_dump(oFile);
+			return;
+		}
+	}
+
+	probe_dump(cerr);
+}
+
+static void
+dump_at_exit()
+{
+	if (getenv("PROBE_OFF") == 0)
+		dump_to_output();
+}
+
+// Signal handlers may not do I/O, so just leave a note for the next probe.
+static void
+on_dump_signal(int)
+{
+	g_probeDumpRequested.store(1, memory_order_relaxed);
+}
+
+void
+probe_dump_requested()
+{
+	if (g_probeDumpRequested.exchange(0))
+		dump_to_output();
+}
@@ -0,0 +1,101 @@
+#ifndef _PROBE_H_	// To avoid multiple and recursive inclusions
+#define _PROBE_H_
+
+#include <atomic>
+#include <iostream>
+
+/***
+*	Hot path timing.
+*
+*	Put PROBE_SCOPE("name") at the top of any block.  The time from there
+*	to the end of the block is recorded against "name".  Each thread
+*	records into its own histograms, so probes never take a lock or share
+*	a cache line on the fast path.  probe_dump() merges every thread's
+*	histograms and prints count, total, mean, p50, p99 and max.
+*
+*	A dump is written to stderr (or the file named by $PROBE_OUTPUT) when
+*	the program exits, and whenever it receives SIGUSR1.  Set $PROBE_OFF
+*	to skip the exit dump.
+*
+*	Times come from std::chrono::steady_clock.  Compile with
+*	-DPROBE_USE_RDTSC on x86 to read the time stamp counter instead,
+*	which is cheaper; it is calibrated against steady_clock on first use.
+*
+*	Compile: g++ -std=c++11 ... probe.cpp
+***/
+
+class ProbeSite;
+
+// Records the time between construction and destruction into 'site'.
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(ProbeSite &site);
+  ~ScopedTimer();
+
+private:
+  ScopedTimer(const ScopedTimer &);			// Not copyable.
+  ScopedTimer& operator=(const ScopedTimer &);
+
+  ProbeSite &dm_site;
+  unsigned long long dm_start;		// Clock ticks.
+};
+
+// One named probe point, made once per PROBE_SCOPE by the macro.
+class ProbeSite
+{
+public:
+  explicit ProbeSite(const char *name);
+
+  const char* get_name() const {return dm_name;}
+  int get_id() const {return dm_id;}
+
+private:
+  const char *dm_name;
+  int dm_id;		// Index into each thread's histogram table.
+};
+
+// Clock used by ScopedTimer, and the length of one tick in nanoseconds.
+unsigned long long probe_now();
+double probe_tick_ns();
+
+// Adds one measurement of 'ticks' to 'site' for the calling thread.
+void probe_record(const ProbeSite &site, unsigned long long ticks);
+
+// Merges every thread's histograms and prints a table.
+void probe_dump(std::ostream &out);
+
+// Clears all histograms, e.g. after a warm-up.
+void probe_reset();
+
+// Set by the SIGUSR1 handler, cleared by whichever probe dumps next.
+extern std::atomic<int> g_probeDumpRequested;
+void probe_dump_requested();
+
+
+// *** Implementation (inline, the fast path) *** //
+
+inline
+ScopedTimer::ScopedTimer(ProbeSite &site) : dm_site(site)
+{
+	dm_start = probe_now();
+}
+
+inline
+ScopedTimer::~ScopedTimer()
+{
+	probe_record(dm_site, probe_now() - dm_start);
+
+	if (g_probeDumpRequested.load(std::memory_order_relaxed))
+		probe_dump_requested();
+}
+
+#define PROBE_CONCAT2(a, b) a##b
+#define PROBE_CONCAT(a, b) PROBE_CONCAT2(a, b)
+
+#define PROBE_SCOPE(name) \
+	static ProbeSite PROBE_CONCAT(probeSite_, __LINE__)(name); \
+	ScopedTimer PROBE_CONCAT(probeTimer_, __LINE__)( \
+		PROBE_CONCAT(probeSite_, __LINE__))
+
+#endif
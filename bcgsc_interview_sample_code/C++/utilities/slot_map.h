@@ -0,0 +1,191 @@
+#ifndef _SLOT_MAP_H_	// To avoid multiple and recursive inclusions
+#define _SLOT_MAP_H_
+
+#include "dynamic_stack.h"	// Growable contiguous storage.
+
+/***
+*	struct: SlotHandle
+*
+*	A stable name for an item in a SlotMap.  It stays valid however many
+*	other items are added or removed, and goes stale (rather than pointing
+*	at the wrong item) once its own item is removed, because the slot's
+*	generation count moves on.
+***/
+
+struct SlotHandle
+{
+	unsigned int index;		// Slot number.
+	unsigned int generation;	// Generation of the slot when issued.
+};
+
+/***
+*	class: SlotMap<T>
+*
+*	A table with no size limit where insert and remove are both O(1).
+*	Values are kept densely packed in one array so looping over them is
+*	a straight walk through memory.  Removing a value moves the last one
+*	into the hole, so the dense order is not the insertion order.
+*	Behaviours:
+*		insert a value, get a handle back.
+*		get / erase by handle (stale handles are refused).
+*		erase_at / operator[] / handle_at by dense position 0..size()-1.
+***/
+
+template <class T>
+class SlotMap
+{
+public:
+
+  SlotMap() {dm_freeHead = NONE;}
+
+  // Mutators.
+  SlotHandle insert(const T &value);
+  bool erase(SlotHandle h);
+  void erase_at(size_t pos);
+  void reserve(size_t capacity);
+  void clear();
+
+  // Accessors.
+  bool contains(SlotHandle h) const;
+  T* get(SlotHandle h);			// Returns 0 for a stale handle.
+  SlotHandle handle_at(size_t pos) const;
+  T& operator[](size_t pos) {return dm_values[pos];}
+  const T& operator[](size_t pos) const {return dm_values[pos];}
+  T* begin() {return dm_values.data();}
+  T* end() {return dm_values.data() + dm_values.size();}
+  size_t size() const {return dm_values.size();}
+  bool empty() const {return dm_values.empty();}
+
+private:
+  enum {NONE = ~0u};
+
+  struct Slot
+  {
+	unsigned int index;		// Dense position, or next free slot.
+	unsigned int generation;
+  };
+
+  DynamicStack<T> dm_values;		// Dense values.
+  DynamicStack<unsigned int> dm_owner;	// Slot of each dense value.
+  DynamicStack<Slot> dm_slots;
+  unsigned int dm_freeHead;		// First free slot, NONE if none.
+};
+
+
+// *** Implementation *** //
+
+template <class T>
+SlotHandle
+SlotMap<T>::insert(const T &value)
+{
+	SlotHandle h;
+
+	if (dm_freeHead != NONE)
+	{
+		h.index = dm_freeHead;
+		dm_freeHead = dm_slots[h.index].index;
+	}
+	else
+	{
+		Slot s;
+		s.generation = 0;
+		h.index = (unsigned int)dm_slots.size();
+		dm_slots.push(s);
+	}
+
+	dm_slots[h.index].index = (unsigned int)dm_values.size();
+	h.generation = dm_slots[h.index].generation;
+
+	dm_values.push(value);
+	dm_owner.push(h.index);
+
+	return h;
+}
+
+template <class T>
+bool
+SlotMap<T>::contains(SlotHandle h) const
+{
+	return h.index < dm_slots.size() &&
+		   dm_slots[h.index].generation == h.generation;
+}
+
+template <class T>
+T*
+SlotMap<T>::get(SlotHandle h)
+{
+	if (!contains(h))
+		return 0;
+
+	return &dm_values[dm_slots[h.index].index];
+}
+
+template <class T>
+SlotHandle
+SlotMap<T>::handle_at(size_t pos) const
+{
+	SlotHandle h;
+
+	h.index = dm_owner[pos];
+	h.generation = dm_slots[h.index].generation;
+	return h;
+}
+
+template <class T>
+bool
+SlotMap<T>::erase(SlotHandle h)
+{
+	if (!contains(h))
+		return false;
+
+	erase_at(dm_slots[h.index].index);
+	return true;
+}
+
+/***
+*	erase_at():
+*	Removes the value at dense position 'pos' by moving the last value
+*	into its place, then retires the slot so old handles go stale.
+***/
+
+template <class T>
+void
+SlotMap<T>::erase_at(size_t pos)
+{
+	unsigned int slot = dm_owner[pos];
+	size_t last = dm_values.size() - 1;
+
+	if (pos != last)
+	{
+		dm_values[pos] = dm_values[last];
+		dm_owner[pos] = dm_owner[last];
+		dm_slots[dm_owner[pos]].index = (unsigned int)pos;
+	}
+
+	dm_values.pop();
+	dm_owner.pop();
+
+	dm_slots[slot].generation++;
+	dm_slots[slot].index = dm_freeHead;
+	dm_freeHead = slot;
+}
+
+template <class T>
+void
+SlotMap<T>::reserve(size_t capacity)
+{
+	dm_values.reserve(capacity);
+	dm_owner.reserve(capacity);
+	dm_slots.reserve(capacity);
+}
+
+// Removes every value, all handles issued so far go stale.
+template <class T>
+void
+SlotMap<T>::clear()
+{
+	while (!dm_values.empty())
+		erase_at(dm_values.size() - 1);
+}
+
+#endif
@@ -4,123 +4,94 @@
 *  Date: Nov. 11 2002 
 *  Purpose: This program will edit the names provided in the data file
 *  "sort_names.print".  Each line contains the surname followed by the first
-*  name of a graduating member of the class.  Each line is at most 25 
-*  characters long, and there at most 20 students.  The actual size is 
-*  known only after all data is read.  This program will edit the names 
-*  to fit the format "Smith F." and display them in an output file named
-*  "edit_names.print".
+*  name of a graduating member of the class.  This program will edit the
+*  names to fit the format "Smith F." and display them in an output file
+*  named "edit_names.print".
+*  The file is streamed through TextNormalFile() from
+*  ../utilities/text_normal.c, which tidies a block of lines at a time in
+*  place (stray blanks around and between the names are dropped), so each
+*  name is just the text up to the one space left.  Nothing is kept once
+*  written, so there is no limit on the number of students or the length
+*  of a name.  Blank lines are skipped and a line holding a surname alone
+*  is written as it is.
+*  Compile: gcc -I../utilities edit_names.c ../utilities/text_normal.c
+*           ../utilities/simd_search.c
 */
 
 #include <stdio.h>
 #include <string.h>
-
-#define MAX_LETTERS 25
-#define MAX_STUDENTS 20
+#include "text_normal.h"
 
 /* Function Prototypes */
-int find_edit_length(int length[]);
-void edit_names(int num_students, const int length[], char names[][]);
-void display_array(char names[][], int num_students);
+int edit_names(void *arg, char *text, size_t length);
+void edit_name(FILE *output_data, const char *name, size_t length);
 
 main()
 {
-	int students;  /* Actual number of students found in datafile */ 
+	FILE *input_data;
+	FILE *output_data;
+	int ok;
 
-	int edit_length[MAX_LETTERS]; /* Number of characters up to and 
-				       * including the first letter of the
-				       * given name for each student */
+	input_data = fopen("sort_names.print", "r");
+	if (input_data == NULL)
+	{
+		fprintf(stderr, "edit_names: cannot open sort_names.print\n");
+		return(1);
+	}
+	output_data = fopen("edit_names.print", "w");
+	if (output_data == NULL)
+	{
+		fprintf(stderr, "edit_names: cannot open edit_names.print\n");
+		fclose(input_data);
+		return(1);
+	}
 
-	char student_names[MAX_STUDENTS][MAX_LETTERS];
-	
-	/* Function Calls */
-	students = find_edit_length(edit_length);
-	edit_names(students, edit_length, student_names);
-	display_array(student_names, students); 
+	ok = TextNormalFile(input_data, TEXT_CASE_KEEP, edit_names, output_data);
+	if (!ok)
+		fprintf(stderr, "edit_names: cannot read sort_names.print\n");
 
-	return(0);
+	fclose(input_data);
+	if (fclose(output_data) != 0)
+		ok = 0;
+	return(!ok);
 }
 
 /*
-*  Function: find_edit_length
+*  Function: edit_names
+*  Passed to TextNormalFile(); splits each tidied block into lines and
+*  edits the name on each into the output file arg.
 */
 int
-find_edit_length(int length[])
-{
-	int current_name = 0;
-	int counter = 0;
-	char ch;
-	
-	FILE *input_data;
-	input_data = fopen("sort_names.print", "r");
-
-	fscanf(input_data, "%c", &ch);
-	
-	while (!feof(input_data))
-	{
-		while (ch != ' ')
-		{
-			counter++;
-			fscanf(input_data, "%c", &ch);
-		}
-	
-		/* Now increase the counter to include the space and 
-		 * next character */
-		counter += 2;
-	
-		/* Place this value of counter in the length array.
-		 * This will be the number of letter to process for the
-		 * current name being read. */
-		length[current_name] = counter;
-
-		/* Now advance scanf cursor to end of line */
-		while (ch != '\n')
-			fscanf(input_data, "%c", &ch);
-	
-		current_name++;
-		counter = 0;
-		
-		fscanf(input_data, "%c", &ch);
-	}
-	return(current_name);
-}
-		
-/*
-*  Function: read_array
-*/
-void
-edit_names(int num_students, const int length[], char names[][MAX_LETTERS])
+edit_names(void *arg, char *text, size_t length)
 {
-	int student;
-	char junk_array[MAX_STUDENTS][MAX_LETTERS];
+	char *end = text + length;
+	char *line_end;
 
-	/* Open the input file */	
-	FILE *input_data;
-	input_data = fopen("sort_names.print", "r");
-	
-	for(student = 0; student < num_students; student++)
+	while (text < end)
 	{
-		fgets(names[student], length[student] + 1, input_data);	
-		
-		strcat(names[student], ".\n");
+		line_end = (char *)memchr(text, '\n', (size_t)(end - text));
+		if (line_end == NULL)
+			line_end = end;
 
-		fgets(junk_array[student], MAX_LETTERS, input_data);
+		if (line_end > text)
+			edit_name((FILE *)arg, text, (size_t)(line_end - text));
+		text = line_end + 1;
 	}
+	return(!ferror((FILE *)arg));
 }
 
 /*
-*  Function: display_array
+*  Function: edit_name
+*  Writes "Surname F." for one tidied "Surname First" line.
 */
-void 
-display_array(char names[][MAX_LETTERS], int num_students)
+void
+edit_name(FILE *output_data, const char *name, size_t length)
 {
-	int student;
-
-	/* Open file for print out */	
-	FILE *output_data;	
-	output_data = fopen("edit_names.print", "w");
+	const char *space = (const char *)memchr(name, ' ', length);
 
-	for (student = 0; student < num_students; student++)
-		fputs(names[student], output_data);	
-	
-	fclose(output_data);
+	if (space == NULL)
+		fprintf(output_data, "%.*s\n", (int)length, name);
+	else
+		fprintf(output_data, "%.*s%c.\n", (int)(space - name) + 1, name,
+			space[1]);
 }
@@ -0,0 +1,293 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Checks the numbers ../utilities/fast_input.c reads from a pipe
+*  against strtol() and strtod() on the same text.  A pipe is read in
+*  64 KB blocks, so the cases are the ones that make it move or grow its
+*  buffer: a number that straddles the end of a block, and numbers far
+*  longer than a block.  Prints what differs and returns 1, or returns 0
+*  if every case agrees.
+*
+*  Compile: gcc -I../utilities fast_input_check.c ../utilities/fast_input.c
+*/
+
+#define _POSIX_C_SOURCE 200809L	/* fdopen() */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "fast_input.h"
+
+#define LONG_DIGITS 200000	/* Digits in the long integer */
+#define LONG_ZEROS 150000	/* Zeros in the long double */
+
+/* Function Prototypes */
+char *straddle_text(void);
+char *long_text(void);
+char *long_double_text(void);
+int check_text(const char *name, const char *text);
+FILE *open_pipe(const char *text, pid_t *writer);
+int check_longs(const char *name, const char *text);
+int check_doubles(const char *name, const char *text);
+
+int
+main(void)
+{
+	char *text[3];
+	const char *name[3] = {
+		"a number across a block end",
+		"a 200000 digit integer",
+		"a 150000 digit double"
+	};
+	int failed = 0, i;
+
+	text[0] = straddle_text();
+	text[1] = long_text();
+	text[2] = long_double_text();
+
+	for (i = 0; i < 3; i++)
+	{
+		if (text[i] == NULL)
+		{
+			fprintf(stderr, "fast_input_check: out of memory\n");
+			return (1);
+		}
+		failed |= !check_text(name[i], text[i]);
+		free(text[i]);
+	}
+
+	if (!failed)
+		printf("fast_input_check: all cases agree\n");
+	return (failed);
+}
+
+/*
+*  Function: straddle_text()
+*  Small numbers up to two bytes before the end of the first block, so
+*  the last number, "12345", is split across the first and second reads
+*  and has the old digits of the buffer after it.
+*/
+char *
+straddle_text(void)
+{
+	const char *tail = "12345";
+	char *text = (char *)malloc(FAST_BLOCK + strlen(tail) + 1);
+	size_t i;
+
+	if (text == NULL)
+		return (NULL);
+	for (i = 0; i + 2 < FAST_BLOCK; i += 2)
+		memcpy(text + i, "9 ", 2);
+	strcpy(text + i, tail);
+	return (text);
+}
+
+/*
+*  Function: long_text()
+*  An integer longer than several blocks between two short ones.
+*/
+char *
+long_text(void)
+{
+	char *text = (char *)malloc(LONG_DIGITS + 16);
+
+	if (text == NULL)
+		return (NULL);
+	strcpy(text, "5 ");
+	memset(text + 2, '9', LONG_DIGITS);
+	strcpy(text + 2 + LONG_DIGITS, " 7 8\n");
+	return (text);
+}
+
+/*
+*  Function: long_double_text()
+*  A double of more than two blocks that comes to 1, between two short
+*  ones.
+*/
+char *
+long_double_text(void)
+{
+	char *text = (char *)malloc(LONG_ZEROS + 32);
+	char *p;
+
+	if (text == NULL)
+		return (NULL);
+	strcpy(text, "2.5 1");
+	p = text + strlen(text);
+	memset(p, '0', LONG_ZEROS);
+	sprintf(p + LONG_ZEROS, "e-%d 3.25\n", LONG_ZEROS);
+	return (text);
+}
+
+/*
+*  Function: check_text()
+*  Reads text from a pipe both as integers and as doubles.
+*/
+int
+check_text(const char *name, const char *text)
+{
+	int ok;
+
+	ok = check_longs(name, text);
+	ok &= check_doubles(name, text);
+	return (ok);
+}
+
+/*
+*  Function: open_pipe()
+*  Starts a child process writing text into a pipe and returns the read
+*  end, or NULL if that could not be done.
+*/
+FILE *
+open_pipe(const char *text, pid_t *writer)
+{
+	int ends[2];
+	size_t length = strlen(text), done = 0;
+	ssize_t put;
+	FILE *in;
+
+	if (pipe(ends) != 0)
+		return (NULL);
+
+	*writer = fork();
+	if (*writer < 0)
+	{
+		close(ends[0]);
+		close(ends[1]);
+		return (NULL);
+	}
+	if (*writer == 0)
+	{
+		close(ends[0]);
+		while (done < length &&
+			(put = write(ends[1], text + done, length - done)) > 0)
+			done += (size_t)put;
+		_exit(done == length ? 0 : 1);
+	}
+
+	close(ends[1]);
+	in = fdopen(ends[0], "r");
+	if (in == NULL)
+		close(ends[0]);
+	return (in);
+}
+
+/*
+*  Function: check_longs()
+*/
+int
+check_longs(const char *name, const char *text)
+{
+	FastInput input;
+	FILE *in;
+	pid_t writer;
+	const char *p = text;
+	char *after;
+	long got, want;
+	int count = 0, ok = 1, status;
+
+	if ((in = open_pipe(text, &writer)) == NULL)
+	{
+		perror("fast_input_check");
+		return (0);
+	}
+	if (!FastInputOpen(&input, in))
+	{
+		fclose(in);
+		waitpid(writer, &status, 0);
+		return (0);
+	}
+
+	for (;;)
+	{
+		want = strtol(p, &after, 10);
+		if (after == p)
+			break;
+		p = after;
+		count++;
+
+		if (!FastInputLong(&input, &got))
+		{
+			printf("%s: integer %d missing\n", name, count);
+			ok = 0;
+			break;
+		}
+		if (got != want)
+		{
+			printf("%s: integer %d is %ld, not %ld\n", name, count,
+				got, want);
+			ok = 0;
+		}
+	}
+	if (ok && FastInputLong(&input, &got))
+	{
+		printf("%s: %ld read after the last integer\n", name, got);
+		ok = 0;
+	}
+
+	FastInputClose(&input);
+	fclose(in);
+	waitpid(writer, &status, 0);
+	return (ok);
+}
+
+/*
+*  Function: check_doubles()
+*/
+int
+check_doubles(const char *name, const char *text)
+{
+	FastInput input;
+	FILE *in;
+	pid_t writer;
+	const char *p = text;
+	char *after;
+	double got, want;
+	int count = 0, ok = 1, status;
+
+	if ((in = open_pipe(text, &writer)) == NULL)
+	{
+		perror("fast_input_check");
+		return (0);
+	}
+	if (!FastInputOpen(&input, in))
+	{
+		fclose(in);
+		waitpid(writer, &status, 0);
+		return (0);
+	}
+
+	for (;;)
+	{
+		want = strtod(p, &after);
+		if (after == p)
+			break;
+		p = after;
+		count++;
+
+		if (!FastInputDouble(&input, &got))
+		{
+			printf("%s: double %d missing\n", name, count);
+			ok = 0;
+			break;
+		}
+		if (got != want)
+		{
+			printf("%s: double %d is %g, not %g\n", name, count,
+				got, want);
+			ok = 0;
+		}
+	}
+	if (ok && FastInputDouble(&input, &got))
+	{
+		printf("%s: %g read after the last double\n", name, got);
+		ok = 0;
+	}
+
+	FastInputClose(&input);
+	fclose(in);
+	waitpid(writer, &status, 0);
+	return (ok);
+}
@@ -4,128 +4,113 @@
 *  Date: Nov. 11 2002 
 *  Purpose: This program will sort the names provided in the data file
 *  "assign3.dat".  Each line contains the surname followed by the first
-*  name of a graduating member of the class.  Each line is at most 25 
-*  characters long, and there at most 20 students.  The actual size is 
+*  name of a graduating member of the class.  The actual size is 
 *  known only after all data is read.
+*  The file is read whole by ../utilities/text_lines.c, so there is no
+*  limit on the number of students or the length of a name, and the
+*  names are sorted by the string radix sort (../utilities/string_sort.c)
+*  instead of a selection sort.  If that runs out of memory, the shared
+*  introsort (../utilities/sort_lib.c) is used instead.
+*  Compile: gcc -pthread -I../utilities sort_names.c
+*           ../utilities/text_lines.c ../utilities/string_sort.c
+*           ../utilities/dyn_stack.c ../utilities/sort_lib.c
+*           ../utilities/thread_pool.c ../utilities/work_deque.c
 */
 
 #include <stdio.h>
 #include <string.h>
+#include "text_lines.h"
+#include "string_sort.h"
+#include "sort_lib.h"
 
-#define MAX_LETTERS 25
-#define MAX_STUDENTS 20
+#define OUTPUT_BUFFER (1 << 20)
 
 /* Function Prototypes */
-int read_array(char names[][]);
-void sort_array(char names[][], int num_students);
-void display_array(char names[][], int num_students);
-int find_min(int start, int end, char names[][]);
+int read_array(TextLines *names);
+void sort_array(char *names[], size_t num_students);
+void display_array(char *names[], size_t num_students);
+int compare_names(const void *a, const void *b);
 
 main()
 {
-	int students;  /* Actual number of students found in datafile */ 
+	TextLines student_names; /* One line per student */
 
-	char student_names[MAX_STUDENTS][MAX_LETTERS];
-
-	students = read_array(student_names);
+	if (!read_array(&student_names))
+	{
+		fprintf(stderr, "sort_names: cannot read assign3.dat\n");
+		return(1);
+	}
 
-	sort_array(student_names, students); 
+	sort_array(student_names.lines, student_names.count); 
 
-	display_array(student_names, students); 
+	display_array(student_names.lines, student_names.count); 
 
+	TextLinesFree(&student_names);
 	return(0);
 }
 
 /*
 *  Function: read_array
+*  Returns 0 if the file cannot be opened or read.
 */
 int 
-read_array(char names[][MAX_LETTERS])
+read_array(TextLines *names)
 {
-	int current = 0; /* Control variable for loop, increases after
-			  * each student name is processed. */
+	FILE *input_data;
+	int ok;
 
 	/* Open the input file */	
-	FILE *input_data;
 	input_data = fopen("assign3.dat", "r");
-	
-	while(!feof(input_data))
-	{
-		fgets(names[current], MAX_LETTERS, input_data);	
+	if (input_data == NULL)
+		return(0);
 
-		current++;
-	}
-	return(current - 1);	
+	ok = TextLinesRead(input_data, names);
+	fclose(input_data);
+	return(ok);
 }
 
 /*
-*  Function: sort_array - uses selection sort and helper function (find_min)
+*  Function: sort_array - sorts the pointers to the names, the names
+*  themselves stay where they were read.
 */
 void 
-sort_array(char names[][MAX_LETTERS], int num_students)
+sort_array(char *names[], size_t num_students)
 {
-	int current_min;
-	int index;
-	char temp_array[MAX_LETTERS];
-
-	for(index = 0; index < num_students; index++)
-	{
-		current_min = find_min(index, num_students, 
-					names); 
-			
-		if(index != current_min)
-		{
-
-			strcpy(temp_array, names[index]);
-	
-			strcpy(names[index], names[current_min]);
-		
-			strcpy(names[current_min], temp_array);
-		
-		}
-	}
+	if (!SortStrings(names, num_students))
+		SortIntro(names, num_students, sizeof(char *), compare_names);
 }
 
 /*
-*  Function: find_min
+*  Function: compare_names
+*  Use string compare to compare two names.  A -ve result means the
+*  first name comes first alphabetically.
 */
 int 
-find_min(int start, int end, char names[][MAX_LETTERS])
+compare_names(const void *a, const void *b)
 {
-	int current_min;
-	int index;
-	int compare_string;
-
-	current_min = start;
-	
-	for(index = start + 1; index < end; index++)
-		{
-		/* Use string compare to compare each string to the starting
-		*  string (current).  If the test string is smaller than
-		*  the string tested a -ve result is returned and this means
-		*  that the test string comes first alphabetically.  The 
-		*  position of this string will be considered the minimum
-		*  until an even smaller one is found.*/
-	
- 
-		compare_string = strcmp(names[index], names[current_min]);
-		if (compare_string < 0)
-			current_min = index;
-		}
-	return(current_min);
+	return(strcmp(*(char *const *)a, *(char *const *)b));
 }
 	
 void 
-display_array(char names[][MAX_LETTERS], int num_students)
+display_array(char *names[], size_t num_students)
 {
-	int student;
+	size_t student;
 
 	/* Open file for print out */	
 	FILE *output_data;	
 	output_data = fopen("sort_names.print", "w");
+	if (output_data == NULL)
+	{
+		fprintf(stderr, "sort_names: cannot write sort_names.print\n");
+		return;
+	}
+	setvbuf(output_data, NULL, _IOFBF, OUTPUT_BUFFER);
 
 	for (student = 0; student < num_students; student++)
+	{
 		fputs(names[student], output_data);	
+		putc('\n', output_data);
+	}
 	
 	fclose(output_data);
 }
@@ -4,11 +4,19 @@
 *  will declare only a pointer for each neccessary possible record.  As 
 *  each record is needed, then the space will be allocated by dynamic 
 *  memory allocation.  
+*  The pointers are sorted by employee ID with SortByKeys() from
+*  ../utilities/sort_lib.c: each ID is read from its record once into a
+*  contiguous (key, index) array, that array is sorted, and then the
+*  pointers are put in the order found, instead of following two
+*  pointers at every comparison.
+*  Compile: gcc -pthread -I../utilities mem_alloc3.c ../utilities/sort_lib.c
+*           ../utilities/thread_pool.c ../utilities/work_deque.c
 */
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>  /* Needed for dynamic memory allocation */
+#include "sort_lib.h"
 
 #define NAMESIZE 51
 #define NUM_MPS 10 
@@ -34,6 +42,8 @@ FILE *infile;
 void input(Employee_ptr m_o_p[], int *size);
 void display(Employee_ptr m_o_p[], int size);
 void sort(Employee_ptr m_o_p[], int size);
+uint64_t id_key(const void *item);
+int compare_ids(const void *a, const void *b);
 
 main()
 {
@@ -105,37 +115,38 @@ void display (Employee_ptr m_o_p[], int size)
 	}
 }
 
+/*
+*  Function: sort()
+*  By employee ID.  Stable, as the bubble sort it replaces was.
+*/
 void sort(Employee_ptr m_o_p[], int size)
 {
-	Employee_ptr temp;
+	SortKeyFunc key = id_key;
 
-	int limit;
-	int exchange;
-	int index;
-	int flag;
+	/* Out of memory for the keys, compare through the pointers */
+	if (!SortByKeys(m_o_p, size, sizeof(Employee_ptr), &key, 1))
+		SortIntro(m_o_p, size, sizeof(Employee_ptr), compare_ids);
+}
 
-	index = 0;
-	limit = size - 1;
-	flag = 1;
-	exchange = 0;
+/*
+*  Function: id_key()
+*/
+uint64_t
+id_key(const void *item)
+{
+	return (SortKeyInt((*(const Employee_ptr *)item)->employee_id));
+}
 
-	while (flag)
-	{
-		flag = 0;
-	 	for (index = 0; index < limit; index++)
-		{
-			if (m_o_p[index]->employee_id > 
-				m_o_p[index+1]->employee_id)
-			{
-				temp = m_o_p[index];
-				m_o_p[index] = m_o_p[index+1];
-				m_o_p[index+1] = temp;
-				flag = 1;
-				exchange = index;
-			}
-		}
-		limit = exchange;
-	}
+/*
+*  Function: compare_ids()
+*/
+int
+compare_ids(const void *a, const void *b)
+{
+	int first = (*(const Employee_ptr *)a)->employee_id;
+	int second = (*(const Employee_ptr *)b)->employee_id;
+
+	return ((first > second) - (first < second));
 }
 
 
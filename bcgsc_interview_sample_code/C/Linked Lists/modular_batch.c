@@ -2,10 +2,30 @@
 *  Date: Nov. 23 2002 
 *  Purpose: A modular program which creates a linked list, displays 
 *  the list of data, and searches it for key values entered by the user.
+*  The list data and the keys are read with the fast input layer
+*  (fast_input.c), which maps a file or reads it in blocks and parses
+*  the numbers in place, rather than one fscanf() per number.
+*  The keys are answered as a batch: all of stdin is read at once, the
+*  list data is copied into an array and indexed once (search_index.c),
+*  the keys are looked up together (in parallel when there are many),
+*  and the answers are written with a single fwrite().  If memory runs
+*  out each key is found with the vectorised FindInt() from
+*  simd_search.c, or at worst by SearchList() following the links.
+*  Compile: gcc -pthread -I../utilities modular_batch.c
+*           ../utilities/fast_input.c
+*           ../utilities/simd_search.c ../utilities/search_index.c
+*           ../utilities/sort_lib.c ../utilities/thread_pool.c
+*           ../utilities/work_deque.c
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fast_input.h"
+#include "simd_search.h"
+#include "search_index.h"
 #define ITER 10
+#define ANSWER_MAX 32	/* "Key -2147483648 not found.\n" fits */
 
 typedef struct node{
 			int data;
@@ -14,20 +34,34 @@ typedef struct node{
 
 typedef Node *NodePtr;
 
+typedef struct list_index{
+			int *data;	/* Node data, in list order */
+			NodePtr *nodes;	/* The node holding data[i] */
+			int count;
+		} ListIndex;
+
 /* Function Prototypes */
 void CreateList(NodePtr *, NodePtr *);
 void DeleteList(NodePtr *);
 void PrintList(NodePtr);
 NodePtr SearchList(NodePtr, int);
+void IndexList(NodePtr, ListIndex *);
+NodePtr SearchIndexed(NodePtr, ListIndex *, int);
+void FreeListIndex(ListIndex *);
+int *ReadKeys(FILE *, int *);
+void AnswerKeys(NodePtr, ListIndex *, int *, char *, int);
+int WriteAnswers(FILE *, int *, char *, int);
 FILE * SafeFopen(char *, char *);
 
 main()
 {
-	NodePtr temp = NULL;
 	NodePtr head = NULL;
 	NodePtr last = NULL;
+	ListIndex index;
 
-	int key;
+	int *keys;
+	char *found;
+	int num_keys;
 
 	/* Create the list */
 	CreateList(&head, &last);
@@ -36,17 +70,26 @@ main()
 	PrintList(head);
 
 	/* Search the list */
-	while(!feof(stdin))
+	IndexList(head, &index);
+	keys = ReadKeys(stdin, &num_keys);
+	found = keys ? (char *)malloc(num_keys + 1) : NULL;
+	if (!found)
 	{
-		scanf("%d\n", &key);
-		temp = SearchList(head, key);
-	
-		if (temp)
-			printf("Key %d found.\n", key);
-		else
-			printf("Key %d not found.\n", key);
+		fprintf(stderr, "Not enough memory for the keys.\n");
+		exit(1);
 	}
+
+	AnswerKeys(head, &index, keys, found, num_keys);
+	if (!WriteAnswers(stdout, keys, found, num_keys))
+	{
+		fprintf(stderr, "Not enough memory for the answers.\n");
+		exit(1);
+	}
+	free(keys);
+	free(found);
+
 	/* Delete the list */
+	FreeListIndex(&index);
 	DeleteList(&head);
 
 	/* Now Print the empty list */
@@ -94,6 +137,198 @@ SearchList(NodePtr list, int key)
 	return temp;
 }
 
+/*
+*  Function: IndexList()
+*  Copies the data of the list into index.  index->data is left NULL if
+*  there was not enough memory.
+*/
+void
+IndexList(NodePtr list, ListIndex *index)
+{
+	NodePtr node_ptr;
+	int count = 0;
+
+	for (node_ptr = list; node_ptr; node_ptr = node_ptr->link)
+		count++;
+
+	index->count = count;
+	index->data = (int *)malloc((count + 1) * sizeof(int));
+	index->nodes = (NodePtr *)malloc((count + 1) * sizeof(NodePtr));
+	if (!index->data || !index->nodes)
+	{
+		FreeListIndex(index);
+		return;
+	}
+
+	count = 0;
+	for (node_ptr = list; node_ptr; node_ptr = node_ptr->link)
+	{
+		index->data[count] = node_ptr->data;
+		index->nodes[count] = node_ptr;
+		count++;
+	}
+}
+
+/*
+*  Function: SearchIndexed()
+*  Same result as SearchList(list, key): the first node holding key.
+*/
+NodePtr
+SearchIndexed(NodePtr list, ListIndex *index, int key)
+{
+	long position;
+
+	if (!index->data)
+		return SearchList(list, key);
+
+	position = FindInt(index->data, index->count, key);
+	if (position < 0)
+		return NULL;
+	return index->nodes[position];
+}
+
+/*
+*  Function: FreeListIndex()
+*/
+void
+FreeListIndex(ListIndex *index)
+{
+	free(index->data);
+	free(index->nodes);
+	index->data = NULL;
+	index->nodes = NULL;
+	index->count = 0;
+}
+
+/*
+*  Function: ReadKeys()
+*  Reads numbers from the file, stopping at the end or at anything that
+*  is not a number.  Returns the keys (to be freed) and sets their
+*  count, or returns NULL if memory ran out.
+*/
+int *
+ReadKeys(FILE *input_file, int *count)
+{
+	FastInput input;
+	int *keys, *bigger_keys;
+	int capacity = 64;
+	long value;
+
+	if (!FastInputOpen(&input, input_file))
+		return NULL;
+
+	*count = 0;
+	keys = (int *)malloc(capacity * sizeof(int));
+	while (keys && FastInputLong(&input, &value))
+	{
+
+		if (*count == capacity)
+		{
+			capacity *= 2;
+			bigger_keys = (int *)realloc(keys, capacity * sizeof(int));
+			if (!bigger_keys)
+				free(keys);
+			keys = bigger_keys;
+			if (!keys)
+				break;
+		}
+		keys[(*count)++] = (int)value;
+	}
+
+	if (keys && FastInputError(&input))
+	{
+		free(keys);
+		keys = NULL;
+	}
+	FastInputClose(&input);
+	return keys;
+}
+
+/*
+*  Function: AnswerKeys()
+*  found[i] is set to 1 if keys[i] is in the list, 0 if not.
+*/
+void
+AnswerKeys(NodePtr list, ListIndex *index, int *keys, char *found,
+	int num_keys)
+{
+	SearchIndex search_index;
+	long *positions;
+	int i;
+
+	positions = (long *)malloc((num_keys + 1) * sizeof(long));
+	if (positions && index->data &&
+		SearchIndexBuild(&search_index, index->data, index->count,
+			SEARCH_FIRST))
+	{
+		SearchIndexFindBatch(&search_index, keys, positions, num_keys);
+		for (i = 0; i < num_keys; i++)
+			found[i] = positions[i] != SEARCH_NOT_FOUND;
+		SearchIndexFree(&search_index);
+	}
+	else
+	{
+		for (i = 0; i < num_keys; i++)
+			found[i] = SearchIndexed(list, index, keys[i]) != NULL;
+	}
+	free(positions);
+}
+
+/*
+*  Function: WriteAnswers()
+*  Writes "Key n found." or "Key n not found." for every key, building
+*  all the lines in memory first.  Returns 0 if memory ran out.
+*/
+int
+WriteAnswers(FILE *output_file, int *keys, char *found, int num_keys)
+{
+	char *text, *line;
+	char digits[12];
+	unsigned int value;
+	int i, d;
+
+	text = (char *)malloc((size_t)num_keys * ANSWER_MAX + 1);
+	if (!text)
+		return 0;
+
+	line = text;
+	for (i = 0; i < num_keys; i++)
+	{
+		memcpy(line, "Key ", 4);
+		line += 4;
+
+		value = (unsigned int)keys[i];
+		if (keys[i] < 0)
+		{
+			*line++ = '-';
+			value = 0u - value;
+		}
+		d = 0;
+		do
+		{
+			digits[d++] = (char)('0' + value % 10);
+			value /= 10;
+		} while (value);
+		while (d > 0)
+			*line++ = digits[--d];
+
+		if (found[i])
+		{
+			memcpy(line, " found.\n", 8);
+			line += 8;
+		}
+		else
+		{
+			memcpy(line, " not found.\n", 12);
+			line += 12;
+		}
+	}
+
+	fwrite(text, 1, line - text, output_file);
+	free(text);
+	return 1;
+}
+
 /* 
 *  Function: CreateList()
 */
@@ -101,21 +336,27 @@ void
 CreateList(NodePtr *head, NodePtr *last)
 {
 	FILE *input_file;
+	FastInput input;
 
 	NodePtr temp;	/* points to new node */
 
-	int dum;	/* Reads in data from a file */
+	long dum;	/* Reads in data from a file */
 
 	input_file = SafeFopen("t1_input", "r");
+	if (!FastInputOpen(&input, input_file))
+	{
+		fprintf(stderr, "Not enough memory to read t1_input.\n");
+		exit(1);
+	}
 
-	while(!feof(input_file))
+	while (FastInputLong(&input, &dum))
 	{
 		/* Create the new node */
 		temp = (NodePtr)malloc(sizeof(Node));
-	
-		fscanf(input_file, "%d\n", &dum);
+		if (!temp)
+			break;
 
-		temp->data = dum;
+		temp->data = (int)dum;
 		temp->link = NULL;
 
 		/* Attach the node to the end of the list */
@@ -129,6 +370,7 @@ CreateList(NodePtr *head, NodePtr *last)
 			if (!(*head))
 				(*head) = temp;
 	}
+	FastInputClose(&input);
 	fclose(input_file);
 }
 
@@ -0,0 +1,268 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Sorts the lines of a text file of any size, such as the sales
+*  and class roster files read by sort_names.c, sorting_structures.c or
+*  mem_alloc3.c, using the external merge sort in ../utilities/ext_sort.c.
+*  Only the -m budget of lines is held in memory at once.
+*
+*  Usage: big_sort [-m megabytes] [-T temp_dir] [-f fan_in]
+*		   [-k field[n][r]]... [input [output]]
+*	-k  sort on a whitespace separated field, counting from 1.  'n'
+*	    compares it as a number, 'r' reverses it.  Several -k options
+*	    give tie breakers in order.  With none the whole line is used.
+*  e.g.  big_sort -k 1n -k 2n assign4.dat sorted.dat
+*        (property class, then selling price)
+*
+*  Compile: gcc -pthread -I../utilities big_sort.c ../utilities/ext_sort.c
+*           ../utilities/sort_lib.c ../utilities/dyn_stack.c
+*           ../utilities/thread_pool.c ../utilities/work_deque.c
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include "ext_sort.h"
+
+#define MAX_KEYS 16
+#define FILE_BUFFER (1024 * 1024)
+#define MAX_MEGABYTES ((size_t)-1 / (1024 * 1024))	/* Largest -m */
+
+typedef struct {
+	int field;	/* Counting from 1 */
+	int numeric;
+	int reverse;
+} SortKey;
+
+typedef struct {
+	SortKey keys[MAX_KEYS];
+	int num_keys;
+} KeyList;
+
+/* Function Prototypes */
+int parse_key(const char *text, SortKey *key);
+int parse_count(const char *text, long low, long high, long *value);
+const char *find_field(const char *line, int field, size_t *length);
+int compare_lines(const char *a, const char *b, void *arg);
+void usage(void);
+
+int
+main(int argc, char *argv[])
+{
+	ExtSortOptions opts;
+	KeyList key_list;
+	FILE *in = stdin;
+	FILE *out = stdout;
+	long value;
+	int i;
+
+	ExtSortDefaults(&opts);
+	key_list.num_keys = 0;
+
+	for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+	{
+		if (i + 1 >= argc || argv[i][2] != '\0')
+		{
+			usage();
+			return (1);
+		}
+
+		switch (argv[i][1])
+		{
+		case 'm':
+			if (!parse_count(argv[++i], 1, LONG_MAX, &value) ||
+				(unsigned long)value > MAX_MEGABYTES)
+			{
+				usage();
+				return (1);
+			}
+			opts.memory = (size_t)value * 1024 * 1024;
+			break;
+		case 'T':
+			opts.temp_dir = argv[++i];
+			break;
+		case 'f':
+			if (!parse_count(argv[++i], 2, INT_MAX, &value))
+			{
+				usage();
+				return (1);
+			}
+			opts.max_fan_in = (int)value;
+			break;
+		case 'k':
+			if (key_list.num_keys == MAX_KEYS ||
+				!parse_key(argv[++i], &key_list.keys[key_list.num_keys]))
+			{
+				usage();
+				return (1);
+			}
+			key_list.num_keys++;
+			break;
+		default:
+			usage();
+			return (1);
+		}
+	}
+
+	if (i < argc && (in = fopen(argv[i], "r")) == NULL)
+	{
+		perror(argv[i]);
+		return (1);
+	}
+	if (i + 1 < argc && (out = fopen(argv[i + 1], "w")) == NULL)
+	{
+		perror(argv[i + 1]);
+		return (1);
+	}
+
+	setvbuf(in, NULL, _IOFBF, FILE_BUFFER);
+	setvbuf(out, NULL, _IOFBF, FILE_BUFFER);
+
+	if (!ExtSortLines(in, out, compare_lines, &key_list, &opts))
+	{
+		perror("big_sort");
+		return (1);
+	}
+
+	if (in != stdin)
+		fclose(in);
+	if (out != stdout && fclose(out) != 0)
+	{
+		perror(argv[i + 1]);
+		return (1);
+	}
+	return (0);
+}
+
+/*
+*  Function: parse_key()
+*  Reads "field[n][r]".  Returns 0 if it is not in that form.
+*/
+int
+parse_key(const char *text, SortKey *key)
+{
+	char *end;
+
+	key->field = (int)strtol(text, &end, 10);
+	key->numeric = 0;
+	key->reverse = 0;
+
+	if (end == text || key->field < 1)
+		return (0);
+
+	for (; *end != '\0'; end++)
+	{
+		if (*end == 'n')
+			key->numeric = 1;
+		else if (*end == 'r')
+			key->reverse = 1;
+		else
+			return (0);
+	}
+	return (1);
+}
+
+/*
+*  Function: parse_count()
+*  Reads a whole decimal number from low to high.  Returns 0 if text is
+*  anything else.
+*/
+int
+parse_count(const char *text, long low, long high, long *value)
+{
+	char *end;
+
+	errno = 0;
+	*value = strtol(text, &end, 10);
+	return (end != text && *end == '\0' && errno == 0 &&
+		*value >= low && *value <= high);
+}
+
+/*
+*  Function: find_field()
+*  Returns the start of the given field of line and sets its length, or
+*  returns NULL if the line has fewer fields.
+*/
+const char *
+find_field(const char *line, int field, size_t *length)
+{
+	const char *start;
+
+	for (;;)
+	{
+		while (isspace((unsigned char)*line))
+			line++;
+		if (*line == '\0')
+			return (NULL);
+
+		start = line;
+		while (*line != '\0' && !isspace((unsigned char)*line))
+			line++;
+
+		if (--field == 0)
+		{
+			*length = line - start;
+			return (start);
+		}
+	}
+}
+
+/*
+*  Function: compare_lines()
+*  Compares two lines key by key.  A missing field sorts first, and a
+*  numeric field that reads as NaN sorts after that but before any
+*  number, so the order is the same whichever lines are compared.
+*/
+int
+compare_lines(const char *a, const char *b, void *arg)
+{
+	const KeyList *key_list = (const KeyList *)arg;
+	const SortKey *key;
+	const char *field_a, *field_b;
+	size_t length_a, length_b;
+	double value_a, value_b;
+	int k, result;
+
+	if (key_list->num_keys == 0)
+		return (strcmp(a, b));
+
+	for (k = 0; k < key_list->num_keys; k++)
+	{
+		key = &key_list->keys[k];
+		field_a = find_field(a, key->field, &length_a);
+		field_b = find_field(b, key->field, &length_b);
+
+		if (field_a == NULL || field_b == NULL)
+			result = (field_a != NULL) - (field_b != NULL);
+		else if (key->numeric)
+		{
+			value_a = strtod(field_a, NULL);
+			value_b = strtod(field_b, NULL);
+			if (isnan(value_a) || isnan(value_b))
+				result = (isnan(value_b) != 0) - (isnan(value_a) != 0);
+			else
+				result = (value_a > value_b) - (value_a < value_b);
+		}
+		else
+		{
+			result = memcmp(field_a, field_b,
+				length_a < length_b ? length_a : length_b);
+			if (result == 0)
+				result = (length_a > length_b) - (length_a < length_b);
+		}
+
+		if (result != 0)
+			return (key->reverse ? -result : result);
+	}
+	return (0);
+}
+
+void
+usage(void)
+{
+	fprintf(stderr, "Usage: big_sort [-m megabytes] [-T temp_dir] "
+		"[-f fan_in] [-k field[n][r]]... [input [output]]\n");
+}
@@ -1,49 +1,98 @@
 /* Author: Malachi Griffith
 *  Date: Oct. 24 2002
 *  Purpose: Search an array for specified values.
+*  Run as "search_array -b" to answer many queries at once: every integer
+*  on stdin is looked up and "value position" is printed for each.  Batch
+*  mode builds a search index (../utilities/search_index.c) from the array
+*  once, so each lookup is O(log n) rather than a scan of the array.
+*  Single queries scan the array 8 values at a time (simd_search.c).
+*  Compile: gcc -pthread -I../utilities search_array.c
+*           ../utilities/search_index.c ../utilities/simd_search.c
+*           ../utilities/sort_lib.c ../utilities/thread_pool.c
+*           ../utilities/work_deque.c
 */
 
 #include <stdio.h>
-#define MAX_SIZE 20 
+#include <stdlib.h>
+#include <string.h>
+#include "search_index.h"
+#include "simd_search.h"
+#define START_SIZE 64 
 
 /* Function Prototypes */
-void readarray(int values[], int *size);
+int *readarray(FILE *input_data, int *size);
 int searcharray(int values[], int size, int search_value);
 void queryarray(int values[], int size);
+int batchquery(int values[], int size);
 
-main()
+main(int argc, char *argv[])
 {
 	int size_local;
+	int status = 0;
 
-	int value_list[MAX_SIZE];
+	int *value_list;
+	FILE *input_data;
 	
-	readarray(value_list, &size_local);
+	input_data = fopen("array.dat", "r");
+	if (input_data == NULL)
+	{
+		printf("\nCan not open array.dat\n");
+		return(1);
+	}
+	value_list = readarray(input_data, &size_local);
+	fclose(input_data);
+
+	if (value_list == NULL)
+	{
+		printf("\nOut of memory reading array.dat\n");
+		return(1);
+	}
 	
-	queryarray(value_list, size_local);
+	if (argc > 1 && strcmp(argv[1], "-b") == 0)
+		status = batchquery(value_list, size_local);
+	else
+		queryarray(value_list, size_local);
+
+	free(value_list);
+	return(status);
 }
 
 /*
 * Function readarray
+* Reads every number in the file into an array that doubles in size as
+* it fills.  Returns the array (to be freed), or NULL if memory ran out.
 */
-void
-readarray(int values[], int *size)
+int *
+readarray(FILE *input_data, int *size)
 {
 	int i = 0;
+	int capacity = START_SIZE;
 	double temp;
+	int *values;
+	int *bigger;
 	
-	FILE *input_data;
-	input_data = fopen("array.dat", "r");
-
-	fscanf(input_data, "%lf", &temp);
+	values = (int *)malloc(capacity * sizeof(int));
+	if (values == NULL)
+		return(NULL);
 
-	while(!feof(input_data))
+	while(fscanf(input_data, "%lf", &temp) == 1)
 	{
+		if (i == capacity)
+		{
+			capacity *= 2;
+			bigger = (int *)realloc(values, capacity * sizeof(int));
+			if (bigger == NULL)
+			{
+				free(values);
+				return(NULL);
+			}
+			values = bigger;
+		}
 		values[i] = temp;
-		fscanf(input_data, "%lf", &temp); 
 		i++;	
 	}
 	*size = i;	
-	fclose(input_data);
+	return(values);
 }
 	
 /*
@@ -68,19 +117,72 @@ queryarray(int values[], int size)
 
 }
 
+/*
+*  Function: batchquery
+*  Looks up every integer on stdin in one pass.  Positions are the same
+*  as searcharray() gives: the last one, or -1 if not found.  Returns 0,
+*  or 1 if memory ran out.
+*/
+int
+batchquery(int values[], int size)
+{
+	SearchIndex index;
+	int *targets;
+	int *bigger;
+	long *positions;
+	int num_targets = 0;
+	int capacity = START_SIZE;
+	int target;
+	int i;
+
+	targets = (int *)malloc(capacity * sizeof(int));
+	if (targets == NULL)
+		return(1);
+
+	while (scanf("%d", &target) == 1)
+	{
+		if (num_targets == capacity)
+		{
+			capacity *= 2;
+			bigger = (int *)realloc(targets, capacity * sizeof(int));
+			if (bigger == NULL)
+			{
+				free(targets);
+				return(1);
+			}
+			targets = bigger;
+		}
+		targets[num_targets++] = target;
+	}
+
+	positions = (long *)malloc((num_targets + 1) * sizeof(long));
+	if (positions == NULL ||
+		!SearchIndexBuild(&index, values, size, SEARCH_LAST))
+	{
+		free(positions);
+		free(targets);
+		return(1);
+	}
+
+	SearchIndexFindBatch(&index, targets, positions, num_targets);
+
+	for (i = 0; i < num_targets; i++)
+		printf("%d %ld\n", targets[i], positions[i]);
+
+	SearchIndexFree(&index);
+	free(positions);
+	free(targets);
+	return(0);
+}
+
 /*
 *  Function: searcharray
+*  Returns the last position of search_value, or -1.
 */
 int 
 searcharray(int values[], int size, int search_value)
 {
-	int i;
-	int position = -1;
-	
-	for(i = 0; i < size; i++)
-		if (values[i] == search_value)
-			position = i;
-	return(position);
+	return((int)FindIntLast(values, size, search_value));
 }
 	
 	
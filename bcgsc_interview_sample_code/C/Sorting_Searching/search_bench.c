@@ -0,0 +1,235 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Times the linear searches of search_array.c and modular_batch.c
+*  against the kernels of ../utilities/simd_search.c, at each level the
+*  CPU supports, for a range of small array sizes.  Half of the keys are
+*  in the array (at a random place), half are not.  Prints nanoseconds
+*  per search.
+*
+*  Usage: search_bench [-q searches] [-s seed]
+*
+*  Compile: gcc -O2 -I../utilities search_bench.c
+*           ../utilities/simd_search.c
+*/
+
+#define _POSIX_C_SOURCE 200809L	/* clock_gettime() under -std=c11 */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "simd_search.h"
+
+#define DEFAULT_SEARCHES 2000000L
+#define NUM_SIZES 9
+
+typedef struct node {
+	int data;
+	struct node *link;
+} Node;
+
+static const int sizes[NUM_SIZES] = { 4, 8, 16, 32, 64, 128, 256, 1024, 4096 };
+static const char *level_names[] = { "scalar", "sse2", "avx2" };
+
+/* Keeps the compiler from dropping the searches */
+static volatile long sink;
+
+/* Function Prototypes */
+double now(void);
+int old_searcharray(int values[], int size, int search_value);
+Node *old_SearchList(Node *list, int key);
+long old_search_doubles(const double values[], int size, double key);
+void run_size(int size, long searches);
+void usage(void);
+
+int
+main(int argc, char *argv[])
+{
+	long searches = DEFAULT_SEARCHES;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc)
+		{
+			usage();
+			return (1);
+		}
+		if (strcmp(argv[i], "-q") == 0)
+			searches = atol(argv[++i]);
+		else if (strcmp(argv[i], "-s") == 0)
+			srand((unsigned int)atoi(argv[++i]));
+		else
+		{
+			usage();
+			return (1);
+		}
+	}
+	if (searches < 1)
+		searches = 1;
+
+	printf("CPU supports: %s, %ld searches per test, ns per search\n",
+		level_names[SimdSearchLevel()], searches);
+	printf("%6s %10s %10s %10s", "size", "searcharr", "SearchList",
+		"dbl loop");
+	for (i = 0; i <= SimdSearchLevel(); i++)
+		printf("  int %-6s dbl %-6s", level_names[i], level_names[i]);
+	printf("\n");
+
+	for (i = 0; i < NUM_SIZES; i++)
+		run_size(sizes[i], searches);
+	return (0);
+}
+
+/*
+*  Function: run_size()
+*  One line of the table.
+*/
+void
+run_size(int size, long searches)
+{
+	int *values, *keys;
+	double *doubles, *double_keys;
+	Node *nodes;
+	long i, total;
+	int best, level;
+	double start;
+
+	values = (int *)malloc(size * sizeof(int));
+	doubles = (double *)malloc(size * sizeof(double));
+	nodes = (Node *)malloc(size * sizeof(Node));
+	keys = (int *)malloc(searches * sizeof(int));
+	double_keys = (double *)malloc(searches * sizeof(double));
+	if (!values || !doubles || !nodes || !keys || !double_keys)
+	{
+		fprintf(stderr, "search_bench: out of memory\n");
+		exit(1);
+	}
+
+	/* Even values, so odd keys miss */
+	for (i = 0; i < size; i++)
+	{
+		values[i] = 2 * (int)i;
+		doubles[i] = values[i];
+		nodes[i].data = values[i];
+		nodes[i].link = (i + 1 < size) ? &nodes[i + 1] : NULL;
+	}
+	for (i = 0; i < searches; i++)
+	{
+		keys[i] = 2 * (rand() % size) + (rand() & 1);
+		double_keys[i] = keys[i];
+	}
+
+	printf("%6d", size);
+
+	total = 0;
+	start = now();
+	for (i = 0; i < searches; i++)
+		total += old_searcharray(values, size, keys[i]);
+	printf(" %10.1f", (now() - start) * 1e9 / searches);
+	sink = total;
+
+	total = 0;
+	start = now();
+	for (i = 0; i < searches; i++)
+		total += old_SearchList(nodes, keys[i]) != NULL;
+	printf(" %10.1f", (now() - start) * 1e9 / searches);
+	sink = total;
+
+	total = 0;
+	start = now();
+	for (i = 0; i < searches; i++)
+		total += old_search_doubles(doubles, size, double_keys[i]);
+	printf(" %10.1f", (now() - start) * 1e9 / searches);
+	sink = total;
+
+	best = SimdSearchLevel();
+	for (level = SIMD_SCALAR; level <= best; level++)
+	{
+		SimdSearchSetLevel(level);
+
+		total = 0;
+		start = now();
+		for (i = 0; i < searches; i++)
+			total += FindIntLast(values, size, keys[i]);
+		printf("  %10.1f", (now() - start) * 1e9 / searches);
+		sink = total;
+
+		total = 0;
+		start = now();
+		for (i = 0; i < searches; i++)
+			total += FindDouble(doubles, size, double_keys[i]);
+		printf(" %10.1f", (now() - start) * 1e9 / searches);
+		sink = total;
+	}
+	SimdSearchSetLevel(best);
+	printf("\n");
+
+	free(values);
+	free(doubles);
+	free(nodes);
+	free(keys);
+	free(double_keys);
+}
+
+/*
+*  Function: old_searcharray()
+*  The loop search_array.c used to have.
+*/
+int
+old_searcharray(int values[], int size, int search_value)
+{
+	int i;
+	int position = -1;
+
+	for (i = 0; i < size; i++)
+		if (values[i] == search_value)
+			position = i;
+	return (position);
+}
+
+/*
+*  Function: old_SearchList()
+*  The list walk of modular_batch.c.
+*/
+Node *
+old_SearchList(Node *list, int key)
+{
+	while (list)
+	{
+		if (list->data == key)
+			return (list);
+		list = list->link;
+	}
+	return (NULL);
+}
+
+/*
+*  Function: old_search_doubles()
+*  A one value per step search of a double array.
+*/
+long
+old_search_doubles(const double values[], int size, double key)
+{
+	int i;
+
+	for (i = 0; i < size; i++)
+		if (values[i] == key)
+			return (i);
+	return (-1L);
+}
+
+double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+void
+usage(void)
+{
+	fprintf(stderr, "Usage: search_bench [-q searches] [-s seed]\n");
+}
@@ -1,24 +1,39 @@
 /* Author: Malachi Griffith
 *  Date: Oct. 24 2002
 *  Purpose: Sort a data file of prices as an array (DESCENDING).
+*  The sort is the shared radix sort for doubles (../utilities/sort_lib.c)
+*  instead of a selection sort.
+*  Run as "sort_descending -t k" for just the k most expensive items and
+*  the least expensive one.  The file is then read as a stream, with only
+*  k prices kept, so it may be any length.
+*  Compile: gcc -pthread -I../utilities sort_descending.c
+*           ../utilities/sort_lib.c ../utilities/thread_pool.c
+*           ../utilities/work_deque.c
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sort_lib.h"
 #define MAX_PRICES 25
 
 /* Function Prototypes */
 void readarray(double prices[], int *size);
 void sortarray(double prices[], int size, double *most_exp, double *least_exp);
-double find_max(double prices[], int start, int end);
 void displayarray(double prices[],int size);
 void display(double most_expensive, double least_expensive);
+int stream_top(int k);
+int compare_prices(const void *a, const void *b);
 
-main()
+main(int argc, char *argv[])
 {
 	int size_local;
 	double most, least;
 
 	double price_list[MAX_PRICES];
+
+	if (argc > 2 && strcmp(argv[1], "-t") == 0)
+		return(stream_top(atoi(argv[2])));
 	
 	printf("\nPrices Before Sorting of Array:");	
 	readarray(price_list, &size_local);
@@ -63,61 +78,81 @@ readarray(double prices[], int *size)
 void
 sortarray(double prices[], int size, double *most_exp, double *least_exp)
 {
-	int current;
-	int index;
-	double temp;
-	
 	*most_exp = prices[0];  /* initialise max and min values */
 	*least_exp = prices[0];
 
-	/* consider one value from the array at a time */
-	for(index = 0; index <= size - 1; index++)
+	SortDoubles(prices, size, SORT_DESCENDING);
+
+	/* Once sorted the extremes are simply the two ends */
+	if (size > 0)
 	{
-		/* find current position of maximum value in array */
-		/* only search beyond the current position being considered,
-		*  ie. the index value. */
-
-		current = find_max(prices, index, size);
-		if(index != current)
-		
-		/* If the min value does not equal the value being considered,
-		*  the switch the position with the min value */
-		{
-		   temp = prices[index];
-		   prices[index] = prices[current];
-		   prices[current] = temp;
-		}
-		
-		if (prices[index] > *most_exp)
-			*most_exp = prices[index];
-		if (prices[index] < *least_exp)
-			*least_exp = prices[index];
+		*most_exp = prices[0];
+		*least_exp = prices[size - 1];
 	}
 } 
 
-
 /*
-*  Subprogram: find_max 
+* Function: stream_top
+* Reads sort_array.dat keeping only the k most expensive prices so far,
+* then shows them in order.  Returns 0, or 1 on a file or memory error.
 */
-double
-find_max(double prices[], int start, int end)
+int
+stream_top(int k)
+{
+	SortTop top;
+	FILE *input_data;
+	double price, least = 0;
+	double *best;
+	size_t count;
+	int any = 0;
 
-/* The whole array can be accessed by this function but each time it is
-*  called by the sortarray function it is told to start searching from 
-*  the index value.  Everything before the index value has already been 
-*  sorted.  */
+	if (k < 1)
+		k = 1;
 
-{
-	int current;
-	int index;
+	input_data = fopen("sort_array.dat", "r");
+	if (input_data == NULL)
+	{
+		printf("\nCan not open sort_array.dat\n");
+		return(1);
+	}
+	if (!SortTopInit(&top, k, sizeof(double), compare_prices))
+	{
+		fclose(input_data);
+		printf("\nOut of memory\n");
+		return(1);
+	}
+
+	while (fscanf(input_data, "%lf", &price) == 1)
+	{
+		SortTopAdd(&top, &price);
+		if (!any || price < least)
+			least = price;
+		any = 1;
+	}
+	fclose(input_data);
+
+	best = (double *)SortTopFinish(&top, &count);
+	printf("\nThe %lu most expensive items:", (unsigned long)count);
+	displayarray(best, count);
+	printf("\n");
+
+	if (count > 0)
+		display(best[0], least);
+	SortTopFree(&top);
+	return(0);
+}
 
-	current = start;  /* Start is index value from the calling function */
-			  /* current saves the position of the min value. */
+/*
+* Function: compare_prices
+* Higher prices sort first.
+*/
+int
+compare_prices(const void *a, const void *b)
+{
+	double first = *(const double *)a;
+	double second = *(const double *)b;
 
-	for (index = start + 1; index < end; index++)
-		if(prices[index] > prices[current])
-			current = index;
-	return (current);
+	return((first < second) - (first > second));
 }
 
 /*
@@ -2,68 +2,73 @@
 *  Date: Dec. 4 2002  
 *  Purpose: A complete program with all neccessary functions to create
 *  a stack, print it and delete it.
+*  The stack is now kept in one growing block (../utilities/dyn_stack.c)
+*  instead of one malloc'd node per push.
+*  Compile: gcc -I../utilities complete_stack.c ../utilities/dyn_stack.c
 */
 
 #include <stdio.h>
+#include "dyn_stack.h"
 #define ITER 10
 
-typedef struct node {
-	int data;
-	struct node *link;
-	} Node;
-
-typedef Node *NodePtr;
-
 /* Function Prototypes */
-void Push(NodePtr *top_ptr, int data);
-void PrintStack(NodePtr node_ptr);
-int Pop(NodePtr *top_ptr);
-int IsEmpty(NodePtr node_ptr);
+void Push(DynStack *stack, int data);
+void PrintStack(const DynStack *stack);
+int Pop(DynStack *stack);
+int IsEmpty(const DynStack *stack);
 
 main()
 {
-	NodePtr temp = NULL;
-	NodePtr top = NULL;
+	DynStack stack;
 
 	int i;
 	int data;
 	
+	DynStackInit(&stack, sizeof(int));
+
 	/* Create the stack */
+	DynStackReserve(&stack, ITER);
 	for(i = 0; i < ITER; i++)
-		Push(&top, i + 1);
+		Push(&stack, i + 1);
 
 	/* Print the stack */
-	PrintStack(top);
+	PrintStack(&stack);
 
 	/* Delete the stack */
 	for (i = 0; i < ITER; i++)
 	{
-		if(!IsEmpty(top))
+		if(!IsEmpty(&stack))
 		{
-			data = Pop(&top);
+			data = Pop(&stack);
 			printf("The deleted node contained %d\n", data);
 		}
 	}
 	
-	Pop(&top);
+	Pop(&stack);
 
 	/* Print the now-empty stack */
-	PrintStack(top);
+	PrintStack(&stack);
+
+	DynStackFree(&stack);
 }
 
 /*
 *  Function: PrintStack()
 */
 void
-PrintStack(NodePtr node_ptr)
+PrintStack(const DynStack *stack)
 {
-	if(!node_ptr)	
+	const int *items = (const int *)stack->data;
+	size_t i = DynStackSize(stack);
+
+	if(IsEmpty(stack))	
 		printf("The stack is empty.\n");
 
-	while(node_ptr)
+	/* Print from the top down, as the linked version did */
+	while(i > 0)
 	{
-		printf("%d\n", node_ptr->data);
-		node_ptr = node_ptr->link;
+		i--;
+		printf("%d\n", items[i]);
 	}
 	return;
 }
@@ -72,50 +77,31 @@ PrintStack(NodePtr node_ptr)
 *  Function: IsEmpty()
 */
 int 
-IsEmpty(NodePtr node_ptr)
+IsEmpty(const DynStack *stack)
 {
-	int answer;
-	answer = (node_ptr == NULL);
-
-	return (answer);
+	return (DynStackIsEmpty(stack));
 }
 
 /* 
 *  Function: Push()
 */
 void 
-Push(NodePtr *top_ptr, int data)
+Push(DynStack *stack, int data)
 {
-	NodePtr temp;
-	
-	temp = (NodePtr)malloc(sizeof(Node));
-
-	temp->data = data;
-
-	/* Attach the new node as the top node */
-	temp->link = *top_ptr;
-
-	/* Update the top pointer */
-	*top_ptr = temp;
+	if (!DynStackPush(stack, &data))
+		printf("Out of memory, %d was not pushed.\n", data);
 }
 
 /* 
 *  Function: Pop()
 */
 int
-Pop(NodePtr *top_ptr)
+Pop(DynStack *stack)
 {
-	NodePtr temp;
-
 	int data = 0;
 
-	if(!IsEmpty(*top_ptr))
-	{
-		data = (*top_ptr)->data;
-		temp = *top_ptr;
-		*top_ptr = (*top_ptr)->link;
-		free(temp);
-	}
+	if(!IsEmpty(stack))
+		DynStackPop(stack, &data);
 
 	else 
 		printf("The stack is empty, and the datum returned is meaningless.\n");
@@ -1,100 +1,90 @@
 /* Author: Malachi Griffith
-*  Date:  Nov. 4 2002 
+*  Date:  Nov. 4 2002
 *  Purpose: A program that uses a stack to print a string in reverse.
-*  Note that we have made Push and Pop more general by defining a 
+*  Note that we have made Push and Pop more general by defining a
 *  typedef for the data type.  In this way, the same functions can be
 *  used for integers and charcters, without modification.
+*  The stack is now the contiguous DynStack (../utilities/dyn_stack.c), so
+*  there is no malloc() per character and no limit on the line length.
+*  Compile: gcc -I../utilities reverse_string.c ../utilities/dyn_stack.c
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include "dyn_stack.h"
 
-typedef char DataType;
-
-typedef struct node{
-	DataType data;
-	struct node *link;
-} Node;
+#define CHUNK 256
 
-typedef Node *NodePtr;
+typedef char DataType;
 
 /* Function Prototypes */
-int IsEmpty(NodePtr node_ptr);
-void Push(NodePtr *top_ptr, DataType data);
-DataType Pop(NodePtr *top_ptr);
+int IsEmpty(const DynStack *stack);
+void Push(DynStack *stack, DataType data);
+DataType Pop(DynStack *stack);
 
 main()
 {
-	NodePtr top = NULL;
-	NodePtr temp;
+	DynStack stack;
+	DataType chunk[CHUNK];
+	size_t count;
+	int data;
 
-	DataType data;
+	DynStackInit(&stack, sizeof(DataType));
 
 	/* Get the input line */
 	printf("Please enter a line of characters:\n");
 
-	while((data = getchar()) != '\n') 
-		Push(&top, data);
+	while((data = getchar()) != '\n' && data != EOF)
+		Push(&stack, (DataType)data);
 
 	printf("\n");
 	printf("The line printed in reverse is: \n");
 
-	while(!IsEmpty(top))
+	/* Pop a chunk at a time, it comes off the stack already reversed */
+	while(!IsEmpty(&stack))
 	{
-		data = Pop(&top);
-		printf("%c", data);
+		count = DynStackPopBulk(&stack, chunk, CHUNK);
+		fwrite(chunk, sizeof(DataType), count, stdout);
 	}
 
 	printf("\n");
+
+	DynStackFree(&stack);
 }
 
-/* 
+/*
 *  Function: IsEmpty();
 */
-int 
-IsEmpty(NodePtr node_ptr)
+int
+IsEmpty(const DynStack *stack)
 {
-	int answer;
-	answer = (node_ptr == NULL);
-	return answer;
+	return (DynStackIsEmpty(stack));
 }
 
 /*
 *  Function: Push()
 */
 void
-Push(NodePtr *top_ptr, DataType data)
+Push(DynStack *stack, DataType data)
 {
-	NodePtr temp;
-	
-	temp = (NodePtr)malloc(sizeof(Node));
-
-	temp->data = data;
-
-	/* Attach the new node as the top node */
-	temp->link = *top_ptr;
-
-	/* Update the top pointer */
-	*top_ptr = temp;
+	if (!DynStackPush(stack, &data))
+	{
+		printf("Out of memory, the line is too long to reverse.\n");
+		exit(1);
+	}
 }
 
 /*
 *  Function: Pop()
 */
 DataType
-Pop(NodePtr *top_ptr)
+Pop(DynStack *stack)
 {
-	NodePtr temp;
+	DataType data = 0;
 
-	int data = 0;
+	if(!IsEmpty(stack))
+		DynStackPop(stack, &data);
 
-	if(!IsEmpty(*top_ptr))
-	{
-		data = (*top_ptr)->data;
-		temp = *top_ptr;
-		*top_ptr = (*top_ptr)->link;
-		free(temp);
-	}
-	
 	else
 		printf("The stack is empty, and the datum returned is meaningless.\n");
 
@@ -0,0 +1,255 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Times ../utilities/char_class.c against the <ctype.h> loops
+*  it replaces (toupper(), the isupper() ... ispunct() chain of
+*  char_type.c, and a compare and store per character) on a large text
+*  of mixed case words, digits and punctuation, at each vector level the
+*  CPU supports.  Prints GB/s; every level's result is checked against
+*  the loop's.
+*
+*  Usage: case_bench [-m megabytes] [-r reps]
+*
+*  Compile: gcc -O2 -I../utilities case_bench.c ../utilities/char_class.c
+*           ../utilities/simd_search.c
+*/
+
+#define _POSIX_C_SOURCE 200809L	/* clock_gettime() under -std=c11 */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "char_class.h"
+#include "simd_search.h"
+
+#define NUM_TESTS 4
+
+static const char *level_names[] = { "scalar", "sse2", "avx2" };
+static const char *test_names[NUM_TESTS] = {
+	"upper", "count", "classify", "replace"
+};
+
+/* Keeps the compiler from dropping the work */
+static volatile unsigned long long sink;
+
+/* Function Prototypes */
+double now(void);
+unsigned long long run(int test, int level, const char *text, char *work,
+	unsigned char *classes, size_t length);
+char *make_text(size_t length);
+void usage(void);
+
+int
+main(int argc, char *argv[])
+{
+	size_t length = 256;
+	int reps = 3, best, level, test, i, r;
+	unsigned long long expected, result;
+	double start, took, fastest;
+	unsigned char *classes;
+	char *text, *work;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc)
+		{
+			usage();
+			return (1);
+		}
+		if (strcmp(argv[i], "-m") == 0)
+			length = (size_t)atol(argv[++i]);
+		else if (strcmp(argv[i], "-r") == 0)
+			reps = atoi(argv[++i]);
+		else
+		{
+			usage();
+			return (1);
+		}
+	}
+	if (length < 1)
+		length = 1;
+	if (reps < 1)
+		reps = 1;
+	length <<= 20;
+
+	text = make_text(length);
+	work = (char *)malloc(length);
+	classes = (unsigned char *)malloc(length);
+	if (work == NULL || classes == NULL)
+	{
+		fprintf(stderr, "case_bench: out of memory\n");
+		return (1);
+	}
+
+	best = SimdSearchLevel();
+	printf("%lu MB of text, best of %d, GB/s\n",
+		(unsigned long)(length >> 20), reps);
+	printf("%-9s %10s", "", "ctype");
+	for (level = SIMD_SCALAR; level <= best; level++)
+		printf(" %10s", level_names[level]);
+	printf("\n");
+
+	for (test = 0; test < NUM_TESTS; test++)
+	{
+		printf("%-9s", test_names[test]);
+		expected = 0;
+		for (level = -1; level <= best; level++)
+		{
+			if (level >= 0)
+				SimdSearchSetLevel(level);
+			fastest = 0;
+			for (r = 0; r < reps; r++)
+			{
+				start = now();
+				result = run(test, level, text, work, classes, length);
+				took = now() - start;
+				if (r == 0 || took < fastest)
+					fastest = took;
+			}
+			if (level < 0)
+				expected = result;
+			printf(" %10.2f%c", length / fastest * 1e-9,
+				result == expected ? ' ' : '!');
+		}
+		SimdSearchSetLevel(best);
+		printf("\n");
+	}
+
+	free(classes);
+	free(work);
+	free(text);
+	return (0);
+}
+
+/*
+*  Function: run()
+*  One pass of a test, by the ctype loop when level is -1.  Returns a
+*  checksum of the result, the same at every level if all is well.
+*/
+unsigned long long
+run(int test, int level, const char *text, char *work,
+	unsigned char *classes, size_t length)
+{
+	CharCounts counts;
+	unsigned long long sum = 0;
+	size_t i;
+
+	memset(&counts, 0, sizeof(counts));
+	switch (test)
+	{
+	case 0:
+		if (level < 0)
+			for (i = 0; i < length; i++)
+				work[i] = (char)toupper((unsigned char)text[i]);
+		else
+			CharToUpper(work, text, length);
+		for (i = 0; i < length; i += 4096)
+			sum = sum * 31 + (unsigned char)work[i];
+		break;
+	case 1:
+		if (level < 0)
+			for (i = 0; i < length; i++)
+			{
+				if (islower((unsigned char)text[i]))
+					counts.lower++;
+				else if (isupper((unsigned char)text[i]))
+					counts.upper++;
+				else if (ispunct((unsigned char)text[i]))
+					counts.punct++;
+				else if (isspace((unsigned char)text[i]))
+					counts.space++;
+				if (text[i] == '\n')
+					counts.lines++;
+			}
+		else
+			CharCountClasses(&counts, text, length);
+		sum = counts.upper * 7 + counts.lower * 5 + counts.punct * 3 +
+			counts.space * 2 + counts.lines;
+		break;
+	case 2:
+		if (level < 0)
+			for (i = 0; i < length; i++)
+				classes[i] =
+					isupper((unsigned char)text[i]) ? CHAR_UPPER :
+					islower((unsigned char)text[i]) ? CHAR_LOWER :
+					isdigit((unsigned char)text[i]) ? CHAR_DIGIT :
+					isspace((unsigned char)text[i]) ? CHAR_SPACE :
+					ispunct((unsigned char)text[i]) ? CHAR_PUNCT : 0;
+		else
+			CharClassify(classes, text, length);
+		for (i = 0; i < length; i += 4096)
+			sum = sum * 31 + classes[i];
+		break;
+	default:
+		memcpy(work, text, length);
+		if (level < 0)
+		{
+			for (i = 0; i < length; i++)
+				if (work[i] == 'e')
+				{
+					work[i] = 'E';
+					sum++;
+				}
+		}
+		else
+			sum = CharReplace(work, length, 'e', 'E');
+		break;
+	}
+	sink = sum;
+	return (sum);
+}
+
+/*
+*  Function: make_text()
+*  Random words from a short list, in all three cases, with numbers,
+*  punctuation and line ends between.
+*/
+char *
+make_text(size_t length)
+{
+	static const char *words[] = {
+		"the", "Of", "AND", "sequence", "Genome", "read", "align",
+		"assembly", "contig", "VARIANT", "quality", "base", "pair",
+		"1024", "3.14", "(chr7)", "--", "\"quoted\"", "end.\n"
+	};
+	size_t at = 0, n;
+	const char *word;
+	char *text;
+
+	text = (char *)malloc(length);
+	if (text == NULL)
+	{
+		fprintf(stderr, "case_bench: out of memory\n");
+		exit(1);
+	}
+
+	srand(1);
+	while (at < length)
+	{
+		word = words[rand() % (sizeof(words) / sizeof(words[0]))];
+		n = strlen(word);
+		if (n > length - at)
+			n = length - at;
+		memcpy(text + at, word, n);
+		at += n;
+		if (at < length)
+			text[at++] = (rand() % 8 == 0) ? ',' : ' ';
+	}
+	return (text);
+}
+
+double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+void
+usage(void)
+{
+	fprintf(stderr, "Usage: case_bench [-m megabytes] [-r reps]\n");
+}
@@ -5,25 +5,42 @@
 *  Purpose: Take a string from the user at standard input, then ask the user
 *  for a character, search for this character and replace it with a 
 *  a new character specified by the user.
+*  The sentence may be of any length, and the search is memchr() (via
+*  ../utilities/text_search.c), so long input is scanned many bytes at a
+*  time.  Every occurrence is replaced, 32 bytes a step, by CharReplace()
+*  from ../utilities/char_class.c, and the number replaced is shown.
+*  Compile: gcc -I../utilities char_replace.c ../utilities/char_class.c
+*           ../utilities/text_search.c ../utilities/simd_search.c
 */
 
-#include <stdio.h>
+#define _POSIX_C_SOURCE 200809L	/* getline() */
 
-#define MAX_SIZE 81
+#include <stdio.h>
+#include <stdlib.h>
+#include "char_class.h"
+#include "text_search.h"
 
 /* Function prototypes */
-int find_char(char string[], char ch);
-void replace_character(char string[], char replacement, int position);
+long find_char(const char string[], size_t length, char ch);
+size_t replace_character(char string[], size_t length, char ch,
+	char replacement);
 
 main()
 {
-	char string[MAX_SIZE];
+	char *string = NULL;
+	size_t capacity = 0;
+	ssize_t length;
 	char search_char;
 	char replace_char;
-	int position;
+	long position;
+	size_t replaced;
 
 	printf("Please enter a sentence > \n");
-	gets(string);
+	length = getline(&string, &capacity, stdin);
+	if (length < 0)
+		return(1);
+	if (length > 0 && string[length - 1] == '\n')
+		string[--length] = '\0';
 
 	printf("Please enter a character to search for > ");
 	scanf("%c", &search_char);	
@@ -31,42 +48,42 @@ main()
 	printf("Please enter a replacement for this character > ");
 	scanf(" %c", &replace_char);
 
-	position = find_char(string, search_char); 	
+	position = find_char(string, length, search_char); 	
 
-	printf("\nThe character is at position %d", position + 1);
+	if (position < 0)
+		printf("\nThe character was not found");
+	else
+	{
+		printf("\nThe character is at position %ld", position + 1);
 
-	replace_character(string, replace_char, position);
+		replaced = replace_character(string, length, search_char,
+			replace_char);
+		printf("\nIt was replaced %lu time(s)", (unsigned long)replaced);
+	}
 
 	printf("\nThe edited sentence is as follows:\n");
 	puts(string);	
 	printf("\n");
+	free(string);
+	return(0);
 }
 
 
-/* Function find_char */
-int 
-find_char(char string[], char ch)
+/* Function find_char - index of the first ch in string, or -1 */
+long 
+find_char(const char string[], size_t length, char ch)
 {
-	int i;
-	int position;
-
-	for (i = 0; i < MAX_SIZE; i++)
-	{
-		if (string[i] == ch)
-			{
-			position = i;
-			break;
-			}
-	}
+	size_t position = TextFindChar(string, length, ch);
 
-	return(position);
+	return(position == TEXT_NOT_FOUND ? -1L : (long)position);
 }	
 
-/* Function replace_character */
-void 
-replace_character(char string[], char replacement, int position)
+/* Function replace_character - every ch becomes replacement; returns
+   how many there were */
+size_t
+replace_character(char string[], size_t length, char ch, char replacement)
 {
-	string[position] = replacement;	
+	return(CharReplace(string, length, ch, replacement));
 }
 
 
@@ -6,9 +6,16 @@
 *  its two arguments. Assume that their max length is 30.  If the two strings
 *  are different it will return 0, if they are the same it will return 1.
 *  NO LIBRARY FUNCTIONS ARE ALLOWED FOR THIS PROGRAM 
+*  compare() is now TextEqual() from ../utilities/text_compare.c: the
+*  lengths first, then exactly size bytes (the old loop also compared
+*  the byte after the last one), 32 at a time.  Input longer than
+*  MAX_SIZE is cut short instead of running off the arrays.
+*  Compile: gcc -I../utilities compare_strings.c
+*           ../utilities/text_compare.c ../utilities/simd_search.c
 */
 
 #include <stdio.h>
+#include "text_compare.h"
 #define MAX_SIZE 30
 
 /* Function Prototypes */
@@ -27,26 +34,30 @@ main()
 
 	printf("\nPlease enter the first string >\n");
 
-	scanf("%c", &ch);
+	if (scanf("%c", &ch) != 1)
+		ch = '\n';	/* An empty line if the input ends */
 	
 	while (ch != '\n')
 	{
-		string1[i] = ch;
-		i++;
-		scanf("%c", &ch);
+		if (i < MAX_SIZE)
+			string1[i++] = ch;
+		if (scanf("%c", &ch) != 1)
+			break;
 	} 
 	size1 = i;
 
 	i = 0;
 	printf("\nPlease enter the second string >\n");
 
-	scanf("%c", &ch);
+	if (scanf("%c", &ch) != 1)
+		ch = '\n';
 
 	while (ch != '\n')
 	{
-		string2[i] = ch;
-		i++;
-		scanf("%c", &ch);
+		if (i < MAX_SIZE)
+			string2[i++] = ch;
+		if (scanf("%c", &ch) != 1)
+			break;
 	}
 	size2 = i;
 
@@ -59,31 +70,11 @@ main()
 
 }
 
+/* Function compare - 1 if the strings are the same, else 0 */
 int
 compare(char str1[], char str2[], int size1, int size2)
 {
-	int i;
-	int compare_size;
-	int test = 1;
-
-	if (size1 != size2)
-		{
-		test = 0;
-		return(test);
-		}
-
-	compare_size = size1;
-
-	for (i = 0; i <= compare_size; i++)
-	{
-		if (str1[i] != str2[i])
-		{
-			test = 0;
-			break;	
-		}
-	}
-
-	return(test);
+	return(TextEqual(str1, (size_t)size1, str2, (size_t)size2));
 }
 		
 
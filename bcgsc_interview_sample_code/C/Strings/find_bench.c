@@ -0,0 +1,224 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Times substring search over a large text of random words:
+*  a byte by byte loop like the old pos() and find_char(), the C
+*  library's strstr(), and ../utilities/text_search.c at each vector
+*  level the CPU supports.  Each pattern is a word not in the text, so
+*  every search reads the whole text, then all matches of a word that is
+*  are counted.  Prints GB/s.
+*
+*  Usage: find_bench [-m megabytes] [-r reps]
+*
+*  Compile: gcc -O2 -I../utilities find_bench.c ../utilities/text_search.c
+*           ../utilities/simd_search.c
+*/
+
+#define _POSIX_C_SOURCE 200809L	/* clock_gettime() under -std=c11 */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "simd_search.h"
+#include "text_search.h"
+
+#define NUM_PATTERNS 6
+
+static const char *level_names[] = { "scalar", "sse2", "avx2" };
+
+/* Misses, of lengths 1 to 40; the text is only lower case and spaces */
+static const char *patterns[NUM_PATTERNS] = {
+	"Q", "ruQt", "sentinel", "never appears here",
+	"a pattern long enough for Two-Way", "this forty byte pattern is not in there!"
+};
+
+/* Keeps the compiler from dropping the searches */
+static volatile size_t sink;
+
+/* Function Prototypes */
+double now(void);
+size_t old_pos(const char *text, size_t length, const char *pattern,
+	size_t pattern_length);
+char *make_text(size_t length);
+void usage(void);
+
+int
+main(int argc, char *argv[])
+{
+	size_t length = 256, count, m;
+	int reps = 3, best, level, i, p, r;
+	double start, took, fastest;
+	TextMatches matches;
+	char *text, *found;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc)
+		{
+			usage();
+			return (1);
+		}
+		if (strcmp(argv[i], "-m") == 0)
+			length = (size_t)atol(argv[++i]);
+		else if (strcmp(argv[i], "-r") == 0)
+			reps = atoi(argv[++i]);
+		else
+		{
+			usage();
+			return (1);
+		}
+	}
+	if (length < 1)
+		length = 1;
+	if (reps < 1)
+		reps = 1;
+	length <<= 20;
+
+	text = make_text(length);
+	best = SimdSearchLevel();
+	printf("%lu MB of text, best of %d, GB/s\n",
+		(unsigned long)(length >> 20), reps);
+	printf("%-4s %10s %10s", "len", "old loop", "strstr");
+	for (level = SIMD_SCALAR; level <= best; level++)
+		printf(" %10s", level_names[level]);
+	printf("\n");
+
+	for (p = 0; p < NUM_PATTERNS; p++)
+	{
+		m = strlen(patterns[p]);
+		printf("%-4lu", (unsigned long)m);
+
+		fastest = 0;
+		for (r = 0; r < reps; r++)
+		{
+			start = now();
+			sink = old_pos(text, length, patterns[p], m);
+			took = now() - start;
+			if (r == 0 || took < fastest)
+				fastest = took;
+		}
+		printf(" %10.2f", length / fastest * 1e-9);
+
+		fastest = 0;
+		for (r = 0; r < reps; r++)
+		{
+			start = now();
+			sink = (size_t)strstr(text, patterns[p]);
+			took = now() - start;
+			if (r == 0 || took < fastest)
+				fastest = took;
+		}
+		printf(" %10.2f", length / fastest * 1e-9);
+
+		for (level = SIMD_SCALAR; level <= best; level++)
+		{
+			SimdSearchSetLevel(level);
+			fastest = 0;
+			for (r = 0; r < reps; r++)
+			{
+				start = now();
+				sink = TextFind(text, length, patterns[p], m);
+				took = now() - start;
+				if (r == 0 || took < fastest)
+					fastest = took;
+			}
+			printf(" %10.2f", length / fastest * 1e-9);
+		}
+		SimdSearchSetLevel(best);
+		printf("\n");
+	}
+
+	/* Find all, against strstr() restarted after each match */
+	TextMatchesInit(&matches, text, length, "the ", 4);
+	count = 0;
+	start = now();
+	while (TextMatchesNext(&matches) != TEXT_NOT_FOUND)
+		count++;
+	took = now() - start;
+	printf("all %lu matches of \"the \": text_search %.2f GB/s",
+		(unsigned long)count, length / took * 1e-9);
+
+	count = 0;
+	start = now();
+	for (found = strstr(text, "the "); found; found = strstr(found + 4, "the "))
+		count++;
+	took = now() - start;
+	printf(", strstr %.2f GB/s (%lu)\n", length / took * 1e-9,
+		(unsigned long)count);
+
+	free(text);
+	return (0);
+}
+
+/*
+*  Function: old_pos()
+*  Compares the pattern at every position in turn.
+*/
+size_t
+old_pos(const char *text, size_t length, const char *pattern,
+	size_t pattern_length)
+{
+	size_t i, j;
+
+	for (i = 0; i + pattern_length <= length; i++)
+	{
+		for (j = 0; j < pattern_length && text[i + j] == pattern[j]; j++)
+			;
+		if (j == pattern_length)
+			return (i);
+	}
+	return (TEXT_NOT_FOUND);
+}
+
+/*
+*  Function: make_text()
+*  Random words from a short list, '\0' ended for strstr().
+*/
+char *
+make_text(size_t length)
+{
+	static const char *words[] = {
+		"the", "of", "and", "sequence", "genome", "read", "align",
+		"assembly", "contig", "variant", "quality", "base", "pair"
+	};
+	size_t at = 0, n;
+	const char *word;
+	char *text;
+
+	text = (char *)malloc(length + 1);
+	if (text == NULL)
+	{
+		fprintf(stderr, "find_bench: out of memory\n");
+		exit(1);
+	}
+
+	srand(1);
+	while (at < length)
+	{
+		word = words[rand() % (sizeof(words) / sizeof(words[0]))];
+		n = strlen(word);
+		if (n > length - at)
+			n = length - at;
+		memcpy(text + at, word, n);
+		at += n;
+		if (at < length)
+			text[at++] = ' ';
+	}
+	text[length] = '\0';
+	return (text);
+}
+
+double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+void
+usage(void)
+{
+	fprintf(stderr, "Usage: find_bench [-m megabytes] [-r reps]\n");
+}
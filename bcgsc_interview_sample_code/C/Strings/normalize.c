@@ -0,0 +1,109 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Tidies the lines of one or more files (or the standard input)
+*  onto the standard output, as a stage in a pipeline: runs of blanks
+*  become one space, blanks at the ends of lines go, and with -l, -u or
+*  -t each word is put in lower, upper or title case ("mcDONALD" becomes
+*  "Mcdonald").  The work is done in place a block of lines at a time by
+*  ../utilities/text_normal.c, so millions of names stream through in
+*  one buffer.
+*
+*  Usage: normalize [-l | -u | -t] [file ...]
+*
+*  Compile: gcc -O2 -I../utilities normalize.c ../utilities/text_normal.c
+*           ../utilities/simd_search.c
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "text_normal.h"
+
+/* Function Prototypes */
+int normalize_file(const char *name, int rule);
+int write_block(void *arg, char *text, size_t length);
+void usage(void);
+
+int
+main(int argc, char *argv[])
+{
+	int rule = TEXT_CASE_KEEP, status = 0, i;
+
+	for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+	{
+		if (argv[i][2] != '\0')
+		{
+			usage();
+			return (1);
+		}
+
+		switch (argv[i][1])
+		{
+		case 'l':
+			rule = TEXT_CASE_LOWER;
+			break;
+		case 'u':
+			rule = TEXT_CASE_UPPER;
+			break;
+		case 't':
+			rule = TEXT_CASE_TITLE;
+			break;
+		default:
+			usage();
+			return (1);
+		}
+	}
+
+	if (i == argc)
+		status |= !normalize_file("-", rule);
+	for (; i < argc; i++)
+		status |= !normalize_file(argv[i], rule);
+
+	if (fflush(stdout) != 0)
+	{
+		perror("normalize");
+		status = 1;
+	}
+	return (status);
+}
+
+/*
+*  Function: normalize_file()
+*  Tidies the named file ("-" for the standard input) onto the standard
+*  output.  Returns 1, or 0 after reporting what went wrong.
+*/
+int
+normalize_file(const char *name, int rule)
+{
+	FILE *in = stdin;
+	int ok;
+
+	if (strcmp(name, "-") != 0 && (in = fopen(name, "r")) == NULL)
+	{
+		perror(name);
+		return (0);
+	}
+
+	ok = TextNormalFile(in, rule, write_block, stdout);
+	if (!ok)
+		fprintf(stderr, "normalize: cannot tidy %s\n", name);
+	if (in != stdin)
+		fclose(in);
+	return (ok);
+}
+
+/*
+*  Function: write_block()
+*  Passed to TextNormalFile(); writes each tidied block to the stream
+*  arg, stopping if the write fails (a closed pipe, say).
+*/
+int
+write_block(void *arg, char *text, size_t length)
+{
+	return (fwrite(text, 1, length, (FILE *)arg) == length);
+}
+
+void
+usage(void)
+{
+	fprintf(stderr, "Usage: normalize [-l | -u | -t] [file ...]\n");
+}
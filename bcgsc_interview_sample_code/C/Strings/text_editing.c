@@ -1,97 +1,207 @@
 /* Author: Malachi Griffith
-*  Date: Nov. 23 2002 
-*  Purpose: Performs text editing operations on a source string 
+*  Date: Nov. 23 2002
+*  Purpose: Performs text editing operations on a source string
+*  The source is held in a piece table (../utilities/piece_table.c)
+*  rather than a fixed char array, so it may be a whole file of any
+*  size, each insert or delete costs O(log n) however long the text is,
+*  and edits can be undone (U) and redone (R).
+*
+*  Usage: text_editing [-s script] [-o output] [file]
+*  With a file the source is its contents, otherwise it is asked for.
+*  With -s the commands are read from script, with no prompts and
+*  without showing the source after every edit.  A script holds what
+*  would be typed: each command letter on a line of its own, followed
+*  by the lines it asks for, e.g.
+*	I
+*	text to insert
+*	12
+*	D
+*	text to delete
+*	U
+*	M
+*	2
+*	colour
+*	color
+*	centre
+*	center
+*	Q
+*  The edited source is written to output if given, else displayed.
+*
+*  Finding (F, and the string to delete for D) uses the substring search
+*  of ../utilities/text_search.c.  M (multi-replace) asks for a number of
+*  terms, then each term and its replacement, and replaces them all in
+*  one pass over the source with the Aho-Corasick automaton of
+*  ../utilities/multi_search.c: the leftmost match first, the longest
+*  term where several start at the same place.  One U undoes the lot.
+*
+*  Compile: gcc -I../utilities text_editing.c ../utilities/piece_table.c
+*           ../utilities/text_lines.c ../utilities/dyn_stack.c
+*           ../utilities/text_search.c ../utilities/simd_search.c
+*           ../utilities/multi_search.c
 */
 
+#define _POSIX_C_SOURCE 200809L	/* getline() */
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include "dyn_stack.h"
+#include "multi_search.h"
+#include "piece_table.h"
+#include "text_lines.h"
+
+#define NOT_FOUND PIECE_NOT_FOUND
 
-#define MAX_LEN 100
-#define NOT_FOUND -1
+/* A multi-replace scan of the source */
+typedef struct scan_state {
+	MultiScan scan;
+	MultiSelect picker;	/* Picks the matches to replace */
+	DynStack matches;	/* MultiMatch, those picked */
+} ScanState;
 
 /* Function Prototypes */
-char *delete(char *source, int index, int n);
-char *do_edit(char *source, char command);
-char get_command(void);
-char *insert(char *source, const char *to_insert, int index);
-int pos(const char *source, const char *to_find);
+int add_match(void *arg, const MultiMatch *match);
+PieceTable *delete(PieceTable *source, size_t index, size_t n);
+PieceTable *do_edit(PieceTable *source, char command, FILE *in, int prompt);
+char get_command(FILE *in, int prompt);
+PieceTable *insert(PieceTable *source, const char *to_insert, size_t index);
+PieceTable *multi_replace(PieceTable *source, FILE *in, int prompt);
+size_t pos(const PieceTable *source, const char *to_find);
+PieceTable *read_source(const char *file_name);
+char *read_line(FILE *in);
+int scan_run(void *arg, const char *data, size_t length);
+void usage(void);
 
 int
-main(void)
+main(int argc, char *argv[])
 {
-	char source[MAX_LEN];
+	PieceTable *source;
+	FILE *commands = stdin, *output;
+	const char *script = NULL, *output_name = NULL, *file_name = NULL;
 	char command;
+	int i;
 
-	printf("Enter the source string:\n");
-	gets(source);
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			script = argv[++i];
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+			output_name = argv[++i];
+		else if (argv[i][0] != '-' && file_name == NULL)
+			file_name = argv[i];
+		else
+		{
+			usage();
+			return(1);
+		}
+	}
 
-	for(command = get_command();
+	if (script != NULL)
+	{
+		commands = fopen(script, "r");
+		if (commands == NULL)
+		{
+			fprintf(stderr, "text_editing: cannot open %s\n", script);
+			return(1);
+		}
+	}
+
+	source = read_source(file_name);
+	if (source == NULL)
+		return(1);
+
+	for(command = get_command(commands, script == NULL);
 	    command != 'Q';
-	    command = get_command())
+	    command = get_command(commands, script == NULL))
+	{
+		do_edit(source, command, commands, script == NULL);
+		if (script == NULL)
+		{
+			printf("New source: ");
+			PieceTableWrite(source, stdout);
+			printf("\n\n");
+		}
+	}
+
+	if (output_name != NULL)
+	{
+		output = fopen(output_name, "w");
+		if (output == NULL || !PieceTableWrite(source, output) ||
+			fclose(output) != 0)
+		{
+			fprintf(stderr, "text_editing: cannot write %s\n", output_name);
+			return(1);
+		}
+	}
+	else
 	{
-		do_edit(source, command);
-		printf("New source: %s\n\n", source);
+		printf("String after editing: ");
+		PieceTableWrite(source, stdout);
+		printf("\n");
 	}
-	
-	printf("String after editing: %s\n", source);
+
+	if (commands != stdin)
+		fclose(commands);
+	PieceTableFree(source);
 	return(0);
 }
 
+/*
+*  Keeps a match picked by a multi-replace scan (a MultiFunc); stops the
+*  scan if memory runs out.
+*/
+int
+add_match(void *arg, const MultiMatch *match)
+{
+	return(DynStackPush((DynStack *)arg, match));
+}
+
 /*
 *  Returns source after deleting n characters beginning with source[index].
 *  If source is too short for full deletion, as many characters are deleted
 *  as possible.
-*  Pre: All parameters are defined and strlen(source) - index - n < MAX_LEN
+*  Pre: All parameters are defined.
 *  Post:  source is modified and returned
 */
-char *
-delete(char *source,	/* input/output - string from which to delete part */
-       int index,	/* input - index of first char to delete */
-       int n)		/* input - number of chars to delete */
+PieceTable *
+delete(PieceTable *source,	/* input/output - text from which to delete */
+       size_t index,		/* input - index of first char to delete */
+       size_t n)		/* input - number of chars to delete */
 {
-	char rest_str[MAX_LEN];	/* Copy of souce substring following 
-				*  characters to delete */
-
-	/* If there are no characters in source following portion to 
-	delete, delete rest of string */
-
-	if (strlen(source) <= index + n)
-	{
-		source[index] = '\0';
-	}
+	if (!PieceTableDelete(source, index, n))
+		fprintf(stderr, "Out of memory, nothing deleted\n");
 
-	/* Otherwise, copy the portion following the portion to delete
-	*  and place it in source beginning at the index position */
-	else
-	{
-		strcpy(rest_str, &source[index + n]);
-		strcpy(&source[index], rest_str);
-	}
-	
 	return(source);
 }
 
 /*
 *  Performs the edit operation specified by command
-*  Pre: command and source are defined.
-*  Post:  After scanning additional information needed, performs a 
+*  Pre: command and source are defined, in is where the rest of the
+*  command is read from and prompt is nonzero to ask for it.
+*  Post:  After scanning additional information needed, performs a
 *   	  deletion (command = 'D') or insertion (command = 'I') or
-*	  finds a substring ('F') and displays result; returns
-*	  (possibly modified) source.
+*	  finds a substring ('F') and displays result, or replaces
+*	  several strings at once ('M'), or undoes ('U') or redoes ('R')
+*	  an edit; returns (possibly modified) source.
 */
-char *
-do_edit(char *source,  /* input/output - string to modify or search */
-	char command)  /* input - character indicating operation */
+PieceTable *
+do_edit(PieceTable *source,  /* input/output - text to modify or search */
+	char command,	     /* input - character indicating operation */
+	FILE *in,	     /* input - where the command continues */
+	int prompt)	     /* input - whether to prompt for it */
 {
-	char str[MAX_LEN];	/* work string */
-	int index;
+	char *str = NULL;	/* work string */
+	char *number = NULL;
+	size_t index;
 
 	switch (command)
 	{
 	case 'D':
-		printf("String to delete> ");
-		gets(str);
+		if (prompt)
+			printf("String to delete> ");
+		if ((str = read_line(in)) == NULL)
+			break;
 		index = pos(source, str);
 		if (index == NOT_FOUND)
 			printf("'%s' not found\n", str);
@@ -100,109 +210,308 @@ do_edit(char *source,  /* input/output - string to modify or search */
 		break;
 
 	case 'I':
-		printf("String to insert > ");
-		gets(str);
-		printf("Position of insertion > ");
-		scanf("%d", &index);
-		insert(source, str, index);
+		if (prompt)
+			printf("String to insert > ");
+		if ((str = read_line(in)) == NULL)
+			break;
+		if (prompt)
+			printf("Position of insertion > ");
+		if ((number = read_line(in)) == NULL)
+			break;
+		insert(source, str, (size_t)strtoul(number, NULL, 10));
 		break;
 
 	case 'F':
-		printf("String to find > ");
-		gets(str);
+		if (prompt)
+			printf("String to find > ");
+		if ((str = read_line(in)) == NULL)
+			break;
 		index = pos(source, str);
 		if (index == NOT_FOUND)
 			printf("'%s' not found\n", str);
 		else
-			printf("'%s' found at position %d\n", str, index);
+			printf("'%s' found at position %lu\n", str,
+				(unsigned long)index);
+		break;
+
+	case 'M':
+		multi_replace(source, in, prompt);
+		break;
+
+	case 'U':
+		if (!PieceTableUndo(source))
+			printf("Nothing to undo\n");
+		break;
+
+	case 'R':
+		if (!PieceTableRedo(source))
+			printf("Nothing to redo\n");
 		break;
 
 	default:
 		printf("Invalid edit command '%c'\n", command);
 	}
 
+	free(str);
+	free(number);
 	return(source);
 }
 
 /*
-*  Prompt for and get a character representing an edit command and 
-*  convert it to uppercase.  Return the uppercase character and ignore 
-*  rest of input line.
+*  Prompt for and get a character representing an edit command and
+*  convert it to uppercase.  Return the uppercase character and ignore
+*  rest of input line.  The end of the commands counts as Q.
 */
 char
-get_command(void)
+get_command(FILE *in, int prompt)
 {
-	char command, ignore;
+	char *line;
+	char command = 'Q';
+	size_t i;
 
-	printf("Enter D (delete), I(insert), F(Find), or Q (Quit) > ");
-	scanf(" %c", &command);
+	if (prompt)
+		printf("Enter D (delete), I(insert), F(Find), M(Multi-replace), "
+			"U(Undo), R(Redo), or Q (Quit) > ");
 
-	do
-		ignore = getchar();
-	while (ignore != '\n');
+	while ((line = read_line(in)) != NULL)
+	{
+		for (i = 0; isspace((unsigned char)line[i]); i++)
+			;
+		command = line[i];
+		free(line);
+		if (command != '\0')
+			return (toupper(command));
+		command = 'Q';
+	}
 
-	return (toupper(command));
+	return (command);
 }
 
 /*
 *  Returns source after inserting to_insert at postion index of source.
 *  If source[index] doesn't exist, adds to_insert at end of source.
-*  Pre: all parameters are defined, space available for source is 
-*  enough to accomodate insertion, and strlen(source) - index - n < MAX_LEN
+*  Pre: all parameters are defined.
 *  Post: source is modified and returned
 */
-char *
-insert(char *source, 		/* input/output - target of insertion */
+PieceTable *
+insert(PieceTable *source, 	/* input/output - target of insertion */
        const char *to_insert,	/* input - string to insert */
-       int index)		/* input - position where to_insert is 
+       size_t index)		/* input - position where to_insert is
 				*  is to be inserted*/
 {
-	char rest_str[MAX_LEN]; /* copy of rest of source beginning 
-				* with source[index] */
+	if (!PieceTableInsert(source, index, to_insert, strlen(to_insert)))
+		fprintf(stderr, "Out of memory, nothing inserted\n");
 
-	if (strlen(source) <= index)
+	return(source);
+}
+
+/*
+*  Asks for a number of terms and a replacement for each, then replaces
+*  every match in source in one pass, as a single undoable edit.
+*  Pre: source is defined, in is where the terms are read from and
+*  prompt is nonzero to ask for them.
+*  Post: source is modified and returned.
+*/
+PieceTable *
+multi_replace(PieceTable *source,	/* input/output - text to modify */
+	      FILE *in,			/* input - where the terms are */
+	      int prompt)		/* input - whether to prompt for them */
+{
+	MultiSearch *search;
+	ScanState state;
+	MultiMatch *matches;
+	char **terms = NULL, **replacements = NULL, *line;
+	size_t num_terms, count, i, n = 0;
+	int id, ok = 1, made = 0;
+
+	if (prompt)
+		printf("Number of terms > ");
+	if ((line = read_line(in)) == NULL)
+		return(source);
+	num_terms = (size_t)strtoul(line, NULL, 10);
+	free(line);
+
+	search = MultiSearchCreate();
+	if (num_terms > 0)
 	{
-		strcat(source, to_insert);
+		terms = (char **)calloc(num_terms, sizeof(char *));
+		replacements = (char **)calloc(num_terms, sizeof(char *));
+	}
+	if (search == NULL || (num_terms > 0 && (!terms || !replacements)))
+		ok = 0;
+
+	/* replacements[] is indexed by the number MultiSearchAdd() gives,
+	   which for a term given again is the one it had the first time */
+	for (n = 0; ok && n < num_terms; n++)
+	{
+		if (prompt)
+			printf("String to replace > ");
+		if ((terms[n] = read_line(in)) == NULL)
+			break;
+		if (prompt)
+			printf("Replacement > ");
+		if ((line = read_line(in)) == NULL)
+			break;
+		id = MultiSearchAdd(search, terms[n], strlen(terms[n]));
+		if (id < 0 || replacements[id] != NULL)
+		{
+			if (terms[n][0] == '\0')
+				printf("Empty string ignored\n");
+			else if (id >= 0)
+				printf("'%s' given twice, its first replacement is kept\n",
+					terms[n]);
+			else
+				ok = 0;
+			free(line);
+			continue;
+		}
+		replacements[id] = line;
+	}
+
+	DynStackInit(&state.matches, sizeof(MultiMatch));
+	if (ok && MultiSearchBuild(search) &&
+		MultiSelectInit(&state.picker, search, add_match, &state.matches))
+	{
+		MultiScanInit(&state.scan, search);
+		ok = PieceTableChunks(source, 0, PieceTableLength(source), scan_run,
+			&state) && MultiSelectFinish(&state.picker);
+		MultiSelectFree(&state.picker);
 	}
 	else
+		ok = 0;
+
+	if (ok)
 	{
-		strcpy(rest_str, &source[index]);
-		strcpy(&source[index], to_insert);
-		strcat(source, rest_str);
+		matches = (MultiMatch *)state.matches.data;
+		count = DynStackSize(&state.matches);
+
+		/* From the end, so the positions ahead are still right */
+		PieceTableBeginGroup(source);
+		for (i = count; ok && i > 0; i--)
+		{
+			ok = PieceTableDelete(source, matches[i - 1].position,
+				MultiSearchLength(search, matches[i - 1].pattern));
+			if (ok)
+			{
+				made = 1;
+				ok = PieceTableInsert(source, matches[i - 1].position,
+					replacements[matches[i - 1].pattern],
+					strlen(replacements[matches[i - 1].pattern]));
+			}
+		}
+		PieceTableEndGroup(source);
+
+		if (ok)
+			printf("%lu replacements made\n", (unsigned long)count);
+		else if (made)
+			PieceTableUndo(source);
 	}
+	if (!ok)
+		fprintf(stderr, "Out of memory, nothing replaced\n");
 
+	DynStackFree(&state.matches);
+	for (i = 0; i < num_terms && terms && replacements; i++)
+	{
+		free(terms[i]);
+		free(replacements[i]);
+	}
+	free(terms);
+	free(replacements);
+	MultiSearchFree(search);
 	return(source);
 }
 
 /*
-*  Returns index of first occurence of to_find in source or 
+*  Returns index of first occurence of to_find in source or
 *  value of NOT_FOUND if to_find is not in source.
 *  Pre: both parameters are defined.
 */
-int 
-pos(const char *source,  /* input -  string in which to look for to_find */
-    const char *to_find)  /* input - string to find. */
+size_t
+pos(const PieceTable *source,  /* input -  text in which to look */
+    const char *to_find)       /* input - string to find. */
 {
-	int i = 0, find_len, found = 0, position;
-	char substring[MAX_LEN];
+	return(PieceTableFind(source, 0, to_find, strlen(to_find)));
+}
 
-	find_len = strlen(to_find);
+/*
+*  The whole of file_name, or when it is NULL a line asked for.
+*  Returns NULL (after saying why) if that fails.
+*/
+PieceTable *
+read_source(const char *file_name)
+{
+	PieceTable *source;
+	FILE *input;
+	char *text;
+	size_t length;
 
-	while (!found && i <= strlen(source) - find_len)
+	if (file_name != NULL)
+	{
+		input = fopen(file_name, "r");
+		if (input == NULL)
+		{
+			fprintf(stderr, "text_editing: cannot open %s\n", file_name);
+			return(NULL);
+		}
+		text = TextReadAll(input, &length);
+		fclose(input);
+	}
+	else
 	{
-		strncpy(substring, &source[i], find_len);
-		substring[find_len] = '\0';
+		printf("Enter the source string:\n");
+		text = read_line(stdin);
+		if (text == NULL)
+			text = (char *)calloc(1, 1);
+		length = text ? strlen(text) : 0;
+	}
 
-		if (strcmp(substring, to_find) == 0)
-			found = 1;
-		else
-			++i;
+	source = (text != NULL) ? PieceTableCreate(text, length) : NULL;
+	if (source == NULL)
+	{
+		fprintf(stderr, "text_editing: cannot read the source\n");
+		free(text);
 	}
+	return(source);
+}
 
-	if (found)
-		position = i;
-	else 
-		position = NOT_FOUND;
+/*
+*  Returns the next line of in, of any length, without its '\n', in
+*  storage the caller frees; NULL at end of input.
+*/
+char *
+read_line(FILE *in)
+{
+	char *line = NULL;
+	size_t capacity = 0;
+	ssize_t length;
 
-	return(position);
+	length = getline(&line, &capacity, in);
+	if (length < 0)
+	{
+		free(line);
+		return(NULL);
+	}
+	if (length > 0 && line[length - 1] == '\n')
+		line[--length] = '\0';
+	if (length > 0 && line[length - 1] == '\r')
+		line[length - 1] = '\0';
+	return(line);
+}
+
+/*
+*  Feeds one run of the source to a multi-replace scan (a PieceFunc).
+*/
+int
+scan_run(void *arg, const char *data, size_t length)
+{
+	ScanState *state = (ScanState *)arg;
+
+	return(MultiScanFeed(&state->scan, data, length, MultiSelectMatch,
+		&state->picker));
+}
+
+void
+usage(void)
+{
+	fprintf(stderr, "Usage: text_editing [-s script] [-o output] [file]\n");
 }
@@ -0,0 +1,132 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Counts how often each word occurs in one or more files (or
+*  the standard input) and prints the most frequent, with the number of
+*  words and of distinct words.  Words are runs of letters, digits and
+*  UTF-8 bytes, as ../utilities/word_freq.c takes them; case is ignored
+*  unless -c is given.  A large file is counted a piece per thread.
+*
+*  Usage: word_frequency [-n top] [-c] [file ...]
+*
+*  Compile: gcc -O2 -pthread -I../utilities word_frequency.c
+*           ../utilities/word_freq.c ../utilities/fast_input.c
+*           ../utilities/sort_lib.c ../utilities/thread_pool.c
+*           ../utilities/work_deque.c
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "word_freq.h"
+
+#define DEFAULT_TOP 20
+
+/* Function Prototypes */
+int count_file(WordFreq *table, const char *name);
+void print_top(const WordFreq *table, size_t n);
+void usage(void);
+
+int
+main(int argc, char *argv[])
+{
+	WordFreq *table;
+	size_t top = DEFAULT_TOP;
+	int fold = 1, status = 0, i;
+
+	for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+	{
+		if (argv[i][2] != '\0')
+		{
+			usage();
+			return (1);
+		}
+
+		switch (argv[i][1])
+		{
+		case 'n':
+			if (i + 1 >= argc)
+			{
+				usage();
+				return (1);
+			}
+			top = (size_t)atol(argv[++i]);
+			break;
+		case 'c':
+			fold = 0;
+			break;
+		default:
+			usage();
+			return (1);
+		}
+	}
+
+	table = WordFreqCreate(fold);
+	if (table == NULL)
+	{
+		fprintf(stderr, "word_frequency: out of memory\n");
+		return (1);
+	}
+
+	if (i == argc)
+		status |= !count_file(table, "-");
+	for (; i < argc; i++)
+		status |= !count_file(table, argv[i]);
+
+	print_top(table, top);
+	WordFreqFree(table);
+	return (status);
+}
+
+/*
+*  Function: count_file()
+*  Adds the words of the named file ("-" for the standard input) to the
+*  table.  Returns 1, or 0 after reporting what went wrong.
+*/
+int
+count_file(WordFreq *table, const char *name)
+{
+	FILE *in = stdin;
+	int ok;
+
+	if (strcmp(name, "-") != 0 && (in = fopen(name, "r")) == NULL)
+	{
+		perror(name);
+		return (0);
+	}
+
+	ok = WordFreqFile(table, in);
+	if (!ok)
+		fprintf(stderr, "word_frequency: cannot count %s\n", name);
+	if (in != stdin)
+		fclose(in);
+	return (ok);
+}
+
+/*
+*  Function: print_top()
+*  The n most frequent words, then the totals.
+*/
+void
+print_top(const WordFreq *table, size_t n)
+{
+	WordCount *top = NULL;
+	size_t count = 0, i;
+
+	if (n > WordFreqSize(table))
+		n = WordFreqSize(table);
+	if (n > 0 && (top = (WordCount *)malloc(n * sizeof(WordCount))) != NULL)
+		count = WordFreqTop(table, top, n);
+
+	for (i = 0; i < count; i++)
+		printf("%12llu %.*s\n", top[i].count, (int)top[i].length,
+			top[i].word);
+	printf("%12llu words, %lu distinct\n", WordFreqTotal(table),
+		(unsigned long)WordFreqSize(table));
+	free(top);
+}
+
+void
+usage(void)
+{
+	fprintf(stderr, "Usage: word_frequency [-n top] [-c] [file ...]\n");
+}
@@ -4,14 +4,24 @@
 *  Date: Nov. 14 2002 
 *  Purpose: Read values describing salepeople from a file and enter the 
 *  info into a structure. NOW SORT IN DESCENDING ORDER BY AVERAGE SALES
+*  Ranked with the shared library (../utilities/sort_lib.c).  A full
+*  ranking reads each average once into a (key, index) array and sorts
+*  that (SortByKeys()), so the records are not visited at every compare.
+*  If only the TOP_SELLERS best are wanted, a partial sort finds them in
+*  O(n log k).
+*  Compile: gcc -pthread -I../utilities salespersons2.c ../utilities/sort_lib.c
+*           ../utilities/thread_pool.c ../utilities/work_deque.c
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include "sort_lib.h"
 
 #define NAME_SIZE 15
 #define MAX_YEARS 5
 #define MAX_PEOPLE 4
+#define TOP_SELLERS MAX_PEOPLE	/* How many are ranked and shown */
 
 typedef struct{
 	char first_name[NAME_SIZE];
@@ -26,7 +36,8 @@ typedef sales_record *sales_record_ptr;
 /* Function prototypes */
 void input(sales_record_ptr data[]);
 void sort_averages(sales_record_ptr data[]);
-int find_max(sales_record_ptr data[], int start, int end);
+int compare_averages(const void *a, const void *b);
+uint64_t average_key(const void *item);
 void display(sales_record_ptr data[]);
  
 main()
@@ -79,41 +90,37 @@ input(sales_record_ptr data[])
 void 
 sort_averages(sales_record_ptr data[])
 {
-	sales_record_ptr temp;
-	int index;	
-	int current;
-	int min_position;
-
-
-	for (index = 0; index < MAX_PEOPLE - 1; index++)
-	{
-		current = find_max(data, index, MAX_PEOPLE);
-
-		if(index != current)
-		{
-			temp = data[index];
-			data[index] = data[current];
-			data[current] = temp;
-		}
-	}
+	SortKeyFunc key = average_key;
+
+	/* Only the pointers move, the records stay where they are.  Past
+	*  the first TOP_SELLERS they are left in no particular order. */
+	if (TOP_SELLERS < MAX_PEOPLE ||
+		!SortByKeys(data, MAX_PEOPLE, sizeof(sales_record_ptr), &key, 1))
+		SortPartial(data, MAX_PEOPLE, sizeof(sales_record_ptr),
+			TOP_SELLERS, compare_averages);
 }	
 
 /*
-* Function: find_max()
+* Function: compare_averages()
+* Higher averages sort first.
 */
 int
-find_max(sales_record_ptr data[], int start, int end)
+compare_averages(const void *a, const void *b)
 {
-	int current;
-	int i;
+	int first = (*(const sales_record_ptr *)a)->average;
+	int second = (*(const sales_record_ptr *)b)->average;
 
-	current = start;
-
-	for (i = start + 1; i < end; i++)
-		if(data[i]->average > data[current]->average)
-			current = i;
-
-	return (current);
+	return ((first < second) - (first > second));
+}
+ 
+/*
+* Function: average_key()
+* Inverted, so higher averages sort first.
+*/
+uint64_t
+average_key(const void *item)
+{
+	return (~SortKeyInt((*(const sales_record_ptr *)item)->average));
 }
  
 /*
@@ -125,7 +132,7 @@ display(sales_record_ptr data[])
 	int i;
 
 	/* Display the average for each salesperson along with their name */
-	for (i = 0; i < MAX_PEOPLE; i++)
+	for (i = 0; i < TOP_SELLERS; i++)
 	{
 		printf("\n");
 		printf("%s ", data[i]->first_name);
@@ -0,0 +1,657 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Byte histograms and per line statistics.  See byte_count.h
+*  for the interface.
+*
+*  A histogram loop that does counts[byte]++ stalls whenever two bytes
+*  close together are the same (the second increment has to wait for
+*  the first to reach memory), which in text is often.  Reading eight
+*  bytes at a time and sending them to four separate tables of 32 bit
+*  counts in turn means repeats land in different tables; the tables
+*  are added into the 64 bit totals at the end of each gigabyte.
+*
+*  The line scan compares 32 (AVX2) or 16 (SSE2) bytes at once with
+*  '\n' and with the chosen byte, and a movemask of each turns them into
+*  bit masks: the line ends are the set bits of the first, and the
+*  matches in a line the set bits of the second between two of them.
+*  Word counting makes a mask of the blank bytes the same way; a word
+*  starts at each byte that is not blank but whose predecessor is, so
+*  the starts are ~blank & (blank << 1 | carry), carry saying whether
+*  the last byte of the block before was blank.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "byte_count.h"
+#include "fast_input.h"
+#include "simd_search.h"
+#include "thread_pool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_KERNELS
+#include <immintrin.h>
+#define AVX2 __attribute__((target("avx2,popcnt")))
+#define SSE2 __attribute__((target("sse2")))
+#define FIRST_BIT(mask) __builtin_ctz(mask)
+#define BIT_COUNT(mask) __builtin_popcount(mask)
+#endif
+
+#define FLUSH_SIZE (1 << 30)	/* Bytes counted before the tables are added
+				   up, so 32 bit counts cannot overflow */
+#define PIECE_MIN (8 << 20)	/* Smallest piece counted on its own thread */
+
+#define IS_BLANK(c) ((c) == ' ' || ((c) >= '\t' && (c) <= '\r'))
+
+/* A file counted in pieces on the thread pool */
+typedef struct count_job {
+	const char *data;
+	size_t length;
+	size_t piece;		/* Bytes in each piece but the last */
+	ByteCounts *counts;	/* One histogram per piece */
+	ByteWords *words;	/* Or one word count per piece */
+} CountJob;
+
+/* Function Prototypes (local) */
+static size_t NumPieces(size_t length, ThreadPool **pool);
+static void CountPieces(void *arg, long low, long high);
+static void WordPieces(void *arg, long low, long high);
+static void WordsScalar(ByteWords *words, const unsigned char *data,
+	size_t length);
+static int Emit(ByteLines *lines, ByteLineFunc func, void *arg);
+static int LinesScalar(ByteLines *lines, const char *data, size_t length,
+	ByteLineFunc func, void *arg);
+
+#ifdef HAVE_X86_KERNELS
+static int LinesSse2(ByteLines *lines, const char *data, size_t length,
+	ByteLineFunc func, void *arg);
+static int LinesAvx2(ByteLines *lines, const char *data, size_t length,
+	ByteLineFunc func, void *arg);
+static void WordsSse2(ByteWords *words, const unsigned char *data,
+	size_t length);
+static void WordsAvx2(ByteWords *words, const unsigned char *data,
+	size_t length);
+#endif
+
+/*
+*  Function: ByteCountBlock()
+*  Adds the count of each byte value in data to counts.
+*/
+void
+ByteCountBlock(ByteCounts *counts, const char *data, size_t length)
+{
+	const unsigned char *bytes = (const unsigned char *)data;
+	unsigned int table[4][256];
+	unsigned long long word;
+	size_t chunk, i;
+	int b;
+
+	while (length > 0)
+	{
+		chunk = (length < FLUSH_SIZE) ? length : FLUSH_SIZE;
+		memset(table, 0, sizeof(table));
+
+		for (i = 0; i + 8 <= chunk; i += 8)
+		{
+			memcpy(&word, bytes + i, 8);
+			table[0][word & 0xff]++;
+			table[1][(word >> 8) & 0xff]++;
+			table[2][(word >> 16) & 0xff]++;
+			table[3][(word >> 24) & 0xff]++;
+			table[0][(word >> 32) & 0xff]++;
+			table[1][(word >> 40) & 0xff]++;
+			table[2][(word >> 48) & 0xff]++;
+			table[3][word >> 56]++;
+		}
+		for (; i < chunk; i++)
+			table[0][bytes[i]]++;
+
+		for (b = 0; b < 256; b++)
+			counts->counts[b] += (unsigned long long)table[0][b] +
+				table[1][b] + table[2][b] + table[3][b];
+		bytes += chunk;
+		length -= chunk;
+	}
+}
+
+/*
+*  Function: ByteCountFile()
+*  Sets counts to the histogram of the rest of in.  Returns 1, or 0 if
+*  it could not be read.
+*/
+int
+ByteCountFile(FILE *in, ByteCounts *counts)
+{
+	FastInput input;
+	ThreadPool *pool;
+	CountJob job;
+	const char *data;
+	size_t length, num_pieces, p;
+	int b, ok;
+
+	memset(counts, 0, sizeof(ByteCounts));
+	if (!FastInputOpen(&input, in))
+		return (0);
+
+	if (!FastInputMapped(&input))
+	{
+		while ((length = FastInputBlock(&input, &data)) > 0)
+			ByteCountBlock(counts, data, length);
+		ok = !FastInputError(&input);
+		FastInputClose(&input);
+		return (ok);
+	}
+
+	length = FastInputBlock(&input, &data);
+	num_pieces = NumPieces(length, &pool);
+
+	job.data = data;
+	job.length = length;
+	job.piece = (length + num_pieces - 1) / num_pieces;
+	job.counts = (num_pieces > 1) ?
+		(ByteCounts *)calloc(num_pieces, sizeof(ByteCounts)) : NULL;
+	job.words = NULL;
+
+	if (job.counts == NULL)
+		ByteCountBlock(counts, data, length);
+	else
+	{
+		PoolParallelFor(pool, 0, (long)num_pieces, 1, CountPieces, &job);
+		for (p = 0; p < num_pieces; p++)
+			for (b = 0; b < 256; b++)
+				counts->counts[b] += job.counts[p].counts[b];
+		free(job.counts);
+	}
+
+	FastInputClose(&input);
+	return (1);
+}
+
+/*
+*  Function: ByteLinesInit()
+*/
+void
+ByteLinesInit(ByteLines *lines, unsigned char byte)
+{
+	lines->byte = byte;
+	lines->line.number = 0;
+	lines->line.length = 0;
+	lines->line.matches = 0;
+}
+
+/*
+*  Function: ByteLinesFeed()
+*  Feeds the next length bytes of the text, calling func for each line
+*  that ends in them.  Returns 0 if func stopped the scan (which may not
+*  then be fed again), else 1.
+*/
+int
+ByteLinesFeed(ByteLines *lines, const char *data, size_t length,
+	ByteLineFunc func, void *arg)
+{
+	size_t whole = 0;
+
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		whole = length & ~(size_t)31;
+		if (!LinesAvx2(lines, data, whole, func, arg))
+			return (0);
+		break;
+	case SIMD_SSE2:
+		whole = length & ~(size_t)15;
+		if (!LinesSse2(lines, data, whole, func, arg))
+			return (0);
+		break;
+	}
+#endif
+	return (LinesScalar(lines, data + whole, length - whole, func, arg));
+}
+
+/*
+*  Function: ByteLinesEnd()
+*  Reports the last line if the text did not end with '\n'.  Returns
+*  what func did, or 1 if there was no such line.
+*/
+int
+ByteLinesEnd(ByteLines *lines, ByteLineFunc func, void *arg)
+{
+	if (lines->line.length == 0)
+		return (1);
+	return (Emit(lines, func, arg));
+}
+
+/*
+*  Function: ByteLinesFile()
+*  Calls func for each line of the rest of in, counting byte in each.
+*  Returns 1, or 0 if func stopped it or in could not be read.
+*/
+int
+ByteLinesFile(FILE *in, unsigned char byte, ByteLineFunc func, void *arg)
+{
+	FastInput input;
+	ByteLines lines;
+	const char *data;
+	size_t length;
+	int ok = 1;
+
+	if (!FastInputOpen(&input, in))
+		return (0);
+
+	ByteLinesInit(&lines, byte);
+	while (ok && (length = FastInputBlock(&input, &data)) > 0)
+		ok = ByteLinesFeed(&lines, data, length, func, arg);
+	if (FastInputError(&input))
+		ok = 0;
+	FastInputClose(&input);
+
+	return (ok && ByteLinesEnd(&lines, func, arg));
+}
+
+/*
+*  Function: ByteWordsInit()
+*/
+void
+ByteWordsInit(ByteWords *words)
+{
+	words->lines = 0;
+	words->words = 0;
+	words->bytes = 0;
+	words->in_word = 0;
+}
+
+/*
+*  Function: ByteWordsFeed()
+*  Adds the lines, words and bytes of the next length bytes of the text;
+*  a word running on from the last piece fed is not counted again.
+*/
+void
+ByteWordsFeed(ByteWords *words, const char *data, size_t length)
+{
+	const unsigned char *bytes = (const unsigned char *)data;
+	size_t whole = 0;
+
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		whole = length & ~(size_t)31;
+		WordsAvx2(words, bytes, whole);
+		break;
+	case SIMD_SSE2:
+		whole = length & ~(size_t)15;
+		WordsSse2(words, bytes, whole);
+		break;
+	}
+#endif
+	WordsScalar(words, bytes + whole, length - whole);
+	words->bytes += length;
+}
+
+/*
+*  Function: ByteWordsFile()
+*  Sets words to the counts for the rest of in.  Returns 1, or 0 if it
+*  could not be read.
+*/
+int
+ByteWordsFile(FILE *in, ByteWords *words)
+{
+	FastInput input;
+	ThreadPool *pool;
+	CountJob job;
+	const char *data;
+	size_t length, num_pieces, p;
+	int ok;
+
+	ByteWordsInit(words);
+	if (!FastInputOpen(&input, in))
+		return (0);
+
+	if (!FastInputMapped(&input))
+	{
+		while ((length = FastInputBlock(&input, &data)) > 0)
+			ByteWordsFeed(words, data, length);
+		ok = !FastInputError(&input);
+		FastInputClose(&input);
+		return (ok);
+	}
+
+	length = FastInputBlock(&input, &data);
+	num_pieces = NumPieces(length, &pool);
+
+	job.data = data;
+	job.length = length;
+	job.piece = (length + num_pieces - 1) / num_pieces;
+	job.counts = NULL;
+	job.words = (num_pieces > 1) ?
+		(ByteWords *)calloc(num_pieces, sizeof(ByteWords)) : NULL;
+
+	if (job.words == NULL)
+		ByteWordsFeed(words, data, length);
+	else
+	{
+		PoolParallelFor(pool, 0, (long)num_pieces, 1, WordPieces, &job);
+		for (p = 0; p < num_pieces; p++)
+		{
+			words->lines += job.words[p].lines;
+			words->words += job.words[p].words;
+			words->bytes += job.words[p].bytes;
+		}
+		free(job.words);
+	}
+
+	FastInputClose(&input);
+	return (1);
+}
+
+/*
+*  Function: NumPieces()
+*  How many pieces to count a mapped file of length bytes in; *pool is
+*  the pool to count them on, NULL for one piece.
+*/
+static size_t
+NumPieces(size_t length, ThreadPool **pool)
+{
+	size_t num_pieces = 1;
+
+	*pool = NULL;
+	if (length >= 2 * PIECE_MIN)
+	{
+		*pool = PoolDefault();
+		if (*pool != NULL && PoolNumThreads(*pool) >= 2)
+		{
+			/* A few pieces a thread, so a slow one can be helped */
+			num_pieces = length / PIECE_MIN;
+			if (num_pieces > 4 * (size_t)PoolNumThreads(*pool))
+				num_pieces = 4 * (size_t)PoolNumThreads(*pool);
+		}
+		else
+			*pool = NULL;
+	}
+	return (num_pieces);
+}
+
+/*
+*  Function: CountPieces()
+*  Pool task: counts pieces [low, high) of a file.
+*/
+static void
+CountPieces(void *arg, long low, long high)
+{
+	CountJob *job = (CountJob *)arg;
+	size_t start, n;
+	long p;
+
+	for (p = low; p < high; p++)
+	{
+		start = (size_t)p * job->piece;
+		if (start >= job->length)
+			break;
+		n = job->length - start;
+		if (n > job->piece)
+			n = job->piece;
+		ByteCountBlock(&job->counts[p], job->data + start, n);
+	}
+}
+
+/*
+*  Function: WordPieces()
+*  Pool task: counts the words of pieces [low, high) of a file.
+*/
+static void
+WordPieces(void *arg, long low, long high)
+{
+	CountJob *job = (CountJob *)arg;
+	size_t start, n;
+	long p;
+
+	for (p = low; p < high; p++)
+	{
+		start = (size_t)p * job->piece;
+		if (start >= job->length)
+			break;
+		n = job->length - start;
+		if (n > job->piece)
+			n = job->piece;
+
+		/* A word begun in the piece before is counted there */
+		ByteWordsInit(&job->words[p]);
+		job->words[p].in_word = start > 0 &&
+			!IS_BLANK((unsigned char)job->data[start - 1]);
+		ByteWordsFeed(&job->words[p], job->data + start, n);
+	}
+}
+
+/*
+*  Function: Emit()
+*  Reports the line so far as ended, and starts the next.
+*/
+static int
+Emit(ByteLines *lines, ByteLineFunc func, void *arg)
+{
+	int ok;
+
+	lines->line.number++;
+	ok = func(arg, &lines->line);
+	lines->line.length = 0;
+	lines->line.matches = 0;
+	return (ok);
+}
+
+/*
+*  Function: LinesScalar()
+*  memchr() finds each line end, then the line's bytes are compared.
+*/
+static int
+LinesScalar(ByteLines *lines, const char *data, size_t length,
+	ByteLineFunc func, void *arg)
+{
+	const char *end = data + length, *stop;
+	size_t matches;
+
+	while (data < end)
+	{
+		stop = (const char *)memchr(data, '\n', end - data);
+		if (stop == NULL)
+			stop = end;
+
+		lines->line.length += stop - data;
+		for (matches = 0; data < stop; data++)
+			matches += ((unsigned char)*data == lines->byte);
+		lines->line.matches += matches;
+
+		if (stop < end)
+		{
+			if (!Emit(lines, func, arg))
+				return (0);
+			data = stop + 1;
+		}
+	}
+	return (1);
+}
+
+/*
+*  Function: WordsScalar()
+*  Counts lines and word starts, leaving out the byte count.
+*/
+static void
+WordsScalar(ByteWords *words, const unsigned char *data, size_t length)
+{
+	unsigned long long lines = 0, starts = 0;
+	int in_word = words->in_word;
+	size_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		if (IS_BLANK(data[i]))
+		{
+			lines += (data[i] == '\n');
+			in_word = 0;
+		}
+		else
+		{
+			starts += !in_word;
+			in_word = 1;
+		}
+	}
+
+	words->lines += lines;
+	words->words += starts;
+	words->in_word = in_word;
+}
+
+#ifdef HAVE_X86_KERNELS
+
+/*
+*  Function: LinesSse2()
+*  length is a multiple of 16.
+*/
+SSE2 static int
+LinesSse2(ByteLines *lines, const char *data, size_t length,
+	ByteLineFunc func, void *arg)
+{
+	const __m128i newline = _mm_set1_epi8('\n');
+	const __m128i target = _mm_set1_epi8((char)lines->byte);
+	unsigned int ends, hits, at, done;
+	__m128i block;
+	size_t i;
+
+	for (i = 0; i < length; i += 16)
+	{
+		block = _mm_loadu_si128((const __m128i *)(data + i));
+		ends = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+		hits = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(block, target));
+
+		done = 0;
+		while (ends != 0)
+		{
+			at = FIRST_BIT(ends);
+			lines->line.length += at - done;
+			lines->line.matches += BIT_COUNT(hits & ((1u << at) - 1));
+			if (!Emit(lines, func, arg))
+				return (0);
+			done = at + 1;
+			hits &= ~0u << done;
+			ends &= ends - 1;
+		}
+		lines->line.length += 16 - done;
+		lines->line.matches += BIT_COUNT(hits);
+	}
+	return (1);
+}
+
+/*
+*  Function: LinesAvx2()
+*  length is a multiple of 32.
+*/
+AVX2 static int
+LinesAvx2(ByteLines *lines, const char *data, size_t length,
+	ByteLineFunc func, void *arg)
+{
+	const __m256i newline = _mm256_set1_epi8('\n');
+	const __m256i target = _mm256_set1_epi8((char)lines->byte);
+	unsigned int ends, hits, at, done;
+	__m256i block;
+	size_t i;
+
+	for (i = 0; i < length; i += 32)
+	{
+		block = _mm256_loadu_si256((const __m256i *)(data + i));
+		ends = (unsigned int)_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(block, newline));
+		hits = (unsigned int)_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(block, target));
+
+		done = 0;
+		while (ends != 0)
+		{
+			at = FIRST_BIT(ends);
+			lines->line.length += at - done;
+			lines->line.matches += BIT_COUNT(hits & ((1u << at) - 1));
+			if (!Emit(lines, func, arg))
+				return (0);
+			done = at + 1;
+			hits = (done < 32) ? hits & (~0u << done) : 0;
+			ends &= ends - 1;
+		}
+		lines->line.length += 32 - done;
+		lines->line.matches += BIT_COUNT(hits);
+	}
+	return (1);
+}
+
+/*
+*  Function: WordsSse2()
+*  length is a multiple of 16.  A byte is blank if it is a space or
+*  lies in '\t'..'\r', i.e. min(c - '\t', 4) == c - '\t' unsigned.
+*/
+SSE2 static void
+WordsSse2(ByteWords *words, const unsigned char *data, size_t length)
+{
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i tab = _mm_set1_epi8('\t');
+	const __m128i four = _mm_set1_epi8(4);
+	const __m128i newline = _mm_set1_epi8('\n');
+	unsigned long long lines = 0, starts = 0;
+	unsigned int blank, carry = !words->in_word;
+	__m128i block, offset;
+	size_t i;
+
+	for (i = 0; i < length; i += 16)
+	{
+		block = _mm_loadu_si128((const __m128i *)(data + i));
+		offset = _mm_sub_epi8(block, tab);
+		blank = (unsigned int)_mm_movemask_epi8(_mm_or_si128(
+			_mm_cmpeq_epi8(block, space),
+			_mm_cmpeq_epi8(_mm_min_epu8(offset, four), offset)));
+
+		starts += BIT_COUNT(~blank & ((blank << 1) | carry) & 0xffff);
+		lines += BIT_COUNT((unsigned int)_mm_movemask_epi8(
+			_mm_cmpeq_epi8(block, newline)));
+		carry = (blank >> 15) & 1;
+	}
+
+	words->lines += lines;
+	words->words += starts;
+	if (length > 0)
+		words->in_word = !carry;
+}
+
+/*
+*  Function: WordsAvx2()
+*  length is a multiple of 32.
+*/
+AVX2 static void
+WordsAvx2(ByteWords *words, const unsigned char *data, size_t length)
+{
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i tab = _mm256_set1_epi8('\t');
+	const __m256i four = _mm256_set1_epi8(4);
+	const __m256i newline = _mm256_set1_epi8('\n');
+	unsigned long long lines = 0, starts = 0;
+	unsigned int blank, carry = !words->in_word;
+	__m256i block, offset;
+	size_t i;
+
+	for (i = 0; i < length; i += 32)
+	{
+		block = _mm256_loadu_si256((const __m256i *)(data + i));
+		offset = _mm256_sub_epi8(block, tab);
+		blank = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(
+			_mm256_cmpeq_epi8(block, space),
+			_mm256_cmpeq_epi8(_mm256_min_epu8(offset, four), offset)));
+
+		starts += BIT_COUNT(~blank & ((blank << 1) | carry));
+		lines += BIT_COUNT((unsigned int)_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(block, newline)));
+		carry = blank >> 31;
+	}
+
+	words->lines += lines;
+	words->words += starts;
+	if (length > 0)
+		words->in_word = !carry;
+}
+
+#endif
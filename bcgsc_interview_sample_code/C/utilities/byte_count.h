@@ -0,0 +1,91 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for counting the bytes of a text: a histogram of
+*  all 256 byte values, and statistics for each line in turn.  Files are
+*  read with fast_input.c, mapped into memory (or in 64 KB blocks when
+*  they cannot be, e.g. a pipe), so there is no per-character call.
+*
+*	ByteCountBlock()	Adds a block's bytes to a histogram.  Each
+*				byte goes to one of four sub-histograms in
+*				turn, so runs of the same byte do not wait
+*				on each other's increments.
+*	ByteCountFile()		The histogram of a whole file, the pieces
+*				of a large one counted on the thread pool.
+*	ByteLinesInit/Feed/End()	Streams text, calling back once per
+*				line with its length and how many times a
+*				chosen byte (a space, say) occurs in it.
+*				Vector compares find the line ends and the
+*				chosen byte 32 bytes at a time.
+*	ByteLinesFile()		The same over a whole file.
+*	ByteWordsInit/Feed()	Counts lines, words and bytes as wc does,
+*				a word being a run of bytes that are not
+*				blank (space, tab, newline, \v, \f, \r).
+*				Text may be fed in pieces of any size; the
+*				blank test is done 32 bytes at a time.
+*	ByteWordsFile()		The same over a whole file, the pieces of a
+*				large one counted on the thread pool.  Each
+*				piece counts the words that start in it,
+*				looking back one byte to see whether its
+*				first word began in the piece before.
+*
+*  Any letter, digit or other class count is a sum over the histogram,
+*  e.g. counts['A'] + ... + counts['Z'].
+*  Compile with byte_count.c, fast_input.c, simd_search.c, thread_pool.c,
+*  work_deque.c and -pthread.
+*/
+
+#ifndef _BYTE_COUNT_H_
+#define _BYTE_COUNT_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct byte_counts {
+	unsigned long long counts[256];
+} ByteCounts;
+
+typedef struct byte_line {
+	size_t number;		/* 1 for the first line */
+	size_t length;		/* Bytes, not counting the '\n' */
+	size_t matches;		/* How many of them are the chosen byte */
+} ByteLine;
+
+/* Called for each line; return 0 to stop */
+typedef int (*ByteLineFunc)(void *arg, const ByteLine *line);
+
+typedef struct byte_lines {
+	unsigned char byte;	/* The byte counted in each line */
+	ByteLine line;		/* The line so far */
+} ByteLines;
+
+typedef struct byte_words {
+	unsigned long long lines;	/* Number of '\n' */
+	unsigned long long words;
+	unsigned long long bytes;
+	int in_word;		/* The last byte fed was part of a word */
+} ByteWords;
+
+/* Function Prototypes */
+void ByteCountBlock(ByteCounts *counts, const char *data, size_t length);
+int ByteCountFile(FILE *in, ByteCounts *counts);
+
+void ByteLinesInit(ByteLines *lines, unsigned char byte);
+int ByteLinesFeed(ByteLines *lines, const char *data, size_t length,
+	ByteLineFunc func, void *arg);
+int ByteLinesEnd(ByteLines *lines, ByteLineFunc func, void *arg);
+int ByteLinesFile(FILE *in, unsigned char byte, ByteLineFunc func,
+	void *arg);
+
+void ByteWordsInit(ByteWords *words);
+void ByteWordsFeed(ByteWords *words, const char *data, size_t length);
+int ByteWordsFile(FILE *in, ByteWords *words);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,549 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Character classes and case.  See char_class.h for the
+*  interface.
+*
+*  Every class is one or two ranges of bytes, and c is in first..last
+*  just when c - first, as an unsigned byte, is at most last - first.
+*  The vector kernels test that 32 (or 16) bytes at once with a
+*  subtract, an unsigned min and a compare, which leaves 0xff in each
+*  lane in the range.  Converting case is then an xor with 0x20 in
+*  those lanes; counting subtracts the masks from vectors of byte
+*  counters.
+*/
+
+#include "char_class.h"
+#include "simd_search.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_KERNELS
+#include <immintrin.h>
+#define AVX2 __attribute__((target("avx2,popcnt")))
+#define SSE2 __attribute__((target("sse2")))
+#define BIT_COUNT(mask) __builtin_popcount(mask)
+#endif
+
+#define NUM_TALLIES 6		/* Upper, lower, digit, space, printable, '\n' */
+#define COUNT_STEPS 255		/* Vectors a byte counter can take */
+
+#define IN_RANGE(c, first, last) \
+	((unsigned char)((c) - (first)) <= (unsigned char)((last) - (first)))
+
+/* Function Prototypes (local) */
+static unsigned int ClassOf(unsigned char c);
+static void CaseScalar(unsigned char *dest, const unsigned char *src,
+	size_t length, unsigned char first);
+static void CaseConvert(char *dest, const char *src, size_t length,
+	unsigned char first);
+
+#ifdef HAVE_X86_KERNELS
+static void AddTallies(CharCounts *counts,
+	const unsigned long long totals[NUM_TALLIES]);
+static void CaseSse2(unsigned char *dest, const unsigned char *src,
+	size_t length, unsigned char first);
+static void CaseAvx2(unsigned char *dest, const unsigned char *src,
+	size_t length, unsigned char first);
+static void ClassifySse2(unsigned char classes[], const unsigned char *text,
+	size_t length);
+static void ClassifyAvx2(unsigned char classes[], const unsigned char *text,
+	size_t length);
+static void CountSse2(CharCounts *counts, const unsigned char *text,
+	size_t length);
+static void CountAvx2(CharCounts *counts, const unsigned char *text,
+	size_t length);
+static size_t ReplaceSse2(unsigned char *text, size_t length,
+	unsigned char from, unsigned char to);
+static size_t ReplaceAvx2(unsigned char *text, size_t length,
+	unsigned char from, unsigned char to);
+#endif
+
+/*
+*  Function: CharToUpper()
+*  dest gets src with a to z made A to Z.
+*/
+void
+CharToUpper(char *dest, const char *src, size_t length)
+{
+	CaseConvert(dest, src, length, 'a');
+}
+
+/*
+*  Function: CharToLower()
+*  dest gets src with A to Z made a to z.
+*/
+void
+CharToLower(char *dest, const char *src, size_t length)
+{
+	CaseConvert(dest, src, length, 'A');
+}
+
+/*
+*  Function: CharClassify()
+*  classes[i] gets the CHAR_... bits of text[i]; at most one is set.
+*/
+void
+CharClassify(unsigned char classes[], const char *text, size_t length)
+{
+	const unsigned char *bytes = (const unsigned char *)text;
+	size_t whole = 0, i;
+
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		whole = length & ~(size_t)31;
+		ClassifyAvx2(classes, bytes, whole);
+		break;
+	case SIMD_SSE2:
+		whole = length & ~(size_t)15;
+		ClassifySse2(classes, bytes, whole);
+		break;
+	}
+#endif
+	for (i = whole; i < length; i++)
+		classes[i] = (unsigned char)ClassOf(bytes[i]);
+}
+
+/*
+*  Function: CharCountClasses()
+*  Adds the number of characters of text in each class, and of '\n', to
+*  counts, so a text may be counted a block at a time.
+*/
+void
+CharCountClasses(CharCounts *counts, const char *text, size_t length)
+{
+	const unsigned char *bytes = (const unsigned char *)text;
+	size_t whole = 0, i;
+	unsigned int class_bits;
+
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		whole = length & ~(size_t)31;
+		CountAvx2(counts, bytes, whole);
+		break;
+	case SIMD_SSE2:
+		whole = length & ~(size_t)15;
+		CountSse2(counts, bytes, whole);
+		break;
+	}
+#endif
+	for (i = whole; i < length; i++)
+	{
+		class_bits = ClassOf(bytes[i]);
+		counts->upper += (class_bits == CHAR_UPPER);
+		counts->lower += (class_bits == CHAR_LOWER);
+		counts->digit += (class_bits == CHAR_DIGIT);
+		counts->space += (class_bits == CHAR_SPACE);
+		counts->punct += (class_bits == CHAR_PUNCT);
+		counts->lines += (bytes[i] == '\n');
+	}
+}
+
+/*
+*  Function: CharReplace()
+*  Makes every from in text a to, and returns how many there were.
+*/
+size_t
+CharReplace(char *text, size_t length, char from, char to)
+{
+	unsigned char *bytes = (unsigned char *)text;
+	size_t whole = 0, replaced = 0, i;
+
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		whole = length & ~(size_t)31;
+		replaced = ReplaceAvx2(bytes, whole, (unsigned char)from,
+			(unsigned char)to);
+		break;
+	case SIMD_SSE2:
+		whole = length & ~(size_t)15;
+		replaced = ReplaceSse2(bytes, whole, (unsigned char)from,
+			(unsigned char)to);
+		break;
+	}
+#endif
+	for (i = whole; i < length; i++)
+		if (text[i] == from)
+		{
+			text[i] = to;
+			replaced++;
+		}
+	return (replaced);
+}
+
+/*
+*  Function: ClassOf()
+*  The CHAR_... bit of one character, 0 if it is in no class.
+*/
+static unsigned int
+ClassOf(unsigned char c)
+{
+	if (IN_RANGE(c, 'A', 'Z'))
+		return (CHAR_UPPER);
+	if (IN_RANGE(c, 'a', 'z'))
+		return (CHAR_LOWER);
+	if (IN_RANGE(c, '0', '9'))
+		return (CHAR_DIGIT);
+	if (c == ' ' || IN_RANGE(c, '\t', '\r'))
+		return (CHAR_SPACE);
+	if (IN_RANGE(c, '!', '~'))
+		return (CHAR_PUNCT);
+	return (0);
+}
+
+/*
+*  Function: CaseScalar()
+*  Flips the case of the letters in first..first + 25.
+*/
+static void
+CaseScalar(unsigned char *dest, const unsigned char *src, size_t length,
+	unsigned char first)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++)
+		dest[i] = (unsigned char)(src[i] ^
+			(IN_RANGE(src[i], first, first + 25) << 5));
+}
+
+/*
+*  Function: CaseConvert()
+*  The whole vectors by the best kernel, the rest in plain C.
+*/
+static void
+CaseConvert(char *dest, const char *src, size_t length, unsigned char first)
+{
+	unsigned char *to = (unsigned char *)dest;
+	const unsigned char *from = (const unsigned char *)src;
+	size_t whole = 0;
+
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		whole = length & ~(size_t)31;
+		CaseAvx2(to, from, whole, first);
+		break;
+	case SIMD_SSE2:
+		whole = length & ~(size_t)15;
+		CaseSse2(to, from, whole, first);
+		break;
+	}
+#endif
+	CaseScalar(to + whole, from + whole, length - whole, first);
+}
+
+#ifdef HAVE_X86_KERNELS
+
+/*
+*  Function: AddTallies()
+*  Adds the totals of a vector count, in the order of NUM_TALLIES.
+*/
+static void
+AddTallies(CharCounts *counts, const unsigned long long totals[NUM_TALLIES])
+{
+	counts->upper += totals[0];
+	counts->lower += totals[1];
+	counts->digit += totals[2];
+	counts->space += totals[3];
+	counts->punct += totals[4] - totals[0] - totals[1] - totals[2];
+	counts->lines += totals[5];
+}
+
+/*
+*  Function: RangeSse2()
+*  0xff in each lane of block in first..last, else 0.
+*/
+SSE2 static inline __m128i
+RangeSse2(__m128i block, unsigned char first, unsigned char last)
+{
+	__m128i offset = _mm_sub_epi8(block, _mm_set1_epi8((char)first));
+
+	return (_mm_cmpeq_epi8(_mm_min_epu8(offset,
+		_mm_set1_epi8((char)(last - first))), offset));
+}
+
+AVX2 static inline __m256i
+RangeAvx2(__m256i block, unsigned char first, unsigned char last)
+{
+	__m256i offset = _mm256_sub_epi8(block, _mm256_set1_epi8((char)first));
+
+	return (_mm256_cmpeq_epi8(_mm256_min_epu8(offset,
+		_mm256_set1_epi8((char)(last - first))), offset));
+}
+
+/*
+*  Function: CaseSse2()
+*  length is a multiple of 16.
+*/
+SSE2 static void
+CaseSse2(unsigned char *dest, const unsigned char *src, size_t length,
+	unsigned char first)
+{
+	const __m128i flip = _mm_set1_epi8(0x20);
+	__m128i block;
+	size_t i;
+
+	for (i = 0; i < length; i += 16)
+	{
+		block = _mm_loadu_si128((const __m128i *)(src + i));
+		block = _mm_xor_si128(block, _mm_and_si128(flip,
+			RangeSse2(block, first, first + 25)));
+		_mm_storeu_si128((__m128i *)(dest + i), block);
+	}
+}
+
+/*
+*  Function: CaseAvx2()
+*  length is a multiple of 32.
+*/
+AVX2 static void
+CaseAvx2(unsigned char *dest, const unsigned char *src, size_t length,
+	unsigned char first)
+{
+	const __m256i flip = _mm256_set1_epi8(0x20);
+	__m256i block;
+	size_t i;
+
+	for (i = 0; i < length; i += 32)
+	{
+		block = _mm256_loadu_si256((const __m256i *)(src + i));
+		block = _mm256_xor_si256(block, _mm256_and_si256(flip,
+			RangeAvx2(block, first, first + 25)));
+		_mm256_storeu_si256((__m256i *)(dest + i), block);
+	}
+}
+
+/*
+*  Function: ClassifySse2()
+*  length is a multiple of 16.  Each class mask is anded with its bit
+*  and the results ored; punctuation is what is printable and not a
+*  letter, digit or space.
+*/
+SSE2 static void
+ClassifySse2(unsigned char classes[], const unsigned char *text,
+	size_t length)
+{
+	__m128i block, upper, lower, digit, space, punct, bits;
+	size_t i;
+
+	for (i = 0; i < length; i += 16)
+	{
+		block = _mm_loadu_si128((const __m128i *)(text + i));
+		upper = RangeSse2(block, 'A', 'Z');
+		lower = RangeSse2(block, 'a', 'z');
+		digit = RangeSse2(block, '0', '9');
+		space = _mm_or_si128(RangeSse2(block, '\t', '\r'),
+			_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')));
+		punct = _mm_andnot_si128(_mm_or_si128(_mm_or_si128(upper, lower),
+			digit), RangeSse2(block, '!', '~'));
+
+		bits = _mm_and_si128(upper, _mm_set1_epi8(CHAR_UPPER));
+		bits = _mm_or_si128(bits,
+			_mm_and_si128(lower, _mm_set1_epi8(CHAR_LOWER)));
+		bits = _mm_or_si128(bits,
+			_mm_and_si128(digit, _mm_set1_epi8(CHAR_DIGIT)));
+		bits = _mm_or_si128(bits,
+			_mm_and_si128(space, _mm_set1_epi8(CHAR_SPACE)));
+		bits = _mm_or_si128(bits,
+			_mm_and_si128(punct, _mm_set1_epi8(CHAR_PUNCT)));
+		_mm_storeu_si128((__m128i *)(classes + i), bits);
+	}
+}
+
+/*
+*  Function: ClassifyAvx2()
+*  length is a multiple of 32.
+*/
+AVX2 static void
+ClassifyAvx2(unsigned char classes[], const unsigned char *text,
+	size_t length)
+{
+	__m256i block, upper, lower, digit, space, punct, bits;
+	size_t i;
+
+	for (i = 0; i < length; i += 32)
+	{
+		block = _mm256_loadu_si256((const __m256i *)(text + i));
+		upper = RangeAvx2(block, 'A', 'Z');
+		lower = RangeAvx2(block, 'a', 'z');
+		digit = RangeAvx2(block, '0', '9');
+		space = _mm256_or_si256(RangeAvx2(block, '\t', '\r'),
+			_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')));
+		punct = _mm256_andnot_si256(_mm256_or_si256(
+			_mm256_or_si256(upper, lower), digit),
+			RangeAvx2(block, '!', '~'));
+
+		bits = _mm256_and_si256(upper, _mm256_set1_epi8(CHAR_UPPER));
+		bits = _mm256_or_si256(bits,
+			_mm256_and_si256(lower, _mm256_set1_epi8(CHAR_LOWER)));
+		bits = _mm256_or_si256(bits,
+			_mm256_and_si256(digit, _mm256_set1_epi8(CHAR_DIGIT)));
+		bits = _mm256_or_si256(bits,
+			_mm256_and_si256(space, _mm256_set1_epi8(CHAR_SPACE)));
+		bits = _mm256_or_si256(bits,
+			_mm256_and_si256(punct, _mm256_set1_epi8(CHAR_PUNCT)));
+		_mm256_storeu_si256((__m256i *)(classes + i), bits);
+	}
+}
+
+/*
+*  Function: CountSse2()
+*  length is a multiple of 16.  Each class has a vector of byte counters
+*  (subtracting a mask of 0xff adds 1); they are summed into the totals
+*  with psadbw every COUNT_STEPS vectors, before a byte can overflow.
+*  Printable characters are counted as a whole and the other classes
+*  taken away to leave the punctuation.
+*/
+SSE2 static void
+CountSse2(CharCounts *counts, const unsigned char *text, size_t length)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i block, tally[NUM_TALLIES], sums[NUM_TALLIES];
+	unsigned long long totals[NUM_TALLIES], lanes[2];
+	size_t i, stop;
+	int t;
+
+	for (t = 0; t < NUM_TALLIES; t++)
+		sums[t] = zero;
+
+	for (i = 0; i < length; i = stop)
+	{
+		stop = (length - i > 16 * COUNT_STEPS) ? i + 16 * COUNT_STEPS : length;
+		for (t = 0; t < NUM_TALLIES; t++)
+			tally[t] = zero;
+		for (; i < stop; i += 16)
+		{
+			block = _mm_loadu_si128((const __m128i *)(text + i));
+			tally[0] = _mm_sub_epi8(tally[0], RangeSse2(block, 'A', 'Z'));
+			tally[1] = _mm_sub_epi8(tally[1], RangeSse2(block, 'a', 'z'));
+			tally[2] = _mm_sub_epi8(tally[2], RangeSse2(block, '0', '9'));
+			tally[3] = _mm_sub_epi8(tally[3], _mm_or_si128(
+				RangeSse2(block, '\t', '\r'),
+				_mm_cmpeq_epi8(block, _mm_set1_epi8(' '))));
+			tally[4] = _mm_sub_epi8(tally[4], RangeSse2(block, '!', '~'));
+			tally[5] = _mm_sub_epi8(tally[5],
+				_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+		}
+		for (t = 0; t < NUM_TALLIES; t++)
+			sums[t] = _mm_add_epi64(sums[t], _mm_sad_epu8(tally[t], zero));
+	}
+
+	for (t = 0; t < NUM_TALLIES; t++)
+	{
+		_mm_storeu_si128((__m128i *)lanes, sums[t]);
+		totals[t] = lanes[0] + lanes[1];
+	}
+	AddTallies(counts, totals);
+}
+
+/*
+*  Function: CountAvx2()
+*  length is a multiple of 32.
+*/
+AVX2 static void
+CountAvx2(CharCounts *counts, const unsigned char *text, size_t length)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i block, tally[NUM_TALLIES], sums[NUM_TALLIES];
+	unsigned long long totals[NUM_TALLIES], lanes[4];
+	size_t i, stop;
+	int t;
+
+	for (t = 0; t < NUM_TALLIES; t++)
+		sums[t] = zero;
+
+	for (i = 0; i < length; i = stop)
+	{
+		stop = (length - i > 32 * COUNT_STEPS) ? i + 32 * COUNT_STEPS : length;
+		for (t = 0; t < NUM_TALLIES; t++)
+			tally[t] = zero;
+		for (; i < stop; i += 32)
+		{
+			block = _mm256_loadu_si256((const __m256i *)(text + i));
+			tally[0] = _mm256_sub_epi8(tally[0], RangeAvx2(block, 'A', 'Z'));
+			tally[1] = _mm256_sub_epi8(tally[1], RangeAvx2(block, 'a', 'z'));
+			tally[2] = _mm256_sub_epi8(tally[2], RangeAvx2(block, '0', '9'));
+			tally[3] = _mm256_sub_epi8(tally[3], _mm256_or_si256(
+				RangeAvx2(block, '\t', '\r'),
+				_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' '))));
+			tally[4] = _mm256_sub_epi8(tally[4], RangeAvx2(block, '!', '~'));
+			tally[5] = _mm256_sub_epi8(tally[5],
+				_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')));
+		}
+		for (t = 0; t < NUM_TALLIES; t++)
+			sums[t] = _mm256_add_epi64(sums[t],
+				_mm256_sad_epu8(tally[t], zero));
+	}
+
+	for (t = 0; t < NUM_TALLIES; t++)
+	{
+		_mm256_storeu_si256((__m256i *)lanes, sums[t]);
+		totals[t] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+	AddTallies(counts, totals);
+}
+
+/*
+*  Function: ReplaceSse2()
+*  length is a multiple of 16.
+*/
+SSE2 static size_t
+ReplaceSse2(unsigned char *text, size_t length, unsigned char from,
+	unsigned char to)
+{
+	const __m128i find = _mm_set1_epi8((char)from);
+	const __m128i put = _mm_set1_epi8((char)to);
+	__m128i block, same;
+	size_t replaced = 0, i;
+	unsigned int mask;
+
+	for (i = 0; i < length; i += 16)
+	{
+		block = _mm_loadu_si128((const __m128i *)(text + i));
+		same = _mm_cmpeq_epi8(block, find);
+		mask = (unsigned int)_mm_movemask_epi8(same);
+		if (mask == 0)
+			continue;
+		replaced += BIT_COUNT(mask);
+		block = _mm_or_si128(_mm_and_si128(same, put),
+			_mm_andnot_si128(same, block));
+		_mm_storeu_si128((__m128i *)(text + i), block);
+	}
+	return (replaced);
+}
+
+/*
+*  Function: ReplaceAvx2()
+*  length is a multiple of 32.  Blocks without the character are not
+*  written back.
+*/
+AVX2 static size_t
+ReplaceAvx2(unsigned char *text, size_t length, unsigned char from,
+	unsigned char to)
+{
+	const __m256i find = _mm256_set1_epi8((char)from);
+	const __m256i put = _mm256_set1_epi8((char)to);
+	__m256i block, same;
+	size_t replaced = 0, i;
+	unsigned int mask;
+
+	for (i = 0; i < length; i += 32)
+	{
+		block = _mm256_loadu_si256((const __m256i *)(text + i));
+		same = _mm256_cmpeq_epi8(block, find);
+		mask = (unsigned int)_mm256_movemask_epi8(same);
+		if (mask == 0)
+			continue;
+		replaced += BIT_COUNT(mask);
+		_mm256_storeu_si256((__m256i *)(text + i),
+			_mm256_blendv_epi8(block, put, same));
+	}
+	return (replaced);
+}
+
+#endif
@@ -0,0 +1,63 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for ASCII case conversion, character classes and
+*  character replacement over whole blocks of text, 32 bytes a step.
+*  These replace loops of toupper(), isupper() and the like, which make a
+*  call (and a locale lookup) per character.
+*
+*	CharToUpper/Lower()	Converts the case of a to z (A to Z).
+*	CharClassify()		A byte of CHAR_... bits for each character.
+*	CharCountClasses()	Adds up how many characters are in each
+*				class, and the lines.
+*	CharReplace()		Replaces every one of a character with
+*				another and says how many there were.
+*
+*  Classes are those of the "C" locale: upper and lower are A to Z and
+*  a to z, digits 0 to 9, spaces ' ' and \t \n \v \f \r, and punctuation
+*  the other printable characters but the space.  Bytes of 128 and up are
+*  in no class and are never changed by the case conversions.
+*
+*  The kernel is chosen from what the CPU supports, as in simd_search.c:
+*  AVX2, SSE2, or plain C on other machines, which is also used for the
+*  last few bytes of a block.  dest may be src, but must not otherwise
+*  overlap it.
+*  Compile with char_class.c and simd_search.c.
+*/
+
+#ifndef _CHAR_CLASS_H_
+#define _CHAR_CLASS_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHAR_UPPER 0x01
+#define CHAR_LOWER 0x02
+#define CHAR_DIGIT 0x04
+#define CHAR_SPACE 0x08
+#define CHAR_PUNCT 0x10
+#define CHAR_ALPHA (CHAR_UPPER | CHAR_LOWER)
+
+typedef struct char_counts {
+	unsigned long long upper;
+	unsigned long long lower;
+	unsigned long long digit;
+	unsigned long long space;
+	unsigned long long punct;
+	unsigned long long lines;	/* Number of '\n' */
+} CharCounts;
+
+/* Function Prototypes */
+void CharToUpper(char *dest, const char *src, size_t length);
+void CharToLower(char *dest, const char *src, size_t length);
+void CharClassify(unsigned char classes[], const char *text, size_t length);
+void CharCountClasses(CharCounts *counts, const char *text, size_t length);
+size_t CharReplace(char *text, size_t length, char from, char to);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
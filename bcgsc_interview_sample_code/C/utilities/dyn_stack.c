@@ -0,0 +1,218 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: A generic stack kept in one contiguous, geometrically growing
+*  block of memory.  See dyn_stack.h for the interface.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "dyn_stack.h"
+
+/* Function Prototypes (local) */
+static int GrowFor(DynStack *stack, size_t needed);
+
+/*
+*  Function: DynStackInit()
+*  Sets up an empty stack for items of item_size bytes.  No memory is
+*  allocated until the first push (or reserve).
+*/
+void
+DynStackInit(DynStack *stack, size_t item_size)
+{
+	stack->data = NULL;
+	stack->item_size = item_size;
+	stack->size = 0;
+	stack->capacity = 0;
+}
+
+/*
+*  Function: DynStackFree()
+*  Releases the block.  The stack is left empty and may be reused.
+*/
+void
+DynStackFree(DynStack *stack)
+{
+	free(stack->data);
+	stack->data = NULL;
+	stack->size = 0;
+	stack->capacity = 0;
+}
+
+/*
+*  Function: DynStackReserve()
+*  Makes sure the block can hold at least 'capacity' items without
+*  growing again.  Returns 1 on success, 0 if memory ran out (the stack
+*  is unchanged in that case).
+*/
+int
+DynStackReserve(DynStack *stack, size_t capacity)
+{
+	char *temp;
+
+	if (capacity <= stack->capacity)
+		return (1);
+
+	if (stack->item_size != 0 && capacity > (size_t)-1 / stack->item_size)
+		return (0);
+
+	temp = (char *)realloc(stack->data, capacity * stack->item_size);
+	if (temp == NULL)
+		return (0);
+
+	stack->data = temp;
+	stack->capacity = capacity;
+	return (1);
+}
+
+/*
+*  Function: GrowFor()
+*  Doubles the capacity until 'needed' more items will fit.
+*/
+static int
+GrowFor(DynStack *stack, size_t needed)
+{
+	size_t capacity;
+
+	if (stack->size + needed < stack->size)
+		return (0);	/* overflow */
+
+	if (stack->size + needed <= stack->capacity)
+		return (1);
+
+	capacity = stack->capacity ? stack->capacity : DYN_STACK_MIN_CAPACITY;
+	while (capacity < stack->size + needed)
+	{
+		if (capacity > (size_t)-1 / 2)
+		{
+			capacity = stack->size + needed;
+			break;
+		}
+		capacity *= 2;
+	}
+
+	return (DynStackReserve(stack, capacity));
+}
+
+/*
+*  Function: DynStackPush()
+*  Copies one item onto the top of the stack.  Returns 0 if memory ran out.
+*/
+int
+DynStackPush(DynStack *stack, const void *item)
+{
+	if (!GrowFor(stack, 1))
+		return (0);
+
+	memcpy(stack->data + stack->size * stack->item_size, item,
+		stack->item_size);
+	stack->size++;
+	return (1);
+}
+
+/*
+*  Function: DynStackPushBulk()
+*  Pushes 'count' items in one copy.  items[0] goes on first, so
+*  items[count - 1] ends up on top.  Returns 0 if memory ran out.
+*/
+int
+DynStackPushBulk(DynStack *stack, const void *items, size_t count)
+{
+	if (count == 0)
+		return (1);
+
+	if (!GrowFor(stack, count))
+		return (0);
+
+	memcpy(stack->data + stack->size * stack->item_size, items,
+		count * stack->item_size);
+	stack->size += count;
+	return (1);
+}
+
+/*
+*  Function: DynStackPop()
+*  Copies the top item into 'item' (if it is not NULL) and removes it.
+*  Returns 0 if the stack was already empty.
+*/
+int
+DynStackPop(DynStack *stack, void *item)
+{
+	if (DynStackIsEmpty(stack))
+		return (0);
+
+	stack->size--;
+	if (item != NULL)
+		memcpy(item, stack->data + stack->size * stack->item_size,
+			stack->item_size);
+	return (1);
+}
+
+/*
+*  Function: DynStackPopBulk()
+*  Pops up to 'count' items.  They are written to 'items' in the order
+*  they come off the stack, so items[0] is the old top.  Returns the
+*  number of items actually popped.
+*/
+size_t
+DynStackPopBulk(DynStack *stack, void *items, size_t count)
+{
+	size_t i;
+	char *dest = (char *)items;
+	char *src;
+
+	if (count > stack->size)
+		count = stack->size;
+
+	src = stack->data + (stack->size - 1) * stack->item_size;
+	for (i = 0; i < count; i++)
+	{
+		memcpy(dest, src, stack->item_size);
+		dest += stack->item_size;
+		src -= stack->item_size;
+	}
+
+	stack->size -= count;
+	return (count);
+}
+
+/*
+*  Function: DynStackTop()
+*  Returns a pointer to the top item, or NULL if the stack is empty.  The
+*  pointer is only good until the next push.
+*/
+void *
+DynStackTop(const DynStack *stack)
+{
+	if (DynStackIsEmpty(stack))
+		return (NULL);
+
+	return (stack->data + (stack->size - 1) * stack->item_size);
+}
+
+/*
+*  Function: DynStackIsEmpty()
+*/
+int
+DynStackIsEmpty(const DynStack *stack)
+{
+	return (stack->size == 0);
+}
+
+/*
+*  Function: DynStackSize()
+*/
+size_t
+DynStackSize(const DynStack *stack)
+{
+	return (stack->size);
+}
+
+/*
+*  Function: DynStackClear()
+*  Empties the stack but keeps the block for reuse.
+*/
+void
+DynStackClear(DynStack *stack)
+{
+	stack->size = 0;
+}
@@ -0,0 +1,45 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for a generic stack held in one contiguous block of
+*  memory.  The block doubles in size whenever it fills up, so a push is
+*  amortised O(1) and there is no per-item malloc() as there is with the
+*  linked node stacks in complete_stack.c and reverse_string.c.  Items of
+*  any type can be stored, the item size is given when the stack is made.
+*/
+
+#ifndef _DYN_STACK_H_
+#define _DYN_STACK_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DYN_STACK_MIN_CAPACITY 16
+
+typedef struct dyn_stack {
+	char *data;		/* Block holding the items, bottom item first */
+	size_t item_size;	/* Size of one item in bytes */
+	size_t size;		/* Number of items currently on the stack */
+	size_t capacity;	/* Number of items the block can hold */
+} DynStack;
+
+/* Function Prototypes */
+void DynStackInit(DynStack *stack, size_t item_size);
+void DynStackFree(DynStack *stack);
+int DynStackReserve(DynStack *stack, size_t capacity);
+int DynStackPush(DynStack *stack, const void *item);
+int DynStackPushBulk(DynStack *stack, const void *items, size_t count);
+int DynStackPop(DynStack *stack, void *item);
+size_t DynStackPopBulk(DynStack *stack, void *items, size_t count);
+void *DynStackTop(const DynStack *stack);
+int DynStackIsEmpty(const DynStack *stack);
+size_t DynStackSize(const DynStack *stack);
+void DynStackClear(DynStack *stack);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,702 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: External merge sort of text lines.  See ext_sort.h for the
+*  interface.
+*
+*  Memory is split between two run buffers, so one run can be sorted and
+*  written out by the thread pool while the next is read in.  Each run
+*  buffer holds the text of its lines back to back, and an array of
+*  pointers to them which is what actually gets sorted.
+*
+*  The runs are written one after another into a single temporary file,
+*  with the offset where each ends.  A merge pass reads its runs from
+*  that file with pread(), through a buffer of its own for each run, and
+*  writes the merged runs into the next file in the same way.  So at most
+*  two temporary files are open at a time, however big the input, and
+*  the run buffers, or the merge buffers, are all the memory used.
+*/
+
+#define _POSIX_C_SOURCE 200809L	/* getline(), mkstemp(), pread() */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "dyn_stack.h"
+#include "thread_pool.h"
+#include "sort_lib.h"
+#include "ext_sort.h"
+
+#define IO_BUFFER_MIN (64 * 1024)
+#define IO_BUFFER_MAX (4 * 1024 * 1024)
+
+typedef struct line_order {
+	LineCompare compare;
+	void *arg;
+} LineOrder;
+
+typedef struct line_reader {
+	FILE *in;
+	char *line;		/* Last line read, not yet stored in a run */
+	size_t capacity;
+	size_t length;
+	int have_line;
+	int at_end;
+	int failed;
+} LineReader;
+
+typedef struct spill_file {
+	FILE *file;
+	char *buffer;		/* Our stdio buffer, bigger than the default */
+	DynStack ends;		/* off_t: where each run in the file ends */
+} SpillFile;
+
+typedef struct run_buffer {
+	char *text;		/* The lines, each ending in '\0' */
+	size_t text_size;
+	size_t text_used;
+	char **lines;		/* Where each line starts in text */
+	size_t max_lines;
+	size_t num_lines;
+	FILE *spill;		/* Where SpillRun() writes the sorted run */
+	off_t end;		/* Set by SpillRun(): where the run ended */
+	const LineOrder *order;
+	int failed;		/* Set by SpillRun() on a write error */
+	TaskGroup group;	/* The SpillRun() task using this buffer */
+} RunBuffer;
+
+typedef struct merge_source {
+	int fd;			/* The spill file, read with pread() */
+	off_t next;		/* Offset of the next read */
+	off_t end;		/* Where this run ends in the file */
+	char *buffer;		/* Read ahead, io_size bytes */
+	size_t buffer_used;
+	size_t buffer_pos;
+	char *line;		/* This run's smallest line not yet written */
+	size_t capacity;
+	int done;
+	int failed;
+} MergeSource;
+
+typedef struct merge {
+	MergeSource *sources;
+	int *tree;		/* tree[n] is the loser of the game at node n */
+	int count;
+	const LineOrder *order;
+} Merge;
+
+/* Function Prototypes (local) */
+static int InitRun(RunBuffer *run, size_t budget, const LineOrder *order);
+static void FreeRun(RunBuffer *run);
+static long FillRun(RunBuffer *run, LineReader *reader);
+static int CompareLinePtrs(const void *a, const void *b, void *arg);
+static int WriteLines(char **lines, size_t count, FILE *out);
+static void SpillRun(void *arg);
+static int NewSpill(SpillFile *spill, const char *temp_dir, size_t io_size);
+static int EndRun(SpillFile *spill);
+static void CloseSpill(SpillFile *spill);
+static int MergeRuns(const SpillFile *from, size_t first, int count,
+	FILE *out, size_t io_size, const LineOrder *order);
+static void NextLine(MergeSource *source, size_t io_size);
+static int AppendLine(MergeSource *source, size_t *length, const char *text,
+	size_t count);
+static int Beats(const Merge *merge, int a, int b);
+static int InitTree(Merge *merge, int node);
+static int Replay(Merge *merge, int winner);
+
+/*
+*  Function: ExtSortDefaults()
+*/
+void
+ExtSortDefaults(ExtSortOptions *opts)
+{
+	opts->memory = EXT_SORT_DEFAULT_MEMORY;
+	opts->temp_dir = NULL;
+	opts->max_fan_in = EXT_SORT_DEFAULT_FAN_IN;
+}
+
+/*
+*  Function: ExtSortLines()
+*  Sorts the lines of in onto out.  opts may be NULL for the defaults.
+*  Returns 1, or 0 on a read, write or memory error with errno set.
+*/
+int
+ExtSortLines(FILE *in, FILE *out, LineCompare compare, void *arg,
+	const ExtSortOptions *opts)
+{
+	ExtSortOptions defaults;
+	LineOrder order;
+	LineReader reader;
+	RunBuffer runs[2];
+	SpillFile level, next;
+	ThreadPool *pool;
+	size_t memory, io_size, num_runs, first;
+	int fan_in, count, cur, ok = 1;
+
+	if (opts == NULL)
+	{
+		ExtSortDefaults(&defaults);
+		opts = &defaults;
+	}
+
+	memory = opts->memory < EXT_SORT_MIN_MEMORY ? EXT_SORT_MIN_MEMORY :
+		opts->memory;
+	fan_in = opts->max_fan_in < 2 ? 2 : opts->max_fan_in;
+
+	/* A merge gives each of its runs a read buffer, and the two spill
+	*  files a stdio buffer each, all out of the memory budget; merge
+	*  fewer runs at a time rather than make the buffers tiny */
+	if (memory / IO_BUFFER_MIN < (size_t)fan_in + 2)
+		fan_in = memory / IO_BUFFER_MIN >= 4 ?
+			(int)(memory / IO_BUFFER_MIN - 2) : 2;
+	io_size = memory / (fan_in + 2);
+	if (io_size > IO_BUFFER_MAX)
+		io_size = IO_BUFFER_MAX;
+
+	order.compare = compare;
+	order.arg = arg;
+
+	memset(&reader, 0, sizeof(reader));
+	reader.in = in;
+
+	/* The spill file's buffer comes out of the budget too */
+	if (!InitRun(&runs[0], (memory - io_size) / 2, &order) ||
+		!InitRun(&runs[1], (memory - io_size) / 2, &order))
+	{
+		FreeRun(&runs[0]);
+		FreeRun(&runs[1]);
+		errno = ENOMEM;
+		return (0);
+	}
+
+	pool = PoolDefault();
+	level.file = NULL;
+	level.buffer = NULL;
+	DynStackInit(&level.ends, sizeof(off_t));
+
+	if (FillRun(&runs[0], &reader) < 0)
+		ok = 0;
+	else if (reader.at_end)
+	{
+		/* It all fitted, so no temporary files are needed */
+		SortIntroArg(runs[0].lines, runs[0].num_lines, sizeof(char *),
+			CompareLinePtrs, &order);
+		ok = WriteLines(runs[0].lines, runs[0].num_lines, out);
+	}
+	else if (!NewSpill(&level, opts->temp_dir, io_size))
+		ok = 0;
+	else
+	{
+		/* Sort and spill one run on the pool while reading the next.
+		*  The runs share one file, so each spill is finished before
+		*  the next one starts. */
+		cur = 0;
+		while (ok && runs[cur].num_lines > 0)
+		{
+			runs[cur].spill = level.file;
+			PoolSpawn(pool, &runs[cur].group, SpillRun, &runs[cur]);
+
+			cur ^= 1;
+			if (FillRun(&runs[cur], &reader) < 0)
+				ok = 0;
+
+			PoolJoin(pool, &runs[cur ^ 1].group);
+			if (runs[cur ^ 1].failed ||
+				!DynStackPush(&level.ends, &runs[cur ^ 1].end))
+				ok = 0;
+		}
+	}
+
+	FreeRun(&runs[0]);
+	FreeRun(&runs[1]);
+	free(reader.line);
+
+	/* Merge fan_in runs at a time into the next file until one pass
+	*  will do */
+	num_runs = DynStackSize(&level.ends);
+	while (ok && num_runs > (size_t)fan_in)
+	{
+		if (!NewSpill(&next, opts->temp_dir, io_size))
+		{
+			ok = 0;
+			break;
+		}
+
+		for (first = 0; ok && first < num_runs; first += count)
+		{
+			count = num_runs - first < (size_t)fan_in ?
+				(int)(num_runs - first) : fan_in;
+			ok = MergeRuns(&level, first, count, next.file, io_size,
+				&order) && EndRun(&next);
+		}
+
+		CloseSpill(&level);
+		level = next;
+		num_runs = DynStackSize(&level.ends);
+	}
+
+	if (ok && num_runs > 0)
+		ok = MergeRuns(&level, 0, (int)num_runs, out, io_size, &order);
+	CloseSpill(&level);
+
+	if (ok && fflush(out) != 0)
+		ok = 0;
+	return (ok);
+}
+
+/*
+*  Function: InitRun()
+*  A quarter of the budget goes to line pointers, the rest to text.
+*/
+static int
+InitRun(RunBuffer *run, size_t budget, const LineOrder *order)
+{
+	run->max_lines = budget / 4 / sizeof(char *);
+	run->text_size = budget - run->max_lines * sizeof(char *);
+	run->text = (char *)malloc(run->text_size);
+	run->lines = (char **)malloc(run->max_lines * sizeof(char *));
+	run->text_used = 0;
+	run->num_lines = 0;
+	run->spill = NULL;
+	run->end = 0;
+	run->order = order;
+	run->failed = 0;
+	TaskGroupInit(&run->group);
+
+	return (run->text != NULL && run->lines != NULL);
+}
+
+/*
+*  Function: FreeRun()
+*/
+static void
+FreeRun(RunBuffer *run)
+{
+	free(run->text);
+	free(run->lines);
+	run->text = NULL;
+	run->lines = NULL;
+}
+
+/*
+*  Function: FillRun()
+*  Reads lines into run until it is full or the input ends.  A line that
+*  does not fit is kept by the reader for the next run.  Returns the
+*  number of lines in the run, or -1 on a read or memory error.
+*/
+static long
+FillRun(RunBuffer *run, LineReader *reader)
+{
+	ssize_t length;
+	size_t need;
+	char *bigger;
+
+	run->text_used = 0;
+	run->num_lines = 0;
+
+	while (!reader->at_end)
+	{
+		if (!reader->have_line)
+		{
+			errno = 0;
+			length = getline(&reader->line, &reader->capacity, reader->in);
+			if (length < 0)
+			{
+				reader->at_end = 1;
+				if (ferror(reader->in) || errno == ENOMEM)
+				{
+					reader->failed = 1;
+					return (-1);
+				}
+				break;
+			}
+			if (length > 0 && reader->line[length - 1] == '\n')
+				reader->line[--length] = '\0';
+			reader->length = length;
+			reader->have_line = 1;
+		}
+
+		need = reader->length + 1;
+		if (run->num_lines == run->max_lines)
+			break;
+		if (run->text_used + need > run->text_size)
+		{
+			if (run->num_lines > 0)
+				break;
+
+			/* One line bigger than the whole run, make room for it */
+			bigger = (char *)realloc(run->text, need);
+			if (bigger == NULL)
+			{
+				errno = ENOMEM;
+				return (-1);
+			}
+			run->text = bigger;
+			run->text_size = need;
+		}
+
+		memcpy(run->text + run->text_used, reader->line, need);
+		run->lines[run->num_lines++] = run->text + run->text_used;
+		run->text_used += need;
+		reader->have_line = 0;
+	}
+
+	return ((long)run->num_lines);
+}
+
+/*
+*  Function: CompareLinePtrs()
+*/
+static int
+CompareLinePtrs(const void *a, const void *b, void *arg)
+{
+	const LineOrder *order = (const LineOrder *)arg;
+
+	return (order->compare(*(char *const *)a, *(char *const *)b,
+		order->arg));
+}
+
+/*
+*  Function: WriteLines()
+*  Returns 0 on a write error.
+*/
+static int
+WriteLines(char **lines, size_t count, FILE *out)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		fputs(lines[i], out);
+		putc('\n', out);
+	}
+	return (!ferror(out));
+}
+
+/*
+*  Function: SpillRun()
+*  Pool task: sorts one run and writes it to the end of the spill file.
+*/
+static void
+SpillRun(void *arg)
+{
+	RunBuffer *run = (RunBuffer *)arg;
+
+	SortIntroArg(run->lines, run->num_lines, sizeof(char *),
+		CompareLinePtrs, (void *)run->order);
+
+	if (!WriteLines(run->lines, run->num_lines, run->spill) ||
+		fflush(run->spill) != 0 || (run->end = ftello(run->spill)) < 0)
+		run->failed = 1;
+}
+
+/*
+*  Function: NewSpill()
+*  Opens a temporary file for reading and writing.  Its name is removed
+*  at once, so the space is given back when it is closed, even if the
+*  program dies first.  Returns 0 on failure.
+*/
+static int
+NewSpill(SpillFile *spill, const char *temp_dir, size_t io_size)
+{
+	static const char pattern[] = "/ext_sort_XXXXXX";
+	char *path;
+	int fd;
+
+	spill->file = NULL;
+	spill->buffer = NULL;
+	DynStackInit(&spill->ends, sizeof(off_t));
+
+	if (temp_dir == NULL)
+		temp_dir = getenv("TMPDIR");
+	if (temp_dir == NULL || *temp_dir == '\0')
+		temp_dir = "/tmp";
+
+	path = (char *)malloc(strlen(temp_dir) + sizeof(pattern));
+	if (path == NULL)
+		return (0);
+	strcpy(path, temp_dir);
+	strcat(path, pattern);
+
+	fd = mkstemp(path);
+	if (fd >= 0)
+		unlink(path);
+	free(path);
+	if (fd < 0)
+		return (0);
+
+	spill->file = fdopen(fd, "w+");
+	if (spill->file == NULL)
+	{
+		close(fd);
+		return (0);
+	}
+
+	spill->buffer = (char *)malloc(io_size);
+	if (spill->buffer != NULL)
+		setvbuf(spill->file, spill->buffer, _IOFBF, io_size);
+	return (1);
+}
+
+/*
+*  Function: EndRun()
+*  Notes that a run has been written up to where the file now ends.
+*  Returns 0 on a write or memory error.
+*/
+static int
+EndRun(SpillFile *spill)
+{
+	off_t end;
+
+	if (fflush(spill->file) != 0 || (end = ftello(spill->file)) < 0)
+		return (0);
+	return (DynStackPush(&spill->ends, &end));
+}
+
+/*
+*  Function: CloseSpill()
+*/
+static void
+CloseSpill(SpillFile *spill)
+{
+	if (spill->file != NULL)
+		fclose(spill->file);
+	free(spill->buffer);
+	DynStackFree(&spill->ends);
+	spill->file = NULL;
+	spill->buffer = NULL;
+}
+
+
+/* *** k-way merge *** */
+
+/*
+*  Function: MergeRuns()
+*  Merges count sorted runs of from, starting at run first, onto out
+*  with a loser tree: each internal node remembers the loser of the game
+*  played there, so after the winner's run moves on only the games on
+*  its path to the root are replayed, log2(count) comparisons per line.
+*  Equal lines come out in run order.  Returns 0 on a read, write or
+*  memory error.
+*/
+static int
+MergeRuns(const SpillFile *from, size_t first, int count, FILE *out,
+	size_t io_size, const LineOrder *order)
+{
+	const off_t *ends = (const off_t *)from->ends.data;
+	Merge merge;
+	char *buffers;
+	int i, winner, ok = 1;
+
+	merge.sources = (MergeSource *)calloc(count, sizeof(MergeSource));
+	merge.tree = (int *)malloc(count * sizeof(int));
+	merge.count = count;
+	merge.order = order;
+	buffers = (char *)malloc(count * io_size);
+
+	if (merge.sources == NULL || merge.tree == NULL || buffers == NULL)
+	{
+		free(merge.sources);
+		free(merge.tree);
+		free(buffers);
+		errno = ENOMEM;
+		return (0);
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		merge.sources[i].fd = fileno(from->file);
+		merge.sources[i].next = (first + i == 0) ? 0 :
+			ends[first + i - 1];
+		merge.sources[i].end = ends[first + i];
+		merge.sources[i].buffer = buffers + i * io_size;
+		NextLine(&merge.sources[i], io_size);
+	}
+
+	winner = InitTree(&merge, 1);
+
+	while (!merge.sources[winner].done)
+	{
+		fputs(merge.sources[winner].line, out);
+		putc('\n', out);
+
+		NextLine(&merge.sources[winner], io_size);
+		winner = Replay(&merge, winner);
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		if (merge.sources[i].failed)
+			ok = 0;
+		free(merge.sources[i].line);
+	}
+	if (ferror(out))
+		ok = 0;
+
+	free(merge.sources);
+	free(merge.tree);
+	free(buffers);
+	return (ok);
+}
+
+/*
+*  Function: NextLine()
+*  Moves source on to the next line of its run, reading the run a
+*  buffer at a time.  A line may be longer than the buffer.
+*/
+static void
+NextLine(MergeSource *source, size_t io_size)
+{
+	size_t length = 0, count;
+	ssize_t got;
+	char *newline;
+
+	for (;;)
+	{
+		if (source->buffer_pos == source->buffer_used)
+		{
+			count = io_size;
+			if ((off_t)count > source->end - source->next)
+				count = (size_t)(source->end - source->next);
+			if (count == 0)
+			{
+				/* Every run ends in a newline */
+				source->done = 1;
+				if (length > 0)
+					source->failed = 1;
+				return;
+			}
+
+			got = pread(source->fd, source->buffer, count,
+				source->next);
+			if (got <= 0)
+			{
+				source->done = 1;
+				source->failed = 1;
+				return;
+			}
+			source->next += got;
+			source->buffer_used = (size_t)got;
+			source->buffer_pos = 0;
+		}
+
+		count = source->buffer_used - source->buffer_pos;
+		newline = (char *)memchr(source->buffer + source->buffer_pos,
+			'\n', count);
+		if (newline != NULL)
+			count = newline - (source->buffer + source->buffer_pos);
+
+		if (!AppendLine(source, &length,
+			source->buffer + source->buffer_pos, count))
+		{
+			source->done = 1;
+			source->failed = 1;
+			errno = ENOMEM;
+			return;
+		}
+		source->buffer_pos += count;
+
+		if (newline != NULL)
+		{
+			source->buffer_pos++;
+			return;
+		}
+	}
+}
+
+/*
+*  Function: AppendLine()
+*  Adds count bytes of text to the length already in source->line and
+*  keeps it '\0' ended.  Returns 0 if memory ran out.
+*/
+static int
+AppendLine(MergeSource *source, size_t *length, const char *text,
+	size_t count)
+{
+	size_t need = *length + count + 1;
+	char *bigger;
+
+	if (need > source->capacity)
+	{
+		if (need < 2 * source->capacity)
+			need = 2 * source->capacity;
+		bigger = (char *)realloc(source->line, need);
+		if (bigger == NULL)
+			return (0);
+		source->line = bigger;
+		source->capacity = need;
+	}
+
+	memcpy(source->line + *length, text, count);
+	*length += count;
+	source->line[*length] = '\0';
+	return (1);
+}
+
+/*
+*  Function: Beats()
+*  True if run a's line should be written before run b's.  A finished
+*  run loses to everything.
+*/
+static int
+Beats(const Merge *merge, int a, int b)
+{
+	int result;
+
+	if (merge->sources[a].done)
+		return (0);
+	if (merge->sources[b].done)
+		return (1);
+
+	result = merge->order->compare(merge->sources[a].line,
+		merge->sources[b].line, merge->order->arg);
+	return (result < 0 || (result == 0 && a < b));
+}
+
+/*
+*  Function: InitTree()
+*  Plays the games below node and returns the winner.  Nodes 1 to
+*  count - 1 are games, nodes count to 2 * count - 1 are the runs.
+*/
+static int
+InitTree(Merge *merge, int node)
+{
+	int left, right;
+
+	if (node >= merge->count)
+		return (node - merge->count);
+
+	left = InitTree(merge, 2 * node);
+	right = InitTree(merge, 2 * node + 1);
+
+	if (Beats(merge, left, right))
+	{
+		merge->tree[node] = right;
+		return (left);
+	}
+	merge->tree[node] = left;
+	return (right);
+}
+
+/*
+*  Function: Replay()
+*  The winner's run has a new line, play it up to the root.
+*/
+static int
+Replay(Merge *merge, int winner)
+{
+	int node, loser;
+
+	for (node = (winner + merge->count) / 2; node >= 1; node /= 2)
+	{
+		if (Beats(merge, merge->tree[node], winner))
+		{
+			loser = winner;
+			winner = merge->tree[node];
+			merge->tree[node] = loser;
+		}
+	}
+	return (winner);
+}
@@ -0,0 +1,52 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for an external merge sort of text lines, for files
+*  too big to read into memory.  The input is read in runs that fit in a
+*  fixed memory budget.  Each run is sorted (in parallel, by SortIntroArg()
+*  in sort_lib.c) and spilled to a temporary file while the next run is
+*  being read.  The runs are then merged through a loser tree, up to
+*  max_fan_in runs at a time, with large buffered reads and writes.
+*  Input that fits in one run never touches the disk.  However big the
+*  input, no more than two temporary files are open at once, and the
+*  memory used stays within the budget (bar the longest line); a budget
+*  too small for max_fan_in read buffers merges fewer runs at a time.
+*
+*  Lines are compared without their newline.  Every output line ends in
+*  one, even if the last input line did not.  Not stable.
+*  Compile with ext_sort.c, sort_lib.c, dyn_stack.c, thread_pool.c and
+*  work_deque.c, -pthread.
+*/
+
+#ifndef _EXT_SORT_H_
+#define _EXT_SORT_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EXT_SORT_DEFAULT_MEMORY (64 * 1024 * 1024)
+#define EXT_SORT_MIN_MEMORY (64 * 1024)
+#define EXT_SORT_DEFAULT_FAN_IN 64
+
+/* Returns < 0, 0 or > 0 as line a sorts before, with or after line b */
+typedef int (*LineCompare)(const char *a, const char *b, void *arg);
+
+typedef struct ext_sort_options {
+	size_t memory;		/* Bytes of lines held at once */
+	const char *temp_dir;	/* NULL for $TMPDIR, or /tmp */
+	int max_fan_in;		/* Runs merged in one pass, at least 2 */
+} ExtSortOptions;
+
+/* Function Prototypes */
+void ExtSortDefaults(ExtSortOptions *opts);
+int ExtSortLines(FILE *in, FILE *out, LineCompare compare, void *arg,
+	const ExtSortOptions *opts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
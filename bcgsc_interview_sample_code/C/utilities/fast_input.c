@@ -0,0 +1,467 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Fast input.  See fast_input.h for the interface.
+*
+*  In block mode the text not yet handed out is always at next..end of
+*  the buffer.  When a line or a word runs off the end of what has been
+*  read, Refill() moves it to the front of the buffer and reads in
+*  behind it (doubling the buffer if it is full), so everything handed
+*  out is in one piece.  A mapped file is one piece from the start.
+*/
+
+#define _POSIX_C_SOURCE 200809L	/* fileno(), mmap() */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "fast_input.h"
+
+#define IS_BLANK(c) ((c) == ' ' || ((c) >= '\t' && (c) <= '\r'))
+#define IS_DIGIT(c) ((unsigned char)((c) - '0') < 10)
+
+#define EXACT_DIGITS 19		/* Significant digits a uint64 always holds */
+#define EXACT_POWER 22		/* Largest power of ten a double holds exactly */
+#define EXACT_MANTISSA (1ULL << 53)
+#define EXPONENT_MAX 100000	/* Beyond this a double is 0 or infinite */
+#define NUMBER_COPY 64		/* Numbers up to this long go to strtod()
+				   from the stack */
+
+static const double powers[EXACT_POWER + 1] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Function Prototypes (local) */
+static int Refill(FastInput *input);
+static int SkipBlanks(FastInput *input);
+static size_t WordLength(FastInput *input);
+static const char *SlowDouble(const char *first, const char *last,
+	double *value);
+
+/*
+*  Function: FastInputOpen()
+*  Reads in from where it is.  Returns 1, or 0 if memory ran out.
+*/
+int
+FastInputOpen(FastInput *input, FILE *in)
+{
+	struct stat info;
+	void *mapped;
+
+	memset(input, 0, sizeof(FastInput));
+	input->in = in;
+
+	if (ftell(in) == 0 && fstat(fileno(in), &info) == 0 &&
+		S_ISREG(info.st_mode) && info.st_size > 0 &&
+		(unsigned long long)info.st_size <= (size_t)-1)
+	{
+		mapped = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE,
+			fileno(in), 0);
+		if (mapped != MAP_FAILED)
+		{
+			posix_madvise(mapped, (size_t)info.st_size,
+				POSIX_MADV_SEQUENTIAL);
+			input->map = (char *)mapped;
+			input->map_length = (size_t)info.st_size;
+			input->next = input->map;
+			input->end = input->map + input->map_length;
+			input->at_end = 1;
+			return (1);
+		}
+	}
+
+	input->buffer = (char *)malloc(FAST_BLOCK);
+	if (input->buffer == NULL)
+		return (0);
+	input->capacity = FAST_BLOCK;
+	input->next = input->end = input->buffer;
+	return (1);
+}
+
+/*
+*  Function: FastInputClose()
+*  Frees the buffer or the mapping; in itself is left to the caller.
+*/
+void
+FastInputClose(FastInput *input)
+{
+	if (input->map != NULL)
+		munmap(input->map, input->map_length);
+	free(input->buffer);
+	input->map = NULL;
+	input->buffer = NULL;
+	input->next = input->end = NULL;
+}
+
+/*
+*  Function: FastInputMapped()
+*  Nonzero if the whole file is in memory, so the first
+*  FastInputBlock() hands all of it over.
+*/
+int
+FastInputMapped(const FastInput *input)
+{
+	return (input->map != NULL);
+}
+
+/*
+*  Function: FastInputError()
+*  Nonzero if a read failed or memory ran out.
+*/
+int
+FastInputError(const FastInput *input)
+{
+	return (input->error);
+}
+
+/*
+*  Function: FastInputBlock()
+*  Sets data to the next run of text and returns its length, 0 at the
+*  end of the input.
+*/
+size_t
+FastInputBlock(FastInput *input, const char **data)
+{
+	size_t length;
+
+	if (input->next == input->end && !Refill(input))
+		return (0);
+
+	*data = input->next;
+	length = input->end - input->next;
+	input->next = input->end;
+	return (length);
+}
+
+/*
+*  Function: FastInputLine()
+*/
+int
+FastInputLine(FastInput *input, const char **line, size_t *length)
+{
+	const char *stop;
+	size_t searched = 0, n;
+
+	for (;;)
+	{
+		stop = (const char *)memchr(input->next + searched, '\n',
+			(input->end - input->next) - searched);
+		if (stop != NULL)
+			break;
+		searched = input->end - input->next;
+		if (!Refill(input))
+			break;
+	}
+
+	if (stop == NULL)
+	{
+		if (input->next == input->end || input->error)
+			return (0);
+		stop = input->end;
+	}
+
+	*line = input->next;
+	n = stop - input->next;
+	input->next = (stop < input->end) ? stop + 1 : stop;
+	if (n > 0 && (*line)[n - 1] == '\r')
+		n--;
+	*length = n;
+	return (1);
+}
+
+/*
+*  Function: FastInputWord()
+*/
+int
+FastInputWord(FastInput *input, const char **word, size_t *length)
+{
+	size_t n;
+
+	if (!SkipBlanks(input))
+		return (0);
+
+	n = WordLength(input);
+	*word = input->next;
+	*length = n;
+	input->next += n;
+	return (1);
+}
+
+/*
+*  Function: FastInputLong()
+*  Like fscanf() "%ld": the rest of the word is left if it is not all
+*  part of the number.
+*/
+int
+FastInputLong(FastInput *input, long *value)
+{
+	const char *after;
+	size_t n;
+
+	if (!SkipBlanks(input))
+		return (0);
+
+	n = WordLength(input);	/* May move the buffer, so before next */
+	after = FastParseLong(input->next, input->next + n, value);
+	if (after == input->next)
+		return (0);
+	input->next = after;
+	return (1);
+}
+
+/*
+*  Function: FastInputDouble()
+*/
+int
+FastInputDouble(FastInput *input, double *value)
+{
+	const char *after;
+	size_t n;
+
+	if (!SkipBlanks(input))
+		return (0);
+
+	n = WordLength(input);
+	after = FastParseDouble(input->next, input->next + n, value);
+	if (after == input->next)
+		return (0);
+	input->next = after;
+	return (1);
+}
+
+/*
+*  Function: FastParseLong()
+*  A decimal integer with an optional sign.  Out of range values give
+*  LONG_MAX or LONG_MIN, as strtol() does.
+*/
+const char *
+FastParseLong(const char *first, const char *last, long *value)
+{
+	const char *p = first;
+	unsigned long total = 0, limit;
+	unsigned int digit;
+	int negative = 0, overflow = 0;
+
+	if (p < last && (*p == '+' || *p == '-'))
+		negative = (*p++ == '-');
+	if (p == last || !IS_DIGIT(*p))
+		return (first);
+
+	limit = negative ? (unsigned long)LONG_MAX + 1 : (unsigned long)LONG_MAX;
+	for (; p < last && IS_DIGIT(*p); p++)
+	{
+		digit = (unsigned int)(*p - '0');
+		if (total > (limit - digit) / 10)
+			overflow = 1;
+		else
+			total = total * 10 + digit;
+	}
+
+	if (overflow)
+		*value = negative ? LONG_MIN : LONG_MAX;
+	else if (negative && total > 0)
+		*value = -(long)(total - 1) - 1;
+	else
+		*value = (long)total;
+	return (p);
+}
+
+/*
+*  Function: FastParseDouble()
+*  A decimal number: optional sign, digits with an optional point, and
+*  an optional exponent.  When the digits fit in 53 bits and the power
+*  of ten is at most 22 both are exact doubles, so one multiply or
+*  divide gives the correctly rounded value.  Anything else (more
+*  digits, a big exponent, hex, inf, nan) is left to strtod().
+*/
+const char *
+FastParseDouble(const char *first, const char *last, double *value)
+{
+	const char *p = first, *q;
+	unsigned long long mantissa = 0;
+	int negative = 0, digits = 0, any = 0, dropped = 0;
+	long exponent = 0, power = 0;
+	int power_negative = 0;
+	double result;
+
+	if (p < last && (*p == '+' || *p == '-'))
+		negative = (*p++ == '-');
+	if (p + 1 < last && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+		return (SlowDouble(first, last, value));
+
+	for (; p < last && IS_DIGIT(*p); p++)
+	{
+		any = 1;
+		if (digits < EXACT_DIGITS)
+		{
+			mantissa = mantissa * 10 + (unsigned int)(*p - '0');
+			digits += (mantissa != 0);
+		}
+		else
+		{
+			exponent++;
+			dropped |= (*p != '0');
+		}
+	}
+	if (p < last && *p == '.')
+	{
+		for (p++; p < last && IS_DIGIT(*p); p++)
+		{
+			any = 1;
+			if (digits < EXACT_DIGITS)
+			{
+				mantissa = mantissa * 10 + (unsigned int)(*p - '0');
+				digits += (mantissa != 0);
+				exponent--;
+			}
+			else
+				dropped |= (*p != '0');
+		}
+	}
+	if (!any)
+		return (SlowDouble(first, last, value));
+
+	if (p < last && (*p == 'e' || *p == 'E'))
+	{
+		q = p + 1;
+		if (q < last && (*q == '+' || *q == '-'))
+			power_negative = (*q++ == '-');
+		if (q < last && IS_DIGIT(*q))
+		{
+			for (; q < last && IS_DIGIT(*q); q++)
+				if (power < EXPONENT_MAX)
+					power = power * 10 + (*q - '0');
+			exponent += power_negative ? -power : power;
+			p = q;
+		}
+	}
+
+	if (dropped || mantissa > EXACT_MANTISSA ||
+		exponent < -EXACT_POWER || exponent > EXACT_POWER)
+	{
+		/* Only the number itself is given to strtod() */
+		return (SlowDouble(first, p, value));
+	}
+
+	result = (double)mantissa;
+	if (exponent < 0)
+		result /= powers[-exponent];
+	else
+		result *= powers[exponent];
+	*value = negative ? -result : result;
+	return (p);
+}
+
+/*
+*  Function: Refill()
+*  Moves the text not handed out to the front of the buffer and reads
+*  more in behind it.  Returns 0 if there is no more.
+*/
+static int
+Refill(FastInput *input)
+{
+	size_t rest = input->end - input->next, got;
+	char *bigger;
+
+	if (input->at_end)
+		return (0);
+
+	if (rest == input->capacity)
+	{
+		bigger = (char *)realloc(input->buffer, 2 * input->capacity);
+		if (bigger == NULL)
+		{
+			input->error = 1;
+			input->at_end = 1;
+			return (0);
+		}
+		input->buffer = bigger;
+		input->capacity *= 2;
+		input->next = input->buffer;
+	}
+	else
+		memmove(input->buffer, input->next, rest);
+
+	got = fread(input->buffer + rest, 1, input->capacity - rest, input->in);
+	input->next = input->buffer;
+	input->end = input->buffer + rest + got;
+	if (got == 0)
+	{
+		input->at_end = 1;
+		input->error = ferror(input->in) != 0;
+		return (0);
+	}
+	return (1);
+}
+
+/*
+*  Function: SkipBlanks()
+*  Returns 1 with next at a character that is not blank, or 0 at the
+*  end of the input.
+*/
+static int
+SkipBlanks(FastInput *input)
+{
+	for (;;)
+	{
+		while (input->next < input->end && IS_BLANK(*input->next))
+			input->next++;
+		if (input->next < input->end)
+			return (1);
+		if (!Refill(input))
+			return (0);
+	}
+}
+
+/*
+*  Function: WordLength()
+*  Length of the word at next, reading until all of it is in memory.
+*/
+static size_t
+WordLength(FastInput *input)
+{
+	size_t n = 0;
+
+	for (;;)
+	{
+		while (input->next + n < input->end && !IS_BLANK(input->next[n]))
+			n++;
+		if (input->next + n < input->end || !Refill(input))
+			return (n);
+	}
+}
+
+/*
+*  Function: SlowDouble()
+*  strtod() on a '\0' ended copy of first..last (at most the first
+*  NUMBER_COPY - 1 characters of it if memory runs out).
+*/
+static const char *
+SlowDouble(const char *first, const char *last, double *value)
+{
+	char copy[NUMBER_COPY], *text = copy, *stop;
+	size_t length = last - first;
+	double result;
+
+	if (length >= NUMBER_COPY)
+	{
+		text = (char *)malloc(length + 1);
+		if (text == NULL)
+		{
+			text = copy;
+			length = NUMBER_COPY - 1;
+		}
+	}
+	memcpy(text, first, length);
+	text[length] = '\0';
+
+	result = strtod(text, &stop);
+	if (stop != text)
+		*value = result;
+	length = stop - text;
+	if (text != copy)
+		free(text);
+	return (first + length);
+}
@@ -0,0 +1,73 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for fast input, to take the place of fscanf() one
+*  character or one number at a time.  An ordinary file is mapped into
+*  memory whole; anything else (a pipe, a terminal, a file already part
+*  read) is read in 64 KB blocks.  Either way the text is handed out
+*  where it lies, with no copy:
+*
+*	FastInputBlock()	The next run of text, as it was read.
+*	FastInputLine()		The next line, without its "\n" or "\r\n";
+*				a last line with no line end counts.
+*	FastInputWord()		The next run of non-blank characters.
+*	FastInputLong/Double()	The next number, after any blanks, as
+*				fscanf() "%ld" and "%lf" would read it.
+*
+*  A pointer handed out stays good until the next call on the same
+*  input.  Each of these returns 0 at the end of the input (or, for the
+*  numbers, at text that is not a number); FastInputError() then says
+*  whether a read failed.
+*
+*  FastParseLong() and FastParseDouble() are the number parsers on their
+*  own, in the style of C++ std::from_chars(): they read from first and
+*  never past last, need no '\0', and return just past the number, or
+*  first if there is none there.  A double of up to 19 significant
+*  digits and a small exponent is computed exactly without strtod().
+*  Compile with fast_input.c.
+*/
+
+#ifndef _FAST_INPUT_H_
+#define _FAST_INPUT_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAST_BLOCK 65536	/* Read size when the file is not mapped */
+
+typedef struct fast_input {
+	FILE *in;
+	const char *next;	/* Text not yet handed out */
+	const char *end;	/* End of the text in memory */
+	char *buffer;		/* Blocks are read into here */
+	size_t capacity;	/* Size of buffer; grows for a long line */
+	char *map;		/* The whole file, if it was mapped */
+	size_t map_length;
+	int at_end;		/* Nothing more to read from in */
+	int error;		/* A read failed */
+} FastInput;
+
+/* Function Prototypes */
+int FastInputOpen(FastInput *input, FILE *in);
+void FastInputClose(FastInput *input);
+int FastInputMapped(const FastInput *input);
+int FastInputError(const FastInput *input);
+
+size_t FastInputBlock(FastInput *input, const char **data);
+int FastInputLine(FastInput *input, const char **line, size_t *length);
+int FastInputWord(FastInput *input, const char **word, size_t *length);
+int FastInputLong(FastInput *input, long *value);
+int FastInputDouble(FastInput *input, double *value);
+
+const char *FastParseLong(const char *first, const char *last, long *value);
+const char *FastParseDouble(const char *first, const char *last,
+	double *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
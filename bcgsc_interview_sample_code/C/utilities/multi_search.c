@@ -0,0 +1,486 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Aho-Corasick multi-pattern search.  See multi_search.h for
+*  the interface.
+*
+*  Layout: every byte value is mapped to a class, 1 to k - 1 for the
+*  bytes used in the patterns and 0 for the rest.  The automaton is one
+*  array of rows of k + 1 unsigned ints; columns 0 to k - 1 are the next
+*  state for each class and column k is the first state on this state's
+*  suffix chain that ends a pattern (0 if none).  States are stored as
+*  the offset of their row, so a step is two loads and an add:
+*	row = delta[row + classes[byte]];
+*  and the match test reads the same row.  The failure links are only
+*  used while building, to fill in the missing transitions.
+*/
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dyn_stack.h"
+#include "multi_search.h"
+
+typedef struct pattern {
+	size_t start;		/* Offset in the pattern bytes */
+	size_t length;
+} Pattern;
+
+struct multi_search {
+	DynStack bytes;		/* Every pattern, end to end */
+	DynStack patterns;	/* Pattern */
+	size_t longest;		/* Length of the longest pattern */
+	int built;
+
+	unsigned char classes[256];
+	unsigned int width;	/* Columns in a row: classes + 1 */
+	unsigned int *delta;	/* Rows of the automaton */
+	int *output;		/* Per state: pattern ending there, or -1 */
+	unsigned int *chain;	/* Per state: next state (row) on the suffix
+				   chain that ends a pattern, or 0 */
+};
+
+/* Function Prototypes (local) */
+static int AddMatch(void *arg, const MultiMatch *match);
+static int Settle(MultiSelect *picker, size_t upto);
+
+/*
+*  Function: MultiSearchCreate()
+*/
+MultiSearch *
+MultiSearchCreate(void)
+{
+	MultiSearch *search;
+
+	search = (MultiSearch *)calloc(1, sizeof(MultiSearch));
+	if (search == NULL)
+		return (NULL);
+
+	DynStackInit(&search->bytes, 1);
+	DynStackInit(&search->patterns, sizeof(Pattern));
+	return (search);
+}
+
+/*
+*  Function: MultiSearchFree()
+*/
+void
+MultiSearchFree(MultiSearch *search)
+{
+	if (search == NULL)
+		return;
+
+	DynStackFree(&search->bytes);
+	DynStackFree(&search->patterns);
+	free(search->delta);
+	free(search->output);
+	free(search->chain);
+	free(search);
+}
+
+/*
+*  Function: MultiSearchAdd()
+*  Returns the pattern's number (0, 1, 2, ... in the order added), or -1
+*  if it is empty, memory ran out or the search is already built.  A
+*  pattern added again is not stored twice: the number it was first
+*  given is returned.
+*/
+int
+MultiSearchAdd(MultiSearch *search, const char *pattern, size_t length)
+{
+	const Pattern *patterns = (const Pattern *)search->patterns.data;
+	const char *bytes = (const char *)search->bytes.data;
+	Pattern added;
+	size_t p;
+
+	if (search->built || length == 0 ||
+		DynStackSize(&search->patterns) >= INT_MAX)
+		return (-1);
+
+	for (p = 0; p < DynStackSize(&search->patterns); p++)
+		if (patterns[p].length == length &&
+			memcmp(bytes + patterns[p].start, pattern, length) == 0)
+			return ((int)p);
+
+	added.start = DynStackSize(&search->bytes);
+	added.length = length;
+	if (!DynStackReserve(&search->patterns,
+		DynStackSize(&search->patterns) + 1) ||
+		!DynStackPushBulk(&search->bytes, pattern, length))
+		return (-1);
+	DynStackPush(&search->patterns, &added);
+	if (length > search->longest)
+		search->longest = length;
+	return ((int)DynStackSize(&search->patterns) - 1);
+}
+
+/*
+*  Function: MultiSearchBuild()
+*  Makes the automaton from the patterns added.  Returns 1, or 0 if
+*  memory ran out or the table would be too big to index.
+*/
+int
+MultiSearchBuild(MultiSearch *search)
+{
+	const unsigned char *bytes = (const unsigned char *)search->bytes.data;
+	const Pattern *patterns = (const Pattern *)search->patterns.data;
+	size_t num_patterns = DynStackSize(&search->patterns);
+	size_t max_states = DynStackSize(&search->bytes) + 1;
+	unsigned int *fail = NULL, *queue = NULL;
+	unsigned int k, width, row, next, fail_row, c, num_states;
+	size_t p, i, head, tail;
+
+	if (search->built)
+		return (1);
+
+	/* Byte classes */
+	memset(search->classes, 0, sizeof(search->classes));
+	k = 1;
+	for (i = 0; i < DynStackSize(&search->bytes); i++)
+		if (search->classes[bytes[i]] == 0)
+			search->classes[bytes[i]] = (unsigned char)k++;
+	width = k + 1;
+	if (max_states > UINT_MAX / width)
+		return (0);
+
+	search->width = width;
+	search->delta = (unsigned int *)calloc(max_states * width,
+		sizeof(unsigned int));
+	search->output = (int *)malloc(max_states * sizeof(int));
+	search->chain = (unsigned int *)calloc(max_states, sizeof(unsigned int));
+	fail = (unsigned int *)malloc(max_states * sizeof(unsigned int));
+	queue = (unsigned int *)malloc(max_states * sizeof(unsigned int));
+	if (!search->delta || !search->output || !search->chain || !fail ||
+		!queue)
+	{
+		free(search->delta);
+		free(search->output);
+		free(search->chain);
+		search->delta = NULL;
+		search->output = NULL;
+		search->chain = NULL;
+		free(fail);
+		free(queue);
+		return (0);
+	}
+
+	/* The trie; 0 is no edge yet, as the root is nobody's child */
+	for (i = 0; i < max_states; i++)
+		search->output[i] = -1;
+	num_states = 1;
+	for (p = 0; p < num_patterns; p++)
+	{
+		row = 0;
+		for (i = 0; i < patterns[p].length; i++)
+		{
+			c = search->classes[bytes[patterns[p].start + i]];
+			if (search->delta[row + c] == 0)
+				search->delta[row + c] = width * num_states++;
+			row = search->delta[row + c];
+		}
+		search->output[row / width] = (int)p;
+	}
+
+	/* Breadth first, so a state's failure state is always finished
+	   before it: its missing edges are copied from there */
+	head = tail = 0;
+	for (c = 0; c < k; c++)
+	{
+		next = search->delta[c];
+		if (next != 0)
+		{
+			fail[next / width] = 0;
+			search->delta[next + k] =
+				(search->output[next / width] >= 0) ? next : 0;
+			queue[tail++] = next;
+		}
+	}
+
+	while (head < tail)
+	{
+		row = queue[head++];
+		fail_row = fail[row / width];
+		for (c = 0; c < k; c++)
+		{
+			next = search->delta[row + c];
+			if (next == 0)
+			{
+				search->delta[row + c] = search->delta[fail_row + c];
+				continue;
+			}
+
+			fail[next / width] = search->delta[fail_row + c];
+			search->chain[next / width] =
+				search->delta[fail[next / width] + k];
+			search->delta[next + k] =
+				(search->output[next / width] >= 0) ? next :
+				search->chain[next / width];
+			queue[tail++] = next;
+		}
+	}
+
+	free(fail);
+	free(queue);
+	search->built = 1;
+	return (1);
+}
+
+/*
+*  Function: MultiSearchLength()
+*/
+size_t
+MultiSearchLength(const MultiSearch *search, int pattern)
+{
+	return (((const Pattern *)search->patterns.data)[pattern].length);
+}
+
+/*
+*  Function: MultiScanInit()
+*  The search must be built.
+*/
+void
+MultiScanInit(MultiScan *scan, const MultiSearch *search)
+{
+	scan->search = search;
+	scan->row = 0;
+	scan->offset = 0;
+}
+
+/*
+*  Function: MultiScanFeed()
+*  Feeds the next length bytes of the text.  Returns 0 if func stopped
+*  the scan (the scan then carries on after the byte ending that match
+*  if fed again), else 1.
+*/
+int
+MultiScanFeed(MultiScan *scan, const char *text, size_t length,
+	MultiFunc func, void *arg)
+{
+	const MultiSearch *search = scan->search;
+	const unsigned int *delta = search->delta;
+	const unsigned char *classes = search->classes;
+	const Pattern *patterns = (const Pattern *)search->patterns.data;
+	unsigned int k = search->width - 1, width = search->width;
+	unsigned int row = scan->row, hit;
+	MultiMatch match;
+	size_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		row = delta[row + classes[(unsigned char)text[i]]];
+		if (delta[row + k] == 0)
+			continue;
+
+		for (hit = delta[row + k]; hit != 0;
+			hit = search->chain[hit / width])
+		{
+			match.pattern = search->output[hit / width];
+			match.position = scan->offset + i + 1 -
+				patterns[match.pattern].length;
+			if (!func(arg, &match))
+			{
+				scan->row = row;
+				scan->offset += i + 1;
+				return (0);
+			}
+		}
+	}
+
+	scan->row = row;
+	scan->offset += length;
+	return (1);
+}
+
+/*
+*  Function: MultiSelectInit()
+*  Sets up picker for a scan of a built search: pass MultiSelectMatch()
+*  and picker to MultiScanFeed(), then call MultiSelectFinish() at the
+*  end of the text.  func is called with each match picked, in order of
+*  position.  Returns 0 if memory ran out.
+*/
+int
+MultiSelectInit(MultiSelect *picker, const MultiSearch *search,
+	MultiFunc func, void *arg)
+{
+	size_t i;
+
+	picker->search = search;
+	picker->func = func;
+	picker->arg = arg;
+	picker->longest = search->longest > 0 ? search->longest : 1;
+	picker->next = 0;
+	picker->end = 0;
+	picker->open = (int *)malloc(picker->longest * sizeof(int));
+	if (picker->open == NULL)
+		return (0);
+
+	for (i = 0; i < picker->longest; i++)
+		picker->open[i] = -1;
+	return (1);
+}
+
+/*
+*  Function: MultiSelectMatch()
+*  A MultiFunc taking the matches of a scan in the order it reports
+*  them, by where they end.  A match ending at e means none still to
+*  come starts before e - longest, so the start positions before that
+*  are settled: the first of them not overlapping the last match picked
+*  is picked.  Until then each start position holds only its longest
+*  match.  Returns 0 if func stopped the scan.
+*/
+int
+MultiSelectMatch(void *arg, const MultiMatch *match)
+{
+	MultiSelect *picker = (MultiSelect *)arg;
+	size_t length, end, slot;
+
+	length = MultiSearchLength(picker->search, match->pattern);
+	end = match->position + length;
+	if (end > picker->longest && !Settle(picker, end - picker->longest))
+		return (0);
+
+	if (match->position < picker->end)
+		return (1);
+	slot = match->position % picker->longest;
+	if (picker->open[slot] < 0 || length >
+		MultiSearchLength(picker->search, picker->open[slot]))
+		picker->open[slot] = match->pattern;
+	return (1);
+}
+
+/*
+*  Function: MultiSelectFinish()
+*  The text has ended: settles the matches still open.  Returns 0 if
+*  func stopped it.
+*/
+int
+MultiSelectFinish(MultiSelect *picker)
+{
+	return (Settle(picker, picker->next + picker->longest));
+}
+
+/*
+*  Function: MultiSelectFree()
+*/
+void
+MultiSelectFree(MultiSelect *picker)
+{
+	free(picker->open);
+	picker->open = NULL;
+}
+
+/*
+*  Function: MultiSearchReplace()
+*  A new malloc()ed text ('\0' ended, length in *new_length) with each
+*  selected match of pattern p replaced by replacements[p].  Returns
+*  NULL if memory ran out.
+*/
+char *
+MultiSearchReplace(const MultiSearch *search, const char *text,
+	size_t length, const char *const replacements[], size_t *new_length)
+{
+	DynStack found;
+	MultiScan scan;
+	MultiSelect picker;
+	MultiMatch *matches;
+	size_t count, i, size, from, n;
+	char *result, *out;
+
+	DynStackInit(&found, sizeof(MultiMatch));
+	if (!MultiSelectInit(&picker, search, AddMatch, &found))
+		return (NULL);
+	MultiScanInit(&scan, search);
+	if (!MultiScanFeed(&scan, text, length, MultiSelectMatch, &picker) ||
+		!MultiSelectFinish(&picker))
+	{
+		MultiSelectFree(&picker);
+		DynStackFree(&found);
+		return (NULL);
+	}
+	MultiSelectFree(&picker);
+
+	matches = (MultiMatch *)found.data;
+	count = DynStackSize(&found);
+
+	size = length;
+	for (i = 0; i < count; i++)
+		size = size - MultiSearchLength(search, matches[i].pattern) +
+			strlen(replacements[matches[i].pattern]);
+
+	result = (char *)malloc(size + 1);
+	if (result != NULL)
+	{
+		out = result;
+		from = 0;
+		for (i = 0; i < count; i++)
+		{
+			memcpy(out, text + from, matches[i].position - from);
+			out += matches[i].position - from;
+			n = strlen(replacements[matches[i].pattern]);
+			memcpy(out, replacements[matches[i].pattern], n);
+			out += n;
+			from = matches[i].position +
+				MultiSearchLength(search, matches[i].pattern);
+		}
+		memcpy(out, text + from, length - from);
+		result[size] = '\0';
+		*new_length = size;
+	}
+
+	DynStackFree(&found);
+	return (result);
+}
+
+/*
+*  Function: AddMatch()
+*  MultiSelect callback collecting the matches picked on a DynStack;
+*  stops if memory runs out.
+*/
+static int
+AddMatch(void *arg, const MultiMatch *match)
+{
+	return (DynStackPush((DynStack *)arg, match));
+}
+
+/*
+*  Function: Settle()
+*  Start positions before upto can have no more matches: picks, in
+*  order, those whose match starts at or after the end of the last one
+*  picked.  Only the open positions, at most longest of them, are
+*  looked at.  Returns 0 if func stopped it.
+*/
+static int
+Settle(MultiSelect *picker, size_t upto)
+{
+	MultiMatch match;
+	size_t stop, slot;
+	int pattern;
+
+	stop = upto;
+	if (stop > picker->next + picker->longest)
+		stop = picker->next + picker->longest;
+
+	for (; picker->next < stop; picker->next++)
+	{
+		slot = picker->next % picker->longest;
+		pattern = picker->open[slot];
+		if (pattern < 0)
+			continue;
+		picker->open[slot] = -1;
+		if (picker->next < picker->end)
+			continue;
+
+		match.position = picker->next;
+		match.pattern = pattern;
+		picker->end = match.position +
+			MultiSearchLength(picker->search, pattern);
+		if (!picker->func(picker->arg, &match))
+		{
+			picker->next++;
+			return (0);
+		}
+	}
+
+	if (picker->next < upto)
+		picker->next = upto;
+	return (1);
+}
@@ -0,0 +1,91 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for finding many patterns at once in one pass over
+*  a text (Aho-Corasick).  The patterns are added, the automaton built,
+*  and then any amount of text fed through it, in one block or in pieces
+*  of any size: a match that spans two pieces is still found.  Each byte
+*  of text costs one table lookup, however many patterns there are.
+*
+*  The automaton is a complete table, one row per trie node, so there
+*  are no failure links to follow while scanning.  A row has a column
+*  only for each distinct byte that occurs in the patterns (all other
+*  bytes share one), plus one saying whether the node ends a pattern, so
+*  a few hundred terms make a table small enough to stay in cache.
+*
+*	MultiSearchCreate/Add/Build/Free()	Set up the patterns.
+*	MultiScanInit/Feed()	Stream text, calling back on every match
+*				(overlapping ones too), in order of where
+*				they end.
+*	MultiSelectInit/Match/Finish/Free()
+*				Picks, as a scan reports them, the matches
+*				a replacement uses: leftmost first, longest
+*				of those starting together, none
+*				overlapping.  Only one match per start
+*				position within the longest pattern of the
+*				scan is held, however many overlap.
+*	MultiSearchReplace()	A whole block with every picked match
+*				replaced.
+*  Compile with multi_search.c and dyn_stack.c.
+*/
+
+#ifndef _MULTI_SEARCH_H_
+#define _MULTI_SEARCH_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct multi_search MultiSearch;
+
+typedef struct multi_match {
+	size_t position;	/* Where the match starts */
+	int pattern;		/* Number MultiSearchAdd() gave it */
+} MultiMatch;
+
+/* Called for each match; return 0 to stop the scan */
+typedef int (*MultiFunc)(void *arg, const MultiMatch *match);
+
+typedef struct multi_scan {
+	const MultiSearch *search;
+	unsigned int row;	/* Automaton state */
+	size_t offset;		/* Bytes fed so far */
+} MultiScan;
+
+/* Picks matches as they are found; see MultiSelectMatch() */
+typedef struct multi_select {
+	const MultiSearch *search;
+	MultiFunc func;		/* Gets each match picked, in text order */
+	void *arg;
+	int *open;		/* Per start position, modulo longest: the
+				   longest pattern found starting there, or -1 */
+	size_t longest;		/* Length of the longest pattern */
+	size_t next;		/* First start position not yet settled */
+	size_t end;		/* End of the last match picked */
+} MultiSelect;
+
+/* Function Prototypes */
+MultiSearch *MultiSearchCreate(void);
+void MultiSearchFree(MultiSearch *search);
+int MultiSearchAdd(MultiSearch *search, const char *pattern, size_t length);
+int MultiSearchBuild(MultiSearch *search);
+size_t MultiSearchLength(const MultiSearch *search, int pattern);
+
+void MultiScanInit(MultiScan *scan, const MultiSearch *search);
+int MultiScanFeed(MultiScan *scan, const char *text, size_t length,
+	MultiFunc func, void *arg);
+
+int MultiSelectInit(MultiSelect *picker, const MultiSearch *search,
+	MultiFunc func, void *arg);
+int MultiSelectMatch(void *picker, const MultiMatch *match);
+int MultiSelectFinish(MultiSelect *picker);
+void MultiSelectFree(MultiSelect *picker);
+char *MultiSearchReplace(const MultiSearch *search, const char *text,
+	size_t length, const char *const replacements[], size_t *new_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
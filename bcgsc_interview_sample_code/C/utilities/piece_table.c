@@ -0,0 +1,801 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Piece table text buffer.  See piece_table.h for the interface.
+*
+*  The treap is split and merged by position: Split() cuts the sequence
+*  into the first n bytes and the rest, cutting one piece in two if n
+*  falls inside it, and Merge() joins two sequences.  Insert is a split
+*  and two merges, delete two splits and a merge.  Nodes come from blocks
+*  of NODE_BLOCK and go back on a free list, so the only allocations in
+*  an edit are the occasional new block or add buffer growth.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "dyn_stack.h"
+#include "text_search.h"
+#include "piece_table.h"
+
+#define NODE_BLOCK 1024
+#define ADD_MIN 4096		/* First size of the add buffer */
+
+typedef struct piece_node {
+	struct piece_node *left;
+	struct piece_node *right;
+	size_t start;		/* Offset of the piece in its buffer */
+	size_t length;
+	size_t total;		/* Length of the text of the whole subtree */
+	unsigned int priority;	/* Random, a parent's is higher */
+	int added;		/* In the add buffer, else the original */
+} PieceNode;
+
+typedef struct node_block {
+	struct node_block *next;
+	PieceNode nodes[NODE_BLOCK];
+} NodeBlock;
+
+/* One undoable edit */
+typedef struct edit {
+	int insert;		/* Else a delete */
+	size_t position;
+	size_t length;
+	PieceNode *removed;	/* The pieces, while out of the text */
+	size_t group;		/* Undone and redone together, 0 if alone */
+} Edit;
+
+struct piece_table {
+	char *original;
+	char *added;
+	size_t added_length;
+	size_t added_capacity;
+	PieceNode *root;
+	PieceNode *free_nodes;	/* Linked through left */
+	NodeBlock *blocks;
+	unsigned int seed;
+	DynStack undo;		/* Edits, latest on top */
+	DynStack redo;		/* Undone edits, latest undone on top */
+	size_t group;		/* Group edits now join, 0 if none open */
+	size_t groups;		/* Groups begun so far */
+};
+
+typedef struct find_state {
+	TextFinder finder;
+	size_t length;
+	char *tail;		/* Last length - 1 bytes before this run */
+	size_t tail_length;
+	char *bridge;		/* tail followed by the start of this run */
+	size_t offset;		/* Position of this run */
+	size_t found;
+} FindState;
+
+/* Function Prototypes (local) */
+static PieceNode *NewNode(PieceTable *table);
+static void FreeNode(PieceTable *table, PieceNode *node);
+static void FreeTree(PieceTable *table, PieceNode *node);
+static size_t Total(const PieceNode *node);
+static void Update(PieceNode *node);
+static PieceNode *Merge(PieceNode *left, PieceNode *right);
+static void Split(PieceNode *node, size_t position, PieceNode **left,
+	PieceNode **right, PieceNode **spare);
+static int Paste(PieceTable *table, size_t position, PieceNode *pieces);
+static int Remove(PieceTable *table, size_t position, size_t length,
+	PieceNode **removed);
+static void ClearRedo(PieceTable *table);
+static int Visit(const PieceTable *table, const PieceNode *node, size_t base,
+	size_t from, size_t to, PieceFunc func, void *arg);
+static int CopyRun(void *arg, const char *data, size_t length);
+static int FindRun(void *arg, const char *data, size_t length);
+static int WriteRun(void *arg, const char *data, size_t length);
+static int UndoOne(PieceTable *table);
+static int RedoOne(PieceTable *table);
+
+/*
+*  Function: PieceTableCreate()
+*  The table takes over text, which must come from malloc() (or be NULL
+*  when length is 0) and is freed with the table.  Returns NULL if
+*  memory ran out, text is then still the caller's.
+*/
+PieceTable *
+PieceTableCreate(char *text, size_t length)
+{
+	PieceTable *table;
+	PieceNode *node = NULL;
+
+	table = (PieceTable *)calloc(1, sizeof(PieceTable));
+	if (table == NULL)
+		return (NULL);
+
+	table->seed = 2463534242u;
+	DynStackInit(&table->undo, sizeof(Edit));
+	DynStackInit(&table->redo, sizeof(Edit));
+
+	if (length > 0)
+	{
+		node = NewNode(table);
+		if (node == NULL)
+		{
+			free(table);
+			return (NULL);
+		}
+		node->start = 0;
+		node->length = length;
+		node->total = length;
+		node->added = 0;
+	}
+	table->original = text;
+	table->root = node;
+	return (table);
+}
+
+/*
+*  Function: PieceTableFree()
+*/
+void
+PieceTableFree(PieceTable *table)
+{
+	NodeBlock *block;
+
+	if (table == NULL)
+		return;
+
+	while (table->blocks != NULL)
+	{
+		block = table->blocks;
+		table->blocks = block->next;
+		free(block);
+	}
+	DynStackFree(&table->undo);
+	DynStackFree(&table->redo);
+	free(table->original);
+	free(table->added);
+	free(table);
+}
+
+/*
+*  Function: PieceTableLength()
+*/
+size_t
+PieceTableLength(const PieceTable *table)
+{
+	return (Total(table->root));
+}
+
+/*
+*  Function: PieceTableInsert()
+*  Inserts text before position, or at the end if position is past it.
+*  Returns 1, or 0 if memory ran out (the text is then unchanged).
+*/
+int
+PieceTableInsert(PieceTable *table, size_t position, const char *text,
+	size_t length)
+{
+	PieceNode *node;
+	char *bigger;
+	size_t capacity;
+	Edit edit;
+
+	if (length == 0)
+		return (1);
+	if (position > Total(table->root))
+		position = Total(table->root);
+
+	if (!DynStackReserve(&table->undo, DynStackSize(&table->undo) + 1))
+		return (0);
+
+	if (table->added_capacity - table->added_length < length)
+	{
+		capacity = table->added_capacity ? table->added_capacity : ADD_MIN;
+		while (capacity - table->added_length < length)
+			capacity *= 2;
+		bigger = (char *)realloc(table->added, capacity);
+		if (bigger == NULL)
+			return (0);
+		table->added = bigger;
+		table->added_capacity = capacity;
+	}
+
+	node = NewNode(table);
+	if (node == NULL)
+		return (0);
+	node->start = table->added_length;
+	node->length = length;
+	node->total = length;
+	node->added = 1;
+
+	if (!Paste(table, position, node))
+	{
+		FreeNode(table, node);
+		return (0);
+	}
+	memcpy(table->added + table->added_length, text, length);
+	table->added_length += length;
+
+	edit.insert = 1;
+	edit.position = position;
+	edit.length = length;
+	edit.removed = NULL;
+	edit.group = table->group;
+	DynStackPush(&table->undo, &edit);
+	ClearRedo(table);
+	return (1);
+}
+
+/*
+*  Function: PieceTableDelete()
+*  Deletes length bytes from position, or as many as there are.  Returns
+*  1, or 0 if memory ran out (the text is then unchanged).
+*/
+int
+PieceTableDelete(PieceTable *table, size_t position, size_t length)
+{
+	size_t total = Total(table->root);
+	Edit edit;
+
+	if (position >= total || length == 0)
+		return (1);
+	if (length > total - position)
+		length = total - position;
+
+	if (!DynStackReserve(&table->undo, DynStackSize(&table->undo) + 1))
+		return (0);
+	if (!Remove(table, position, length, &edit.removed))
+		return (0);
+
+	edit.insert = 0;
+	edit.position = position;
+	edit.length = length;
+	edit.group = table->group;
+	DynStackPush(&table->undo, &edit);
+	ClearRedo(table);
+	return (1);
+}
+
+/*
+*  Function: PieceTableBeginGroup()
+*  Edits from now until PieceTableEndGroup() are undone and redone as
+*  one, e.g. all the replacements of one command.
+*/
+void
+PieceTableBeginGroup(PieceTable *table)
+{
+	table->group = ++table->groups;
+}
+
+/*
+*  Function: PieceTableEndGroup()
+*/
+void
+PieceTableEndGroup(PieceTable *table)
+{
+	table->group = 0;
+}
+
+/*
+*  Function: PieceTableUndo()
+*  Takes back the latest edit, or group of edits, not yet undone.
+*  Returns 1, or 0 if there is none or memory ran out (part of a group
+*  may then be undone; undoing again carries on with the rest).
+*/
+int
+PieceTableUndo(PieceTable *table)
+{
+	Edit *edit = (Edit *)DynStackTop(&table->undo);
+	size_t group;
+
+	if (edit == NULL)
+		return (0);
+
+	group = edit->group;
+	if (!UndoOne(table))
+		return (0);
+	while (group != 0 && (edit = (Edit *)DynStackTop(&table->undo)) != NULL &&
+		edit->group == group)
+		if (!UndoOne(table))
+			return (0);
+	return (1);
+}
+
+/*
+*  Function: PieceTableRedo()
+*  Makes the latest undone edit, or group of edits, again.  Returns 1,
+*  or 0 if there is none or memory ran out (as for PieceTableUndo()).
+*/
+int
+PieceTableRedo(PieceTable *table)
+{
+	Edit *edit = (Edit *)DynStackTop(&table->redo);
+	size_t group;
+
+	if (edit == NULL)
+		return (0);
+
+	group = edit->group;
+	if (!RedoOne(table))
+		return (0);
+	while (group != 0 && (edit = (Edit *)DynStackTop(&table->redo)) != NULL &&
+		edit->group == group)
+		if (!RedoOne(table))
+			return (0);
+	return (1);
+}
+
+/*
+*  Function: PieceTableChunks()
+*  Calls func with the text from position for length bytes (or to the
+*  end), one stored run at a time.  Returns 0 if func stopped it early.
+*/
+int
+PieceTableChunks(const PieceTable *table, size_t position, size_t length,
+	PieceFunc func, void *arg)
+{
+	size_t total = Total(table->root);
+
+	if (position >= total)
+		return (1);
+	if (length > total - position)
+		length = total - position;
+	return (Visit(table, table->root, 0, position, position + length, func,
+		arg));
+}
+
+/*
+*  Function: PieceTableCopy()
+*  Copies up to length bytes from position to out (not '\0' ended).
+*  Returns the number copied.
+*/
+size_t
+PieceTableCopy(const PieceTable *table, size_t position, size_t length,
+	char *out)
+{
+	char *end = out;
+
+	PieceTableChunks(table, position, length, CopyRun, &end);
+	return ((size_t)(end - out));
+}
+
+/*
+*  Function: PieceTableFind()
+*  Position of the first occurrence of pattern at or after from, or
+*  PIECE_NOT_FOUND (also if memory ran out).  A match may span any
+*  number of runs: the last length - 1 bytes seen are kept and searched
+*  together with the start of the next run.
+*/
+size_t
+PieceTableFind(const PieceTable *table, size_t from, const char *pattern,
+	size_t length)
+{
+	size_t total = Total(table->root);
+	FindState state;
+
+	if (from > total || length > total - from)
+		return (PIECE_NOT_FOUND);
+	if (length == 0)
+		return (from);
+
+	TextFinderInit(&state.finder, pattern, length);
+	state.length = length;
+	state.tail = NULL;
+	state.tail_length = 0;
+	state.bridge = NULL;
+	state.offset = from;
+	state.found = PIECE_NOT_FOUND;
+
+	if (length > 1)
+	{
+		state.tail = (char *)malloc(3 * (length - 1));
+		if (state.tail == NULL)
+			return (PIECE_NOT_FOUND);
+		state.bridge = state.tail + (length - 1);
+	}
+
+	PieceTableChunks(table, from, total - from, FindRun, &state);
+	free(state.tail);
+	return (state.found);
+}
+
+/*
+*  Function: PieceTableWrite()
+*  Returns 1, or 0 on a write error.
+*/
+int
+PieceTableWrite(const PieceTable *table, FILE *out)
+{
+	return (PieceTableChunks(table, 0, Total(table->root), WriteRun, out));
+}
+
+/*
+*  Function: NewNode()
+*  A node with a fresh random priority and no children.
+*/
+static PieceNode *
+NewNode(PieceTable *table)
+{
+	PieceNode *node;
+	NodeBlock *block;
+	int i;
+
+	if (table->free_nodes == NULL)
+	{
+		block = (NodeBlock *)malloc(sizeof(NodeBlock));
+		if (block == NULL)
+			return (NULL);
+		block->next = table->blocks;
+		table->blocks = block;
+		for (i = 0; i < NODE_BLOCK; i++)
+			FreeNode(table, &block->nodes[i]);
+	}
+
+	node = table->free_nodes;
+	table->free_nodes = node->left;
+
+	/* xorshift32 */
+	table->seed ^= table->seed << 13;
+	table->seed ^= table->seed >> 17;
+	table->seed ^= table->seed << 5;
+	node->priority = table->seed;
+	node->left = NULL;
+	node->right = NULL;
+	return (node);
+}
+
+/*
+*  Function: FreeNode()
+*/
+static void
+FreeNode(PieceTable *table, PieceNode *node)
+{
+	node->left = table->free_nodes;
+	table->free_nodes = node;
+}
+
+/*
+*  Function: FreeTree()
+*/
+static void
+FreeTree(PieceTable *table, PieceNode *node)
+{
+	PieceNode *right;
+
+	while (node != NULL)
+	{
+		FreeTree(table, node->left);
+		right = node->right;
+		FreeNode(table, node);
+		node = right;
+	}
+}
+
+/*
+*  Function: Total()
+*/
+static size_t
+Total(const PieceNode *node)
+{
+	return (node ? node->total : 0);
+}
+
+/*
+*  Function: Update()
+*/
+static void
+Update(PieceNode *node)
+{
+	node->total = Total(node->left) + node->length + Total(node->right);
+}
+
+/*
+*  Function: Merge()
+*  The sequence left followed by the sequence right.
+*/
+static PieceNode *
+Merge(PieceNode *left, PieceNode *right)
+{
+	if (left == NULL)
+		return (right);
+	if (right == NULL)
+		return (left);
+
+	if (left->priority > right->priority)
+	{
+		left->right = Merge(left->right, right);
+		Update(left);
+		return (left);
+	}
+	right->left = Merge(left, right->left);
+	Update(right);
+	return (right);
+}
+
+/*
+*  Function: Split()
+*  Cuts node's sequence into its first position bytes (left) and the rest
+*  (right).  If the cut falls inside a piece, *spare becomes its second
+*  half and is set to NULL; it is left alone otherwise.
+*/
+static void
+Split(PieceNode *node, size_t position, PieceNode **left, PieceNode **right,
+	PieceNode **spare)
+{
+	size_t left_total;
+	PieceNode *rest;
+
+	if (node == NULL)
+	{
+		*left = NULL;
+		*right = NULL;
+		return;
+	}
+
+	left_total = Total(node->left);
+	if (position <= left_total)
+	{
+		Split(node->left, position, left, &node->left, spare);
+		Update(node);
+		*right = node;
+	}
+	else if (position >= left_total + node->length)
+	{
+		Split(node->right, position - left_total - node->length,
+			&node->right, right, spare);
+		Update(node);
+		*left = node;
+	}
+	else
+	{
+		position -= left_total;
+		rest = *spare;
+		*spare = NULL;
+		rest->start = node->start + position;
+		rest->length = node->length - position;
+		rest->total = rest->length;
+		rest->added = node->added;
+		node->length = position;
+
+		*right = Merge(rest, node->right);
+		node->right = NULL;
+		Update(node);
+		*left = node;
+	}
+}
+
+/*
+*  Function: Paste()
+*  Links the sequence pieces in before position.  Returns 0 if memory
+*  ran out.
+*/
+static int
+Paste(PieceTable *table, size_t position, PieceNode *pieces)
+{
+	PieceNode *spare, *left, *right;
+
+	spare = NewNode(table);
+	if (spare == NULL)
+		return (0);
+
+	Split(table->root, position, &left, &right, &spare);
+	table->root = Merge(Merge(left, pieces), right);
+
+	if (spare != NULL)
+		FreeNode(table, spare);
+	return (1);
+}
+
+/*
+*  Function: Remove()
+*  Unlinks length bytes from position, as the sequence *removed.
+*  Returns 0 if memory ran out.
+*/
+static int
+Remove(PieceTable *table, size_t position, size_t length,
+	PieceNode **removed)
+{
+	PieceNode *first, *second, *left, *middle, *right;
+
+	first = NewNode(table);
+	second = NewNode(table);
+	if (first == NULL || second == NULL)
+	{
+		if (first != NULL)
+			FreeNode(table, first);
+		return (0);
+	}
+
+	Split(table->root, position, &left, &right, &first);
+	Split(right, length, &middle, &right, &second);
+	table->root = Merge(left, right);
+	*removed = middle;
+
+	if (first != NULL)
+		FreeNode(table, first);
+	if (second != NULL)
+		FreeNode(table, second);
+	return (1);
+}
+
+/*
+*  Function: ClearRedo()
+*  An undone insert holds its pieces; they can go now.
+*/
+static void
+ClearRedo(PieceTable *table)
+{
+	Edit edit;
+
+	while (DynStackPop(&table->redo, &edit))
+		FreeTree(table, edit.removed);
+}
+
+/*
+*  Function: Visit()
+*  In order walk of the pieces overlapping [from, to); base is the
+*  position of node's subtree.
+*/
+static int
+Visit(const PieceTable *table, const PieceNode *node, size_t base,
+	size_t from, size_t to, PieceFunc func, void *arg)
+{
+	size_t low, high;
+	const char *data;
+
+	while (node != NULL && from < base + node->total && to > base)
+	{
+		if (!Visit(table, node->left, base, from, to, func, arg))
+			return (0);
+		base += Total(node->left);
+		if (to <= base)
+			break;
+
+		low = (from > base) ? from - base : 0;
+		high = (to < base + node->length) ? to - base : node->length;
+		if (low < high)
+		{
+			data = (node->added ? table->added : table->original) +
+				node->start;
+			if (!func(arg, data + low, high - low))
+				return (0);
+		}
+
+		base += node->length;
+		node = node->right;
+	}
+	return (1);
+}
+
+/*
+*  Function: CopyRun()
+*/
+static int
+CopyRun(void *arg, const char *data, size_t length)
+{
+	char **end = (char **)arg;
+
+	memcpy(*end, data, length);
+	*end += length;
+	return (1);
+}
+
+/*
+*  Function: FindRun()
+*  First a match that starts in the tail and ends in this run, then one
+*  inside this run.
+*/
+static int
+FindRun(void *arg, const char *data, size_t length)
+{
+	FindState *state = (FindState *)arg;
+	size_t keep = state->length - 1, head, at, drop;
+
+	if (state->tail_length > 0)
+	{
+		head = (length < keep) ? length : keep;
+		memcpy(state->bridge, state->tail, state->tail_length);
+		memcpy(state->bridge + state->tail_length, data, head);
+		at = TextFinderFind(&state->finder, state->bridge,
+			state->tail_length + head);
+		if (at < state->tail_length)
+		{
+			state->found = state->offset - state->tail_length + at;
+			return (0);
+		}
+	}
+
+	at = TextFinderFind(&state->finder, data, length);
+	if (at != TEXT_NOT_FOUND)
+	{
+		state->found = state->offset + at;
+		return (0);
+	}
+
+	if (keep > 0)
+	{
+		if (length >= keep)
+		{
+			memcpy(state->tail, data + length - keep, keep);
+			state->tail_length = keep;
+		}
+		else
+		{
+			drop = (state->tail_length + length > keep) ?
+				state->tail_length + length - keep : 0;
+			memmove(state->tail, state->tail + drop,
+				state->tail_length - drop);
+			memcpy(state->tail + state->tail_length - drop, data, length);
+			state->tail_length += length - drop;
+		}
+	}
+	state->offset += length;
+	return (1);
+}
+
+/*
+*  Function: WriteRun()
+*/
+static int
+WriteRun(void *arg, const char *data, size_t length)
+{
+	return (fwrite(data, 1, length, (FILE *)arg) == length);
+}
+
+/*
+*  Function: UndoOne()
+*  Takes back the edit on top of the undo stack.  Returns 1, or 0 if
+*  there is none or memory ran out.
+*/
+static int
+UndoOne(PieceTable *table)
+{
+	Edit *edit = (Edit *)DynStackTop(&table->undo);
+	Edit done;
+
+	if (edit == NULL ||
+		!DynStackReserve(&table->redo, DynStackSize(&table->redo) + 1))
+		return (0);
+
+	if (edit->insert)
+	{
+		if (!Remove(table, edit->position, edit->length, &edit->removed))
+			return (0);
+	}
+	else
+	{
+		if (!Paste(table, edit->position, edit->removed))
+			return (0);
+		edit->removed = NULL;
+	}
+
+	DynStackPop(&table->undo, &done);
+	DynStackPush(&table->redo, &done);
+	return (1);
+}
+
+/*
+*  Function: RedoOne()
+*  Makes the edit on top of the redo stack again.  Returns 1, or 0 if
+*  there is none or memory ran out.
+*/
+static int
+RedoOne(PieceTable *table)
+{
+	Edit *edit = (Edit *)DynStackTop(&table->redo);
+	Edit done;
+
+	if (edit == NULL ||
+		!DynStackReserve(&table->undo, DynStackSize(&table->undo) + 1))
+		return (0);
+
+	if (edit->insert)
+	{
+		if (!Paste(table, edit->position, edit->removed))
+			return (0);
+		edit->removed = NULL;
+	}
+	else
+	{
+		if (!Remove(table, edit->position, edit->length, &edit->removed))
+			return (0);
+	}
+
+	DynStackPop(&table->redo, &done);
+	DynStackPush(&table->undo, &done);
+	return (1);
+}
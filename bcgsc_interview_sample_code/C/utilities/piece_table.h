@@ -0,0 +1,65 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for a piece table text buffer.  The text is never
+*  moved: the original text and everything ever inserted (appended to an
+*  add buffer) stay where they are, and the document is a sequence of
+*  pieces, each a run of one of those two buffers.  The pieces are kept
+*  in a treap ordered by position, each node knowing the length of its
+*  subtree, so an insert or delete anywhere is O(log n) in the number of
+*  pieces, independent of the length of the text.
+*
+*  Every edit is recorded for undo.  A delete keeps the pieces it removed
+*  (a detached subtree), so undoing it just links them back in, and an
+*  undone insert is kept the same way for redo.  A new edit clears the
+*  redo history.  Edits made between PieceTableBeginGroup() and
+*  PieceTableEndGroup() are undone and redone together.
+*
+*  Positions and lengths are in bytes.  Reading is by PieceTableChunks(),
+*  which hands over the text in order as the runs it is stored in.
+*  Compile with piece_table.c, dyn_stack.c, text_search.c and
+*  simd_search.c.
+*/
+
+#ifndef _PIECE_TABLE_H_
+#define _PIECE_TABLE_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PIECE_NOT_FOUND ((size_t)-1)
+
+typedef struct piece_table PieceTable;
+
+/* Called with each run of text in turn; return 0 to stop early */
+typedef int (*PieceFunc)(void *arg, const char *data, size_t length);
+
+/* Function Prototypes */
+PieceTable *PieceTableCreate(char *text, size_t length);
+void PieceTableFree(PieceTable *table);
+size_t PieceTableLength(const PieceTable *table);
+
+int PieceTableInsert(PieceTable *table, size_t position, const char *text,
+	size_t length);
+int PieceTableDelete(PieceTable *table, size_t position, size_t length);
+void PieceTableBeginGroup(PieceTable *table);
+void PieceTableEndGroup(PieceTable *table);
+int PieceTableUndo(PieceTable *table);
+int PieceTableRedo(PieceTable *table);
+
+int PieceTableChunks(const PieceTable *table, size_t position, size_t length,
+	PieceFunc func, void *arg);
+size_t PieceTableCopy(const PieceTable *table, size_t position, size_t length,
+	char *out);
+size_t PieceTableFind(const PieceTable *table, size_t from,
+	const char *pattern, size_t length);
+int PieceTableWrite(const PieceTable *table, FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,270 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Static Eytzinger search index.  See search_index.h for the
+*  interface.
+*
+*  The search: start at the root, at each node go left if the key is
+*  <= the node, right otherwise.  When the walk falls off the bottom,
+*  the path taken (the bits of k) tells where the first node >= key was:
+*  strip the trailing right turns and the left turn before them.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "thread_pool.h"
+#include "sort_lib.h"
+#include "search_index.h"
+
+#define CACHE_LINE 64
+#define PREFETCH_AHEAD 16	/* Nodes 4 levels down, one cache line */
+#define BATCH_LANES 8		/* Keys walked down the tree together */
+#define BATCH_PARALLEL_MIN 65536
+#define BATCH_GRAIN 16384
+
+#ifdef __GNUC__
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)0)
+#endif
+
+typedef struct value_position {
+	int value;
+	long position;
+} ValuePosition;
+
+typedef struct batch_job {
+	const SearchIndex *index;
+	const int *keys;
+	long *positions;
+} BatchJob;
+
+/* Function Prototypes (local) */
+static uint64_t ValueKey(const void *item);
+static size_t FillTree(SearchIndex *index, const ValuePosition sorted[],
+	size_t i, size_t k);
+static size_t LowerBoundNode(size_t k);
+static void FindGroup(const SearchIndex *index, const int keys[],
+	long positions[], int count);
+static void BatchRange(void *arg, long low, long high);
+
+/*
+*  Function: SearchIndexBuild()
+*  Indexes the count values.  which is SEARCH_FIRST or SEARCH_LAST, the
+*  position kept for a value that appears more than once.  Returns 1, or
+*  0 if memory ran out.
+*/
+int
+SearchIndexBuild(SearchIndex *index, const int values[], size_t count,
+	int which)
+{
+	SortKeyFunc key = ValueKey;
+	ValuePosition *pairs;
+	size_t i, distinct, bytes;
+
+	memset(index, 0, sizeof(SearchIndex));
+
+	pairs = (ValuePosition *)malloc((count ? count : 1) *
+		sizeof(ValuePosition));
+	if (pairs == NULL)
+		return (0);
+
+	for (i = 0; i < count; i++)
+	{
+		pairs[i].value = values[i];
+		pairs[i].position = (long)i;
+	}
+
+	/* Stable, so equal values stay in position order */
+	if (!SortByKeys(pairs, count, sizeof(ValuePosition), &key, 1))
+	{
+		free(pairs);
+		return (0);
+	}
+
+	distinct = 0;
+	for (i = 0; i < count; i++)
+	{
+		if (distinct == 0 || pairs[distinct - 1].value != pairs[i].value)
+			pairs[distinct++] = pairs[i];
+		else if (which == SEARCH_LAST)
+			pairs[distinct - 1].position = pairs[i].position;
+	}
+
+	/* Slot 0 is unused, the root is at 1 */
+	bytes = (distinct + 1) * sizeof(int);
+	bytes = (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+	index->block = aligned_alloc(CACHE_LINE, bytes);
+	index->positions = (long *)malloc((distinct + 1) * sizeof(long));
+	if (index->block == NULL || index->positions == NULL)
+	{
+		free(pairs);
+		SearchIndexFree(index);
+		return (0);
+	}
+
+	index->keys = (int *)index->block;
+	index->count = distinct;
+	index->keys[0] = 0;
+	index->positions[0] = SEARCH_NOT_FOUND;
+	FillTree(index, pairs, 0, 1);
+
+	/* Levels 0 .. height - 1 are full, so every search gets that far */
+	index->height = 0;
+	while (((size_t)2 << index->height) - 1 <= distinct)
+		index->height++;
+
+	free(pairs);
+	return (1);
+}
+
+/*
+*  Function: SearchIndexFree()
+*/
+void
+SearchIndexFree(SearchIndex *index)
+{
+	free(index->block);
+	free(index->positions);
+	memset(index, 0, sizeof(SearchIndex));
+}
+
+/*
+*  Function: SearchIndexFind()
+*  Returns the original position of key, or SEARCH_NOT_FOUND.
+*/
+long
+SearchIndexFind(const SearchIndex *index, int key)
+{
+	const int *keys = index->keys;
+	size_t n = index->count;
+	size_t k = 1;
+
+	while (k <= n)
+	{
+		PREFETCH(keys + k * PREFETCH_AHEAD);
+		k = 2 * k + (keys[k] < key);
+	}
+
+	k = LowerBoundNode(k);
+	if (k != 0 && keys[k] == key)
+		return (index->positions[k]);
+	return (SEARCH_NOT_FOUND);
+}
+
+/*
+*  Function: SearchIndexFindBatch()
+*  positions[i] gets SearchIndexFind(index, keys[i]) for every i.
+*/
+void
+SearchIndexFindBatch(const SearchIndex *index, const int keys[],
+	long positions[], size_t count)
+{
+	BatchJob job;
+
+	job.index = index;
+	job.keys = keys;
+	job.positions = positions;
+
+	if (count >= BATCH_PARALLEL_MIN)
+		PoolParallelFor(PoolDefault(), 0, (long)count, BATCH_GRAIN,
+			BatchRange, &job);
+	else
+		BatchRange(&job, 0, (long)count);
+}
+
+/*
+*  Function: BatchRange()
+*/
+static void
+BatchRange(void *arg, long low, long high)
+{
+	BatchJob *job = (BatchJob *)arg;
+	long i;
+
+	for (i = low; i < high; i += BATCH_LANES)
+		FindGroup(job->index, job->keys + i, job->positions + i,
+			high - i < BATCH_LANES ? (int)(high - i) : BATCH_LANES);
+}
+
+/*
+*  Function: FindGroup()
+*  Up to BATCH_LANES searches in lock step.  Every search takes the same
+*  path length through the full levels, so the loads of one level are
+*  all issued before any of them is needed.
+*/
+static void
+FindGroup(const SearchIndex *index, const int keys[], long positions[],
+	int count)
+{
+	const int *tree = index->keys;
+	size_t n = index->count;
+	size_t k[BATCH_LANES];
+	int lane, level;
+
+	for (lane = 0; lane < count; lane++)
+		k[lane] = 1;
+
+	for (level = 0; level < index->height; level++)
+		for (lane = 0; lane < count; lane++)
+		{
+			PREFETCH(tree + k[lane] * PREFETCH_AHEAD);
+			k[lane] = 2 * k[lane] + (tree[k[lane]] < keys[lane]);
+		}
+
+	for (lane = 0; lane < count; lane++)
+	{
+		/* The bottom level may be partly filled */
+		if (k[lane] <= n)
+			k[lane] = 2 * k[lane] + (tree[k[lane]] < keys[lane]);
+
+		k[lane] = LowerBoundNode(k[lane]);
+		positions[lane] = (k[lane] != 0 && tree[k[lane]] == keys[lane]) ?
+			index->positions[k[lane]] : SEARCH_NOT_FOUND;
+	}
+}
+
+/*
+*  Function: LowerBoundNode()
+*  Undoes the trailing right turns and the left turn before them.  0
+*  means every node was < key.
+*/
+static size_t
+LowerBoundNode(size_t k)
+{
+#ifdef __GNUC__
+	return (k >> (__builtin_ctzl(~(unsigned long)k) + 1));
+#else
+	while (k & 1)
+		k >>= 1;
+	return (k >> 1);
+#endif
+}
+
+/*
+*  Function: FillTree()
+*  An in-order walk of the tree hands out the sorted values in order.
+*  Returns the next unused value.
+*/
+static size_t
+FillTree(SearchIndex *index, const ValuePosition sorted[], size_t i,
+	size_t k)
+{
+	if (k <= index->count)
+	{
+		i = FillTree(index, sorted, i, 2 * k);
+		index->keys[k] = sorted[i].value;
+		index->positions[k] = sorted[i].position;
+		i = FillTree(index, sorted, i + 1, 2 * k + 1);
+	}
+	return (i);
+}
+
+/*
+*  Function: ValueKey()
+*/
+static uint64_t
+ValueKey(const void *item)
+{
+	return (SortKeyInt(((const ValuePosition *)item)->value));
+}
@@ -0,0 +1,54 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for a static search index over an int array.  Built
+*  once, it answers "where is this value?" in O(log n) instead of the
+*  linear scans of searcharray() in search_array.c and search() in
+*  function_search.c.
+*
+*  The distinct values are stored in Eytzinger (breadth first) order: the
+*  root at 1, the children of node k at 2k and 2k + 1.  A search walks
+*  down without branching on the comparison, and the top levels that
+*  every search visits stay in cache.  The node 4 levels ahead is
+*  prefetched, those 16 nodes share one cache line.  The batch call
+*  walks several keys down the tree together so their memory reads
+*  overlap, and splits big batches across the thread pool.
+*  Compile with search_index.c, sort_lib.c, thread_pool.c, work_deque.c
+*  and -pthread.
+*/
+
+#ifndef _SEARCH_INDEX_H_
+#define _SEARCH_INDEX_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Which position SearchIndexBuild() keeps for a value found more than once */
+#define SEARCH_FIRST 0
+#define SEARCH_LAST 1
+
+#define SEARCH_NOT_FOUND -1L
+
+typedef struct search_index {
+	int *keys;		/* Eytzinger order, keys[1] is the root */
+	long *positions;	/* Where keys[k] was in the original array */
+	size_t count;		/* Number of distinct values */
+	int height;		/* Levels of the tree that are full */
+	void *block;		/* The one allocation holding keys */
+} SearchIndex;
+
+/* Function Prototypes */
+int SearchIndexBuild(SearchIndex *index, const int values[], size_t count,
+	int which);
+void SearchIndexFree(SearchIndex *index);
+long SearchIndexFind(const SearchIndex *index, int key);
+void SearchIndexFindBatch(const SearchIndex *index, const int keys[],
+	long positions[], size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
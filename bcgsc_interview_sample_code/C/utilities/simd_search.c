@@ -0,0 +1,455 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Vectorised linear search.  See simd_search.h for the
+*  interface.
+*
+*  Every kernel looks at 8 values a step: the lane compares give all ones
+*  where a value equals the key, movemask packs one bit per lane into an
+*  int, and the lowest (highest, for the last match) set bit is the hit.
+*  The few values left past the last full step are compared one by one.
+*  The x86 kernels are compiled with target attributes, so the rest of
+*  the program needs no -mavx2 and still runs on older CPUs.
+*/
+
+#include <stdatomic.h>
+#include "simd_search.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_KERNELS
+#include <immintrin.h>
+#define AVX2 __attribute__((target("avx2")))
+#define SSE2 __attribute__((target("sse2")))
+#define FIRST_BIT(mask) __builtin_ctz(mask)
+#define LAST_BIT(mask) (31 - __builtin_clz(mask))
+#endif
+
+#define STEP 8
+
+typedef long (*FindIntFunc)(const int values[], size_t count, int key);
+typedef long (*FindDoubleFunc)(const double values[], size_t count,
+	double key);
+
+typedef struct kernels {
+	FindIntFunc find_int;
+	FindIntFunc find_int_last;
+	FindDoubleFunc find_double;
+	FindDoubleFunc find_double_last;
+} Kernels;
+
+/* Function Prototypes (local) */
+static long FindIntScalar(const int values[], size_t count, int key);
+static long FindIntLastScalar(const int values[], size_t count, int key);
+static long FindDoubleScalar(const double values[], size_t count,
+	double key);
+static long FindDoubleLastScalar(const double values[], size_t count,
+	double key);
+static const Kernels *Current(void);
+static int BestLevel(void);
+
+#ifdef HAVE_X86_KERNELS
+static long FindIntSse2(const int values[], size_t count, int key);
+static long FindIntLastSse2(const int values[], size_t count, int key);
+static long FindDoubleSse2(const double values[], size_t count, double key);
+static long FindDoubleLastSse2(const double values[], size_t count,
+	double key);
+static long FindIntAvx2(const int values[], size_t count, int key);
+static long FindIntLastAvx2(const int values[], size_t count, int key);
+static long FindDoubleAvx2(const double values[], size_t count, double key);
+static long FindDoubleLastAvx2(const double values[], size_t count,
+	double key);
+#endif
+
+/* Indexed by SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2 */
+static const Kernels kernel_table[] = {
+	{ FindIntScalar, FindIntLastScalar,
+	  FindDoubleScalar, FindDoubleLastScalar },
+#ifdef HAVE_X86_KERNELS
+	{ FindIntSse2, FindIntLastSse2, FindDoubleSse2, FindDoubleLastSse2 },
+	{ FindIntAvx2, FindIntLastAvx2, FindDoubleAvx2, FindDoubleLastAvx2 },
+#endif
+};
+
+/* The kernels in use, NULL until the first search picks them */
+static _Atomic(const Kernels *) kernels = NULL;
+
+/*
+*  Function: FindInt()
+*  Arrays shorter than one step are not worth the call to a kernel.
+*/
+long
+FindInt(const int values[], size_t count, int key)
+{
+	if (count < STEP)
+		return (FindIntScalar(values, count, key));
+	return (Current()->find_int(values, count, key));
+}
+
+/*
+*  Function: FindIntLast()
+*/
+long
+FindIntLast(const int values[], size_t count, int key)
+{
+	if (count < STEP)
+		return (FindIntLastScalar(values, count, key));
+	return (Current()->find_int_last(values, count, key));
+}
+
+/*
+*  Function: FindDouble()
+*/
+long
+FindDouble(const double values[], size_t count, double key)
+{
+	if (count < STEP)
+		return (FindDoubleScalar(values, count, key));
+	return (Current()->find_double(values, count, key));
+}
+
+/*
+*  Function: FindDoubleLast()
+*/
+long
+FindDoubleLast(const double values[], size_t count, double key)
+{
+	if (count < STEP)
+		return (FindDoubleLastScalar(values, count, key));
+	return (Current()->find_double_last(values, count, key));
+}
+
+/*
+*  Function: SimdSearchSetLevel()
+*/
+int
+SimdSearchSetLevel(int wanted)
+{
+	int best = BestLevel();
+
+	if (wanted < SIMD_SCALAR)
+		wanted = SIMD_SCALAR;
+	if (wanted > best)
+		wanted = best;
+	atomic_store(&kernels, &kernel_table[wanted]);
+	return (wanted);
+}
+
+/*
+*  Function: SimdSearchLevel()
+*/
+int
+SimdSearchLevel(void)
+{
+	return ((int)(Current() - kernel_table));
+}
+
+/*
+*  Function: Current()
+*  The kernels in use.  The first call checks the CPU.  Threads racing
+*  through it all find the same answer, so no lock is needed.
+*/
+static inline const Kernels *
+Current(void)
+{
+	const Kernels *in_use;
+
+	in_use = atomic_load_explicit(&kernels, memory_order_acquire);
+	if (in_use == NULL)
+	{
+		in_use = &kernel_table[BestLevel()];
+		atomic_store(&kernels, in_use);
+	}
+	return (in_use);
+}
+
+/*
+*  Function: BestLevel()
+*/
+static int
+BestLevel(void)
+{
+#ifdef HAVE_X86_KERNELS
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return (SIMD_AVX2);
+	if (__builtin_cpu_supports("sse2"))
+		return (SIMD_SSE2);
+#endif
+	return (SIMD_SCALAR);
+}
+
+/*
+*  Function: FindIntScalar()
+*  The plain loops, also used for the tails of the vector kernels.
+*/
+static long
+FindIntScalar(const int values[], size_t count, int key)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+		if (values[i] == key)
+			return ((long)i);
+	return (-1L);
+}
+
+static long
+FindIntLastScalar(const int values[], size_t count, int key)
+{
+	while (count > 0)
+		if (values[--count] == key)
+			return ((long)count);
+	return (-1L);
+}
+
+static long
+FindDoubleScalar(const double values[], size_t count, double key)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+		if (values[i] == key)
+			return ((long)i);
+	return (-1L);
+}
+
+static long
+FindDoubleLastScalar(const double values[], size_t count, double key)
+{
+	while (count > 0)
+		if (values[--count] == key)
+			return ((long)count);
+	return (-1L);
+}
+
+#ifdef HAVE_X86_KERNELS
+
+/*
+*  Function: FindIntSse2()
+*  Two 4 lane compares a step.
+*/
+SSE2 static long
+FindIntSse2(const int values[], size_t count, int key)
+{
+	__m128i wanted = _mm_set1_epi32(key);
+	__m128i low, high;
+	unsigned int mask;
+	size_t i;
+	long found;
+
+	for (i = 0; i + STEP <= count; i += STEP)
+	{
+		low = _mm_loadu_si128((const __m128i *)(values + i));
+		high = _mm_loadu_si128((const __m128i *)(values + i + 4));
+		mask = _mm_movemask_ps(_mm_castsi128_ps(
+				_mm_cmpeq_epi32(low, wanted))) |
+			_mm_movemask_ps(_mm_castsi128_ps(
+				_mm_cmpeq_epi32(high, wanted))) << 4;
+		if (mask)
+			return ((long)(i + FIRST_BIT(mask)));
+	}
+
+	found = FindIntScalar(values + i, count - i, key);
+	return (found < 0 ? found : (long)i + found);
+}
+
+SSE2 static long
+FindIntLastSse2(const int values[], size_t count, int key)
+{
+	__m128i wanted = _mm_set1_epi32(key);
+	__m128i low, high;
+	unsigned int mask;
+	size_t i;
+
+	for (i = count; i >= STEP; i -= STEP)
+	{
+		low = _mm_loadu_si128((const __m128i *)(values + i - STEP));
+		high = _mm_loadu_si128((const __m128i *)(values + i - 4));
+		mask = _mm_movemask_ps(_mm_castsi128_ps(
+				_mm_cmpeq_epi32(low, wanted))) |
+			_mm_movemask_ps(_mm_castsi128_ps(
+				_mm_cmpeq_epi32(high, wanted))) << 4;
+		if (mask)
+			return ((long)(i - STEP + LAST_BIT(mask)));
+	}
+
+	return (FindIntLastScalar(values, i, key));
+}
+
+/*
+*  Function: FindDoubleSse2()
+*  Four 2 lane compares a step.
+*/
+SSE2 static long
+FindDoubleSse2(const double values[], size_t count, double key)
+{
+	__m128d wanted = _mm_set1_pd(key);
+	unsigned int mask;
+	size_t i;
+	long found;
+
+	for (i = 0; i + STEP <= count; i += STEP)
+	{
+		mask = _mm_movemask_pd(_mm_cmpeq_pd(
+				_mm_loadu_pd(values + i), wanted)) |
+			_mm_movemask_pd(_mm_cmpeq_pd(
+				_mm_loadu_pd(values + i + 2), wanted)) << 2 |
+			_mm_movemask_pd(_mm_cmpeq_pd(
+				_mm_loadu_pd(values + i + 4), wanted)) << 4 |
+			_mm_movemask_pd(_mm_cmpeq_pd(
+				_mm_loadu_pd(values + i + 6), wanted)) << 6;
+		if (mask)
+			return ((long)(i + FIRST_BIT(mask)));
+	}
+
+	found = FindDoubleScalar(values + i, count - i, key);
+	return (found < 0 ? found : (long)i + found);
+}
+
+SSE2 static long
+FindDoubleLastSse2(const double values[], size_t count, double key)
+{
+	__m128d wanted = _mm_set1_pd(key);
+	const double *block;
+	unsigned int mask;
+	size_t i;
+
+	for (i = count; i >= STEP; i -= STEP)
+	{
+		block = values + i - STEP;
+		mask = _mm_movemask_pd(_mm_cmpeq_pd(
+				_mm_loadu_pd(block), wanted)) |
+			_mm_movemask_pd(_mm_cmpeq_pd(
+				_mm_loadu_pd(block + 2), wanted)) << 2 |
+			_mm_movemask_pd(_mm_cmpeq_pd(
+				_mm_loadu_pd(block + 4), wanted)) << 4 |
+			_mm_movemask_pd(_mm_cmpeq_pd(
+				_mm_loadu_pd(block + 6), wanted)) << 6;
+		if (mask)
+			return ((long)(i - STEP + LAST_BIT(mask)));
+	}
+
+	return (FindDoubleLastScalar(values, i, key));
+}
+
+/*
+*  Function: FindIntAvx2()
+*  One 8 lane compare a step, two steps at a time while they last.
+*/
+AVX2 static long
+FindIntAvx2(const int values[], size_t count, int key)
+{
+	__m256i wanted = _mm256_set1_epi32(key);
+	__m256i low, high;
+	unsigned int mask;
+	size_t i;
+	long found;
+
+	for (i = 0; i + 2 * STEP <= count; i += 2 * STEP)
+	{
+		low = _mm256_loadu_si256((const __m256i *)(values + i));
+		high = _mm256_loadu_si256((const __m256i *)(values + i + STEP));
+		mask = _mm256_movemask_ps(_mm256_castsi256_ps(
+				_mm256_cmpeq_epi32(low, wanted))) |
+			_mm256_movemask_ps(_mm256_castsi256_ps(
+				_mm256_cmpeq_epi32(high, wanted))) << STEP;
+		if (mask)
+			return ((long)(i + FIRST_BIT(mask)));
+	}
+
+	if (i + STEP <= count)
+	{
+		low = _mm256_loadu_si256((const __m256i *)(values + i));
+		mask = _mm256_movemask_ps(_mm256_castsi256_ps(
+				_mm256_cmpeq_epi32(low, wanted)));
+		if (mask)
+			return ((long)(i + FIRST_BIT(mask)));
+		i += STEP;
+	}
+
+	found = FindIntScalar(values + i, count - i, key);
+	return (found < 0 ? found : (long)i + found);
+}
+
+AVX2 static long
+FindIntLastAvx2(const int values[], size_t count, int key)
+{
+	__m256i wanted = _mm256_set1_epi32(key);
+	__m256i low, high;
+	unsigned int mask;
+	size_t i;
+
+	for (i = count; i >= 2 * STEP; i -= 2 * STEP)
+	{
+		low = _mm256_loadu_si256((const __m256i *)(values + i - 2 * STEP));
+		high = _mm256_loadu_si256((const __m256i *)(values + i - STEP));
+		mask = _mm256_movemask_ps(_mm256_castsi256_ps(
+				_mm256_cmpeq_epi32(low, wanted))) |
+			_mm256_movemask_ps(_mm256_castsi256_ps(
+				_mm256_cmpeq_epi32(high, wanted))) << STEP;
+		if (mask)
+			return ((long)(i - 2 * STEP + LAST_BIT(mask)));
+	}
+
+	if (i >= STEP)
+	{
+		low = _mm256_loadu_si256((const __m256i *)(values + i - STEP));
+		mask = _mm256_movemask_ps(_mm256_castsi256_ps(
+				_mm256_cmpeq_epi32(low, wanted)));
+		if (mask)
+			return ((long)(i - STEP + LAST_BIT(mask)));
+		i -= STEP;
+	}
+
+	return (FindIntLastScalar(values, i, key));
+}
+
+/*
+*  Function: FindDoubleAvx2()
+*  Two 4 lane compares a step.
+*/
+AVX2 static long
+FindDoubleAvx2(const double values[], size_t count, double key)
+{
+	__m256d wanted = _mm256_set1_pd(key);
+	unsigned int mask;
+	size_t i;
+	long found;
+
+	for (i = 0; i + STEP <= count; i += STEP)
+	{
+		mask = _mm256_movemask_pd(_mm256_cmp_pd(
+				_mm256_loadu_pd(values + i), wanted, _CMP_EQ_OQ)) |
+			_mm256_movemask_pd(_mm256_cmp_pd(
+				_mm256_loadu_pd(values + i + 4), wanted,
+				_CMP_EQ_OQ)) << 4;
+		if (mask)
+			return ((long)(i + FIRST_BIT(mask)));
+	}
+
+	found = FindDoubleScalar(values + i, count - i, key);
+	return (found < 0 ? found : (long)i + found);
+}
+
+AVX2 static long
+FindDoubleLastAvx2(const double values[], size_t count, double key)
+{
+	__m256d wanted = _mm256_set1_pd(key);
+	unsigned int mask;
+	size_t i;
+
+	for (i = count; i >= STEP; i -= STEP)
+	{
+		mask = _mm256_movemask_pd(_mm256_cmp_pd(
+				_mm256_loadu_pd(values + i - STEP), wanted,
+				_CMP_EQ_OQ)) |
+			_mm256_movemask_pd(_mm256_cmp_pd(
+				_mm256_loadu_pd(values + i - 4), wanted,
+				_CMP_EQ_OQ)) << 4;
+		if (mask)
+			return ((long)(i - STEP + LAST_BIT(mask)));
+	}
+
+	return (FindDoubleLastScalar(values, i, key));
+}
+
+#endif
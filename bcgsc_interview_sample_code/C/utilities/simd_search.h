@@ -0,0 +1,46 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for vectorised linear search of int and double
+*  arrays, for arrays too small (or searched too few times) to be worth
+*  building a search_index.c.  Each step compares 8 values at once and a
+*  movemask of the result finds the first (or last) match.
+*
+*	FindInt(), FindDouble()		Index of the first match, or -1.
+*	FindIntLast(), FindDoubleLast()	Index of the last match, or -1.
+*
+*  The kernel is chosen on the first call from what the CPU supports:
+*  AVX2, SSE2, or plain C on other machines.  Arrays of fewer than 8
+*  values always use plain C.  Doubles compare as ==, so a NaN key is
+*  never found and 0.0 finds -0.0.
+*  Compile together with simd_search.c (C11 atomics).
+*/
+
+#ifndef _SIMD_SEARCH_H_
+#define _SIMD_SEARCH_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIMD_SCALAR 0
+#define SIMD_SSE2 1
+#define SIMD_AVX2 2
+
+/* Function Prototypes */
+long FindInt(const int values[], size_t count, int key);
+long FindIntLast(const int values[], size_t count, int key);
+long FindDouble(const double values[], size_t count, double key);
+long FindDoubleLast(const double values[], size_t count, double key);
+
+/* For benchmarks: use a lower level than the CPU supports.  Returns the
+   level now in use.  Not safe while other threads are searching. */
+int SimdSearchSetLevel(int level);
+int SimdSearchLevel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1160 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Parallel introsort and LSD radix sort.  See sort_lib.h for
+*  the interface.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "thread_pool.h"
+#include "sort_lib.h"
+
+#define INSERTION_MAX 16		/* Pieces this small use insertion sort */
+#define INTRO_PARALLEL_MIN 8192		/* Smaller pieces are not worth a task */
+#define RADIX_PARALLEL_MIN 65536	/* Below this one thread does every pass */
+#define RADIX_BUCKETS 256
+#define SWAP_CHUNK 64
+#define PARTIAL_HEAP_SHARE 16		/* Heap if k <= count / this */
+
+/* The caller's comparison, with or without its extra argument */
+typedef struct sort_ctx {
+	SortCompare compare;
+	SortCompareArg compare_arg;
+	void *arg;
+} SortCtx;
+
+typedef struct intro_job {
+	ThreadPool *pool;
+	char *base;
+	size_t count;
+	size_t size;
+	const SortCtx *ctx;
+	int depth;
+} IntroJob;
+
+typedef struct radix_job {
+	const char *src;
+	char *dst;
+	size_t count;
+	size_t stride;		/* Item size in bytes, 4, 8 or 16 */
+	size_t width;		/* Key size in bytes, 4 or 8, at the item's start */
+	size_t chunk;		/* Items per chunk, the last may be short */
+	int digit;		/* Byte being sorted on this pass */
+	size_t (*counts)[8][RADIX_BUCKETS];	/* [chunk][digit][bucket] */
+} RadixJob;
+
+/* What SortByKeys() actually sorts, one per record */
+typedef struct key_index {
+	uint64_t key;
+	uint64_t index;		/* The record's position in the input */
+} KeyIndex;
+
+typedef struct gather_job {
+	char *dst;
+	const char *src;
+	size_t size;
+	KeyIndex *order;
+	size_t count;
+	size_t chunk;
+	const size_t *permutation;	/* Used in place of order if set */
+	const SortKeyFunc *keys;	/* Only used by FillKeys() */
+	int column;
+} GatherJob;
+
+/* Function Prototypes (local) */
+static int Compare(const SortCtx *ctx, const void *a, const void *b);
+static void StartIntro(void *base, size_t count, size_t size,
+	const SortCtx *ctx);
+static void SwapItems(char *a, char *b, size_t size);
+static void InsertionSort(char *base, size_t count, size_t size,
+	const SortCtx *ctx);
+static void SiftDown(char *base, size_t root, size_t count, size_t size,
+	const SortCtx *ctx);
+static void SiftUp(char *base, size_t child, size_t size,
+	const SortCtx *ctx);
+static void SortHeap(char *base, size_t count, size_t size,
+	const SortCtx *ctx);
+static void HeapSort(char *base, size_t count, size_t size,
+	const SortCtx *ctx);
+static size_t Partition(char *base, size_t count, size_t size,
+	const SortCtx *ctx);
+static void IntroSortLoop(ThreadPool *pool, char *base, size_t count,
+	size_t size, const SortCtx *ctx, int depth);
+static void IntroTask(void *arg);
+
+static unsigned DigitOf(const char *item, size_t width, int digit);
+static void RadixCountAll(void *arg, long low, long high);
+static void RadixCountDigit(void *arg, long low, long high);
+static void RadixScatter(void *arg, long low, long high);
+static void RunChunks(ThreadPool *pool, long chunks, RangeFunc func,
+	void *arg);
+static int RadixSortKeys(char *items, size_t count, size_t stride,
+	size_t width);
+static KeyIndex *RankByKeys(GatherJob *job, ThreadPool *pool, long chunks,
+	int num_keys);
+static long KeyChunks(size_t count, ThreadPool **pool);
+static void FillKeys(void *arg, long low, long high);
+static void GatherRecords(void *arg, long low, long high);
+
+static int CompareIntsUp(const void *a, const void *b);
+static int CompareIntsDown(const void *a, const void *b);
+static int CompareDoublesUp(const void *a, const void *b);
+static int CompareDoublesDown(const void *a, const void *b);
+
+
+/* *** Introsort *** */
+
+/*
+*  Function: SortIntro()
+*  Sorts count items of size bytes each.  Not stable.
+*/
+void
+SortIntro(void *base, size_t count, size_t size, SortCompare compare)
+{
+	SortCtx ctx;
+
+	ctx.compare = compare;
+	ctx.compare_arg = NULL;
+	ctx.arg = NULL;
+	StartIntro(base, count, size, &ctx);
+}
+
+/*
+*  Function: SortIntroArg()
+*  As SortIntro(), but arg is passed on to every compare() call.
+*/
+void
+SortIntroArg(void *base, size_t count, size_t size, SortCompareArg compare,
+	void *arg)
+{
+	SortCtx ctx;
+
+	ctx.compare = NULL;
+	ctx.compare_arg = compare;
+	ctx.arg = arg;
+	StartIntro(base, count, size, &ctx);
+}
+
+/*
+*  Function: StartIntro()
+*/
+static void
+StartIntro(void *base, size_t count, size_t size, const SortCtx *ctx)
+{
+	ThreadPool *pool = NULL;
+	int depth = 0;
+	size_t n;
+
+	if (count < 2 || size == 0)
+		return;
+
+	/* Quicksort gets 2 * log2(count) levels before heapsort takes over */
+	for (n = count; n > 1; n >>= 1)
+		depth += 2;
+
+	if (count >= 2 * INTRO_PARALLEL_MIN)
+	{
+		pool = PoolDefault();
+		if (pool != NULL && PoolNumThreads(pool) < 2)
+			pool = NULL;
+	}
+
+	IntroSortLoop(pool, (char *)base, count, size, ctx, depth);
+}
+
+/*
+*  Function: IntroSortLoop()
+*  Partitions, hands the smaller side to the pool (or recurses on it if
+*  it is small), and loops on the larger side, so the stack stays
+*  O(log n) deep.  Waits for its spawned pieces before returning.
+*/
+static void
+IntroSortLoop(ThreadPool *pool, char *base, size_t count, size_t size,
+	const SortCtx *ctx, int depth)
+{
+	TaskGroup group;
+	IntroJob *job;
+	size_t pivot, small_count;
+	char *small_base;
+
+	TaskGroupInit(&group);
+
+	while (count > INSERTION_MAX)
+	{
+		if (depth == 0)
+		{
+			HeapSort(base, count, size, ctx);
+			count = 0;
+			break;
+		}
+		depth--;
+
+		pivot = Partition(base, count, size, ctx);
+
+		if (pivot < count - pivot - 1)
+		{
+			small_base = base;
+			small_count = pivot;
+			base += (pivot + 1) * size;
+			count -= pivot + 1;
+		}
+		else
+		{
+			small_base = base + (pivot + 1) * size;
+			small_count = count - pivot - 1;
+			count = pivot;
+		}
+
+		job = NULL;
+		if (pool != NULL && small_count >= INTRO_PARALLEL_MIN)
+			job = (IntroJob *)malloc(sizeof(IntroJob));
+
+		if (job != NULL)
+		{
+			job->pool = pool;
+			job->base = small_base;
+			job->count = small_count;
+			job->size = size;
+			job->ctx = ctx;
+			job->depth = depth;
+			PoolSpawn(pool, &group, IntroTask, job);
+		}
+		else
+			IntroSortLoop(NULL, small_base, small_count, size, ctx,
+				depth);
+	}
+
+	if (count > 1)
+		InsertionSort(base, count, size, ctx);
+
+	if (pool != NULL)
+		PoolJoin(pool, &group);
+}
+
+/*
+*  Function: IntroTask()
+*/
+static void
+IntroTask(void *arg)
+{
+	IntroJob *job = (IntroJob *)arg;
+
+	IntroSortLoop(job->pool, job->base, job->count, job->size,
+		job->ctx, job->depth);
+	free(job);
+}
+
+/*
+*  Function: Partition()
+*  Moves the median of the first, middle and last items to the front and
+*  partitions around it.  Returns the pivot's final position: everything
+*  before it is <= the pivot, everything after it is >= the pivot.
+*  Equal keys stop both scans, so runs of duplicates split evenly.
+*/
+static size_t
+Partition(char *base, size_t count, size_t size, const SortCtx *ctx)
+{
+	char *first = base;
+	char *mid = base + (count / 2) * size;
+	char *last = base + (count - 1) * size;
+	size_t i, j;
+
+	if (Compare(ctx, mid, first) < 0)
+		SwapItems(mid, first, size);
+	if (Compare(ctx, last, mid) < 0)
+	{
+		SwapItems(last, mid, size);
+		if (Compare(ctx, mid, first) < 0)
+			SwapItems(mid, first, size);
+	}
+	SwapItems(first, mid, size);
+
+	/* The last item is >= the pivot and the pivot sits at the front, so
+	*  neither scan can run off the end. */
+	i = 1;
+	j = count - 1;
+	for (;;)
+	{
+		while (Compare(ctx, base + i * size, first) < 0)
+			i++;
+		while (Compare(ctx, base + j * size, first) > 0)
+			j--;
+		if (i >= j)
+			break;
+		SwapItems(base + i * size, base + j * size, size);
+		i++;
+		j--;
+	}
+
+	SwapItems(first, base + j * size, size);
+	return (j);
+}
+
+/*
+*  Function: InsertionSort()
+*/
+static void
+InsertionSort(char *base, size_t count, size_t size, const SortCtx *ctx)
+{
+	size_t i, j;
+
+	for (i = 1; i < count; i++)
+		for (j = i; j > 0 &&
+			Compare(ctx, base + (j - 1) * size, base + j * size) > 0; j--)
+			SwapItems(base + (j - 1) * size, base + j * size, size);
+}
+
+/*
+*  Function: HeapSort()
+*  The fallback when quicksort keeps picking bad pivots.
+*/
+static void
+HeapSort(char *base, size_t count, size_t size, const SortCtx *ctx)
+{
+	size_t i;
+
+	for (i = count / 2; i > 0; i--)
+		SiftDown(base, i - 1, count, size, ctx);
+
+	SortHeap(base, count, size, ctx);
+}
+
+/*
+*  Function: SortHeap()
+*  Turns a heap (largest at the root) into sorted order.
+*/
+static void
+SortHeap(char *base, size_t count, size_t size, const SortCtx *ctx)
+{
+	size_t i;
+
+	for (i = count; i > 1; i--)
+	{
+		SwapItems(base, base + (i - 1) * size, size);
+		SiftDown(base, 0, i - 1, size, ctx);
+	}
+}
+
+/*
+*  Function: SiftDown()
+*/
+static void
+SiftDown(char *base, size_t root, size_t count, size_t size,
+	const SortCtx *ctx)
+{
+	size_t child;
+
+	while ((child = 2 * root + 1) < count)
+	{
+		if (child + 1 < count &&
+			Compare(ctx, base + child * size,
+			base + (child + 1) * size) < 0)
+			child++;
+		if (Compare(ctx, base + root * size, base + child * size) >= 0)
+			return;
+		SwapItems(base + root * size, base + child * size, size);
+		root = child;
+	}
+}
+
+/*
+*  Function: SiftUp()
+*/
+static void
+SiftUp(char *base, size_t child, size_t size, const SortCtx *ctx)
+{
+	size_t parent;
+
+	while (child > 0)
+	{
+		parent = (child - 1) / 2;
+		if (Compare(ctx, base + parent * size, base + child * size) >= 0)
+			return;
+		SwapItems(base + parent * size, base + child * size, size);
+		child = parent;
+	}
+}
+
+/*
+*  Function: Compare()
+*/
+static int
+Compare(const SortCtx *ctx, const void *a, const void *b)
+{
+	if (ctx->compare != NULL)
+		return (ctx->compare(a, b));
+	return (ctx->compare_arg(a, b, ctx->arg));
+}
+
+/*
+*  Function: SwapItems()
+*/
+static void
+SwapItems(char *a, char *b, size_t size)
+{
+	char temp[SWAP_CHUNK];
+	size_t part;
+
+	while (size > 0)
+	{
+		part = size < SWAP_CHUNK ? size : SWAP_CHUNK;
+		memcpy(temp, a, part);
+		memcpy(a, b, part);
+		memcpy(b, temp, part);
+		a += part;
+		b += part;
+		size -= part;
+	}
+}
+
+
+/* *** Selection *** */
+
+/*
+*  Function: SortSelect()
+*  Quickselect: partition, then carry on into the side holding nth only.
+*  Falls back to heapsort of the piece left if the pivots keep being bad.
+*/
+void
+SortSelect(void *base, size_t count, size_t size, size_t nth,
+	SortCompare compare)
+{
+	char *items = (char *)base;
+	SortCtx ctx;
+	size_t pivot, n;
+	int depth = 0;
+
+	if (nth >= count || size == 0)
+		return;
+
+	ctx.compare = compare;
+	ctx.compare_arg = NULL;
+	ctx.arg = NULL;
+
+	for (n = count; n > 1; n >>= 1)
+		depth += 2;
+
+	while (count > INSERTION_MAX)
+	{
+		if (depth-- == 0)
+		{
+			HeapSort(items, count, size, &ctx);
+			return;
+		}
+
+		pivot = Partition(items, count, size, &ctx);
+		if (nth == pivot)
+			return;
+		if (nth < pivot)
+			count = pivot;
+		else
+		{
+			items += (pivot + 1) * size;
+			nth -= pivot + 1;
+			count -= pivot + 1;
+		}
+	}
+
+	InsertionSort(items, count, size, &ctx);
+}
+
+/*
+*  Function: SortPartial()
+*  For small k the first k items are made a heap (largest at the root),
+*  and each later item smaller than the root replaces it.  For larger k
+*  it is cheaper to SortSelect() the k-th and sort the k before it.
+*/
+void
+SortPartial(void *base, size_t count, size_t size, size_t k,
+	SortCompare compare)
+{
+	char *items = (char *)base;
+	SortCtx ctx;
+	size_t i;
+
+	if (k > count)
+		k = count;
+	if (k == 0 || size == 0)
+		return;
+
+	ctx.compare = compare;
+	ctx.compare_arg = NULL;
+	ctx.arg = NULL;
+
+	if (k > count / PARTIAL_HEAP_SHARE)
+	{
+		SortSelect(base, count, size, k - 1, compare);
+		StartIntro(base, k - 1, size, &ctx);
+		return;
+	}
+
+	for (i = k / 2; i > 0; i--)
+		SiftDown(items, i - 1, k, size, &ctx);
+
+	for (i = k; i < count; i++)
+		if (Compare(&ctx, items + i * size, items) < 0)
+		{
+			SwapItems(items, items + i * size, size);
+			SiftDown(items, 0, k, size, &ctx);
+		}
+
+	SortHeap(items, k, size, &ctx);
+}
+
+/*
+*  Function: SortTopInit()
+*  Starts a running top k of items of size bytes: the k that compare()
+*  puts first.  Returns 1, or 0 if memory ran out.
+*/
+int
+SortTopInit(SortTop *top, size_t k, size_t size, SortCompare compare)
+{
+	top->items = (char *)malloc(k * size > 0 ? k * size : 1);
+	top->count = 0;
+	top->k = k;
+	top->size = size;
+	top->compare = compare;
+	return (top->items != NULL);
+}
+
+/*
+*  Function: SortTopAdd()
+*  Copies item in if it is among the best k so far.  O(log k).
+*/
+void
+SortTopAdd(SortTop *top, const void *item)
+{
+	SortCtx ctx;
+
+	ctx.compare = top->compare;
+	ctx.compare_arg = NULL;
+	ctx.arg = NULL;
+
+	if (top->count < top->k)
+	{
+		memcpy(top->items + top->count * top->size, item, top->size);
+		SiftUp(top->items, top->count, top->size, &ctx);
+		top->count++;
+	}
+	else if (top->k > 0 && Compare(&ctx, item, top->items) < 0)
+	{
+		memcpy(top->items, item, top->size);
+		SiftDown(top->items, 0, top->k, top->size, &ctx);
+	}
+}
+
+/*
+*  Function: SortTopFinish()
+*  Sorts the items held and returns them, setting count.  They belong to
+*  top and last until SortTopFree().  Call it once, after the last add.
+*/
+void *
+SortTopFinish(SortTop *top, size_t *count)
+{
+	SortCtx ctx;
+
+	ctx.compare = top->compare;
+	ctx.compare_arg = NULL;
+	ctx.arg = NULL;
+
+	SortHeap(top->items, top->count, top->size, &ctx);
+	*count = top->count;
+	return (top->items);
+}
+
+/*
+*  Function: SortTopFree()
+*/
+void
+SortTopFree(SortTop *top)
+{
+	free(top->items);
+	top->items = NULL;
+	top->count = 0;
+}
+
+
+/* *** Radix sort *** */
+
+/*
+*  Function: SortInts()
+*  Flips the sign bit so the ints order as unsigned numbers (and inverts
+*  every bit for descending), radix sorts, then flips them back.
+*/
+void
+SortInts(int *items, size_t count, int order)
+{
+	uint32_t flip = (order == SORT_DESCENDING) ? 0x7FFFFFFFu : 0x80000000u;
+	uint32_t *keys = (uint32_t *)items;
+	size_t i;
+
+	if (count < 2)
+		return;
+
+	for (i = 0; i < count; i++)
+		keys[i] ^= flip;
+
+	if (!RadixSortKeys((char *)keys, count, sizeof(uint32_t),
+		sizeof(uint32_t)))
+	{
+		for (i = 0; i < count; i++)
+			keys[i] ^= flip;
+		SortIntro(items, count, sizeof(int),
+			order == SORT_DESCENDING ? CompareIntsDown : CompareIntsUp);
+		return;
+	}
+
+	for (i = 0; i < count; i++)
+		keys[i] ^= flip;
+}
+
+/*
+*  Function: SortDoubles()
+*  Radix sorts the SortKeyDouble() keys in place of the doubles, then
+*  turns them back.
+*/
+void
+SortDoubles(double *items, size_t count, int order)
+{
+	const uint64_t sign = (uint64_t)1 << 63;
+	uint64_t bits;
+	size_t i;
+
+	if (count < 2)
+		return;
+
+	for (i = 0; i < count; i++)
+	{
+		bits = SortKeyDouble(items[i]);
+		if (order == SORT_DESCENDING)
+			bits = ~bits;
+		memcpy(&items[i], &bits, sizeof(bits));
+	}
+
+	if (!RadixSortKeys((char *)items, count, sizeof(uint64_t),
+		sizeof(uint64_t)))
+	{
+		for (i = 0; i < count; i++)
+		{
+			memcpy(&bits, &items[i], sizeof(bits));
+			if (order == SORT_DESCENDING)
+				bits = ~bits;
+			bits = (bits & sign) ? (bits & ~sign) : ~bits;
+			memcpy(&items[i], &bits, sizeof(bits));
+		}
+		SortIntro(items, count, sizeof(double), order == SORT_DESCENDING ?
+			CompareDoublesDown : CompareDoublesUp);
+		return;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		memcpy(&bits, &items[i], sizeof(bits));
+		if (order == SORT_DESCENDING)
+			bits = ~bits;
+		bits = (bits & sign) ? (bits & ~sign) : ~bits;
+		memcpy(&items[i], &bits, sizeof(bits));
+	}
+}
+
+/*
+*  Function: SortKeyInt()
+*  Flipping the sign bit makes ints order as unsigned numbers.
+*/
+uint64_t
+SortKeyInt(int value)
+{
+	return ((uint64_t)((uint32_t)value ^ 0x80000000u));
+}
+
+/*
+*  Function: SortKeyDouble()
+*  IEEE doubles order as unsigned numbers once negative values have every
+*  bit inverted and positive values have the sign bit set.  NaNs end up
+*  at the two ends.
+*/
+uint64_t
+SortKeyDouble(double value)
+{
+	const uint64_t sign = (uint64_t)1 << 63;
+	uint64_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+	return ((bits & sign) ? ~bits : (bits | sign));
+}
+
+/*
+*  Function: SortByKeys()
+*  Stable sort of count records of size bytes by several key columns,
+*  keys[0] the most significant.  RankByKeys() works out the order from
+*  (key, position) pairs alone, then the records themselves are moved,
+*  once.  For an array of pointers to records the keys are read from each
+*  record just once, rather than at every comparison.  Returns 1, or 0 if
+*  memory ran out (the records are then untouched).
+*/
+int
+SortByKeys(void *base, size_t count, size_t size, const SortKeyFunc keys[],
+	int num_keys)
+{
+	ThreadPool *pool = NULL;
+	GatherJob job;
+	char *scratch;
+	long chunks;
+
+	if (count < 2 || num_keys < 1)
+		return (1);
+
+	chunks = KeyChunks(count, &pool);
+	job.src = (const char *)base;
+	job.size = size;
+	job.count = count;
+	job.chunk = (count + chunks - 1) / chunks;
+	job.permutation = NULL;
+	job.keys = keys;
+
+	scratch = (char *)malloc(count * size);
+	if (scratch == NULL || !RankByKeys(&job, pool, chunks, num_keys))
+	{
+		free(scratch);
+		return (0);
+	}
+
+	job.dst = scratch;
+	RunChunks(pool, chunks, GatherRecords, &job);
+	memcpy(base, scratch, count * size);
+
+	free(scratch);
+	free(job.order);
+	return (1);
+}
+
+/*
+*  Function: SortOrder()
+*  As SortByKeys(), but the records are left alone: order[i] is set to
+*  the position of the record that sorts i-th.  Returns 0 if memory ran
+*  out.
+*/
+int
+SortOrder(const void *base, size_t count, size_t size,
+	const SortKeyFunc keys[], int num_keys, size_t order[])
+{
+	ThreadPool *pool = NULL;
+	GatherJob job;
+	long chunks;
+	size_t i;
+
+	if (count < 2 || num_keys < 1)
+	{
+		for (i = 0; i < count; i++)
+			order[i] = i;
+		return (1);
+	}
+
+	chunks = KeyChunks(count, &pool);
+	job.src = (const char *)base;
+	job.size = size;
+	job.count = count;
+	job.chunk = (count + chunks - 1) / chunks;
+	job.permutation = NULL;
+	job.keys = keys;
+
+	if (!RankByKeys(&job, pool, chunks, num_keys))
+		return (0);
+
+	for (i = 0; i < count; i++)
+		order[i] = (size_t)job.order[i].index;
+
+	free(job.order);
+	return (1);
+}
+
+/*
+*  Function: SortApplyOrder()
+*  Rearranges count records of size bytes so the one at order[i] ends up
+*  at i.  order may come from SortOrder() on a different array, such as
+*  a parallel array of keys.  Returns 0 if memory ran out.
+*/
+int
+SortApplyOrder(void *base, size_t count, size_t size, const size_t order[])
+{
+	ThreadPool *pool = NULL;
+	GatherJob job;
+	char *scratch;
+	long chunks;
+
+	if (count < 2)
+		return (1);
+
+	scratch = (char *)malloc(count * size);
+	if (scratch == NULL)
+		return (0);
+
+	chunks = KeyChunks(count, &pool);
+	job.dst = scratch;
+	job.src = (const char *)base;
+	job.size = size;
+	job.order = NULL;
+	job.permutation = order;
+	job.count = count;
+	job.chunk = (count + chunks - 1) / chunks;
+	RunChunks(pool, chunks, GatherRecords, &job);
+	memcpy(base, scratch, count * size);
+
+	free(scratch);
+	return (1);
+}
+
+/*
+*  Function: RankByKeys()
+*  Pairs each record's position with one column's key at a time and
+*  radix sorts the pairs, from the least significant column to the most
+*  (each pass is stable, so ties keep the order of the column before).
+*  Sets job->order to the sorted pairs, to be freed, and returns them, or
+*  NULL if memory ran out.
+*/
+static KeyIndex *
+RankByKeys(GatherJob *job, ThreadPool *pool, long chunks, int num_keys)
+{
+	KeyIndex *order;
+	size_t i;
+
+	order = (KeyIndex *)malloc(job->count * sizeof(KeyIndex));
+	job->order = order;
+	if (order == NULL)
+		return (NULL);
+
+	for (i = 0; i < job->count; i++)
+		order[i].index = i;
+
+	for (job->column = num_keys - 1; job->column >= 0; job->column--)
+	{
+		RunChunks(pool, chunks, FillKeys, job);
+		if (!RadixSortKeys((char *)order, job->count, sizeof(KeyIndex),
+			sizeof(uint64_t)))
+		{
+			free(order);
+			job->order = NULL;
+			return (NULL);
+		}
+	}
+	return (order);
+}
+
+/*
+*  Function: KeyChunks()
+*  How many pieces to split count records into, and the pool for them.
+*/
+static long
+KeyChunks(size_t count, ThreadPool **pool)
+{
+	long chunks = 1;
+
+	*pool = NULL;
+	if (count >= RADIX_PARALLEL_MIN)
+	{
+		*pool = PoolDefault();
+		if (*pool != NULL)
+			chunks = PoolNumThreads(*pool);
+		if (chunks < 1)
+			chunks = 1;
+	}
+	return (chunks);
+}
+
+/*
+*  Function: RadixSortKeys()
+*  Sorts count items of stride bytes by the unsigned key of width 4 or 8
+*  bytes at the start of each item, least significant byte first.  The keys are cut into one chunk per thread.  Each pass
+*  counts every chunk's digits, turns the counts into each chunk's write
+*  position per bucket, then every chunk scatters its own items, which
+*  keeps each pass stable.  Returns 0 if the scratch memory could not be
+*  had (the items are then untouched).
+*/
+static int
+RadixSortKeys(char *items, size_t count, size_t stride, size_t width)
+{
+	ThreadPool *pool = NULL;
+	RadixJob job;
+	char *scratch;
+	char *temp;
+	long chunks = 1;
+	long c;
+	int digit, counted;
+	size_t bucket, total, pos;
+
+	if (count >= RADIX_PARALLEL_MIN)
+	{
+		pool = PoolDefault();
+		if (pool != NULL)
+			chunks = PoolNumThreads(pool);
+		if (chunks < 1)
+			chunks = 1;
+	}
+
+	scratch = (char *)malloc(count * stride);
+	job.counts = calloc(chunks, sizeof(*job.counts));
+	if (scratch == NULL || job.counts == NULL)
+	{
+		free(scratch);
+		free(job.counts);
+		return (0);
+	}
+
+	job.src = items;
+	job.dst = scratch;
+	job.count = count;
+	job.stride = stride;
+	job.width = width;
+	job.chunk = (count + chunks - 1) / chunks;
+
+	/* One read to count every digit, so constant digits can be skipped */
+	RunChunks(pool, chunks, RadixCountAll, &job);
+	counted = 1;
+
+	for (digit = 0; digit < (int)width; digit++)
+	{
+		job.digit = digit;
+
+		for (bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+		{
+			total = 0;
+			for (c = 0; c < chunks; c++)
+				total += job.counts[c][digit][bucket];
+			if (total != 0)
+				break;
+		}
+		if (total == count)
+			continue;	/* Every key has the same byte here */
+
+		/* The first pass can use the counts made above, later passes
+		*  have moved the keys between chunks and must count again. */
+		if (!counted)
+			RunChunks(pool, chunks, RadixCountDigit, &job);
+		counted = 0;
+
+		pos = 0;
+		for (bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+			for (c = 0; c < chunks; c++)
+			{
+				total = job.counts[c][digit][bucket];
+				job.counts[c][digit][bucket] = pos;
+				pos += total;
+			}
+
+		RunChunks(pool, chunks, RadixScatter, &job);
+
+		temp = (char *)job.src;
+		job.src = job.dst;
+		job.dst = temp;
+	}
+
+	if (job.src != items)
+		memcpy(items, job.src, count * stride);
+
+	free(scratch);
+	free(job.counts);
+	return (1);
+}
+
+/*
+*  Function: DigitOf()
+*/
+static unsigned
+DigitOf(const char *item, size_t width, int digit)
+{
+	uint32_t key32;
+	uint64_t key64;
+
+	if (width == 4)
+	{
+		memcpy(&key32, item, 4);
+		return ((key32 >> (digit * 8)) & 0xFF);
+	}
+	memcpy(&key64, item, 8);
+	return ((unsigned)(key64 >> (digit * 8)) & 0xFF);
+}
+
+/*
+*  Function: RadixCountAll()
+*  Counts every digit of chunks [low, high).
+*/
+static void
+RadixCountAll(void *arg, long low, long high)
+{
+	RadixJob *job = (RadixJob *)arg;
+	size_t i, end;
+	const char *item;
+	int d;
+	long c;
+
+	for (c = low; c < high; c++)
+	{
+		end = (c + 1) * job->chunk;
+		if (end > job->count)
+			end = job->count;
+
+		for (i = c * job->chunk; i < end; i++)
+		{
+			item = job->src + i * job->stride;
+			for (d = 0; d < (int)job->width; d++)
+				job->counts[c][d][DigitOf(item, job->width, d)]++;
+		}
+	}
+}
+
+/*
+*  Function: RadixCountDigit()
+*  Counts this pass's digit of chunks [low, high).
+*/
+static void
+RadixCountDigit(void *arg, long low, long high)
+{
+	RadixJob *job = (RadixJob *)arg;
+	size_t *counts;
+	size_t i, end;
+	long c;
+
+	for (c = low; c < high; c++)
+	{
+		counts = job->counts[c][job->digit];
+		memset(counts, 0, RADIX_BUCKETS * sizeof(size_t));
+
+		end = (c + 1) * job->chunk;
+		if (end > job->count)
+			end = job->count;
+
+		for (i = c * job->chunk; i < end; i++)
+			counts[DigitOf(job->src + i * job->stride, job->width,
+				job->digit)]++;
+	}
+}
+
+/*
+*  Function: RadixScatter()
+*  Moves the items of chunks [low, high) to their places for this pass.
+*/
+static void
+RadixScatter(void *arg, long low, long high)
+{
+	RadixJob *job = (RadixJob *)arg;
+	size_t *next;
+	const char *item;
+	size_t i, end;
+	long c;
+
+	for (c = low; c < high; c++)
+	{
+		next = job->counts[c][job->digit];
+
+		end = (c + 1) * job->chunk;
+		if (end > job->count)
+			end = job->count;
+
+		/* Fixed size copies, so each memcpy() is a plain move */
+		if (job->stride == 4)
+			for (i = c * job->chunk; i < end; i++)
+			{
+				item = job->src + i * 4;
+				memcpy(job->dst + next[DigitOf(item, 4, job->digit)]++ * 4,
+					item, 4);
+			}
+		else if (job->stride == 8)
+			for (i = c * job->chunk; i < end; i++)
+			{
+				item = job->src + i * 8;
+				memcpy(job->dst + next[DigitOf(item, 8, job->digit)]++ * 8,
+					item, 8);
+			}
+		else
+			for (i = c * job->chunk; i < end; i++)
+			{
+				item = job->src + i * 16;
+				memcpy(job->dst + next[DigitOf(item, 8, job->digit)]++ * 16,
+					item, 16);
+			}
+	}
+}
+
+/*
+*  Function: FillKeys()
+*  Works out the current column's key for chunks [low, high) of the
+*  (key, position) pairs.
+*/
+static void
+FillKeys(void *arg, long low, long high)
+{
+	GatherJob *job = (GatherJob *)arg;
+	KeyIndex *order = job->order;
+	SortKeyFunc key = job->keys[job->column];
+	size_t i, end;
+
+	end = high * job->chunk;
+	if (end > job->count)
+		end = job->count;
+
+	for (i = low * job->chunk; i < end; i++)
+		order[i].key = key(job->src + order[i].index * job->size);
+}
+
+/*
+*  Function: GatherRecords()
+*  Copies the records for chunks [low, high) of the sorted pairs into
+*  their new places.
+*/
+static void
+GatherRecords(void *arg, long low, long high)
+{
+	GatherJob *job = (GatherJob *)arg;
+	size_t i, end;
+
+	end = high * job->chunk;
+	if (end > job->count)
+		end = job->count;
+
+	for (i = low * job->chunk; i < end; i++)
+		memcpy(job->dst + i * job->size, job->src + job->size *
+			(job->permutation ? job->permutation[i] : job->order[i].index),
+			job->size);
+}
+
+/*
+*  Function: RunChunks()
+*/
+static void
+RunChunks(ThreadPool *pool, long chunks, RangeFunc func, void *arg)
+{
+	if (pool == NULL || chunks == 1)
+		func(arg, 0, chunks);
+	else
+		PoolParallelFor(pool, 0, chunks, 1, func, arg);
+}
+
+
+/* *** Comparisons for the fallback *** */
+
+static int
+CompareIntsUp(const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+	return ((x > y) - (x < y));
+}
+
+static int
+CompareIntsDown(const void *a, const void *b)
+{
+	return (CompareIntsUp(b, a));
+}
+
+static int
+CompareDoublesUp(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	return ((x > y) - (x < y));
+}
+
+static int
+CompareDoublesDown(const void *a, const void *b)
+{
+	return (CompareDoublesUp(b, a));
+}
@@ -0,0 +1,104 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for the shared sorting library.  Replaces the
+*  selection and bubble sorts of the sample programs with:
+*
+*	SortIntro()	Any array, any comparison (same arguments as qsort()).
+*			Introsort: quicksort with median of three pivots,
+*			heapsort if the recursion goes too deep, insertion
+*			sort for small pieces.  Large pieces are sorted in
+*			parallel on the default thread pool (thread_pool.c).
+*	SortIntroArg()	The same, passing an extra argument to compare().
+*	SortInts()	int and double arrays, ascending or descending.
+*	SortDoubles()	LSD radix sort, one byte per pass, passes where every
+*			key has the same byte are skipped.  Each pass is split
+*			across the pool.  Needs a scratch array the size of
+*			the input, falls back to SortIntro() without it.
+*	SortByKeys()	Records of any size, ordered by one or more key
+*			columns.  Stable.  Each column is a function giving a
+*			64 bit unsigned key for a record, SortKeyInt() and
+*			SortKeyDouble() turn numbers into keys that keep
+*			their order (use ~key for a descending column).
+*			Radix sorted, so linear in the number of records.
+*			Good for arrays of pointers to records: each record
+*			is read once for its keys, not at every comparison.
+*	SortOrder()	The order SortByKeys() would give, as a permutation,
+*	SortApplyOrder()  and the moves to put any array into that order.
+*
+*  Selection, for when only part of the order is wanted:
+*
+*	SortSelect()	Puts the item that would be at position nth in place,
+*			smaller ones before it, larger ones after (like C++
+*			nth_element).  Quickselect, O(n) on average.
+*	SortPartial()	Sorts just the k smallest items into the first k
+*			places.  A k item heap, O(n log k).
+*	SortTop...()	The k smallest of a stream of items of unknown
+*			length, keeping only k of them in memory.  Use a
+*			reversed compare() for the k largest.
+*
+*  Compile with -pthread and C11 atomics, together with thread_pool.c and
+*  work_deque.c.
+*/
+
+#ifndef _SORT_LIB_H_
+#define _SORT_LIB_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SORT_ASCENDING 0
+#define SORT_DESCENDING 1
+
+/* Returns < 0, 0 or > 0 as *a sorts before, with or after *b */
+typedef int (*SortCompare)(const void *a, const void *b);
+
+/* The same, with the extra argument given to SortIntroArg() */
+typedef int (*SortCompareArg)(const void *a, const void *b, void *arg);
+
+/* Returns the sort key of the record at item */
+typedef uint64_t (*SortKeyFunc)(const void *item);
+
+/* The best k items seen so far, see SortTopInit() */
+typedef struct sort_top {
+	char *items;		/* A heap with the worst of them at the root */
+	size_t count;		/* Items held, at most k */
+	size_t k;
+	size_t size;
+	SortCompare compare;
+} SortTop;
+
+/* Function Prototypes */
+void SortIntro(void *base, size_t count, size_t size, SortCompare compare);
+void SortIntroArg(void *base, size_t count, size_t size,
+	SortCompareArg compare, void *arg);
+void SortInts(int *items, size_t count, int order);
+void SortDoubles(double *items, size_t count, int order);
+
+int SortByKeys(void *base, size_t count, size_t size, const SortKeyFunc keys[],
+	int num_keys);
+int SortOrder(const void *base, size_t count, size_t size,
+	const SortKeyFunc keys[], int num_keys, size_t order[]);
+int SortApplyOrder(void *base, size_t count, size_t size,
+	const size_t order[]);
+uint64_t SortKeyInt(int value);
+uint64_t SortKeyDouble(double value);
+
+void SortSelect(void *base, size_t count, size_t size, size_t nth,
+	SortCompare compare);
+void SortPartial(void *base, size_t count, size_t size, size_t k,
+	SortCompare compare);
+
+int SortTopInit(SortTop *top, size_t k, size_t size, SortCompare compare);
+void SortTopAdd(SortTop *top, const void *item);
+void *SortTopFinish(SortTop *top, size_t *count);
+void SortTopFree(SortTop *top);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,342 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: String sort by MSD radix and multikey quicksort.  See
+*  string_sort.h for the interface.
+*
+*  Work is a stack of groups: a range of the array whose strings are
+*  known to agree on their first 'depth' characters.  Taking a group, its
+*  strings' characters at depth go into cache[], then the group is split
+*  on that character and the pieces pushed back, with depth + 1 for the
+*  pieces whose character matched.  A piece whose character was '\0' is
+*  finished: its strings are all equal.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "dyn_stack.h"
+#include "thread_pool.h"
+#include "string_sort.h"
+
+#define INSERTION_MAX 16	/* Groups this small use insertion sort */
+#define RADIX_MIN 1024		/* Groups this big use radix sort */
+#define PARALLEL_MIN 65536	/* Buckets this big become pool tasks */
+#define BUCKETS 256
+
+typedef struct group {
+	size_t first;		/* Range of the array */
+	size_t count;
+	size_t depth;		/* Characters already known to agree */
+	int cached;		/* cache[] already holds the depth characters */
+} Group;
+
+/* Shared by every task; each task works on its own ranges of them */
+typedef struct string_arrays {
+	char **strings;
+	char **aux;		/* Scatter space for the radix sort */
+	unsigned char *cache;	/* Character at depth of each string */
+	ThreadPool *pool;	/* NULL to stay on this thread */
+} StringArrays;
+
+typedef struct string_job {
+	const StringArrays *arrays;
+	Group group;
+} StringJob;
+
+/* Function Prototypes (local) */
+static void SortGroups(const StringArrays *arrays, Group start);
+static void SortTask(void *arg);
+static void FillCache(const StringArrays *arrays, const Group *group);
+static void RadixSplit(const StringArrays *arrays, const Group *group,
+	DynStack *stack, TaskGroup *tasks);
+static void QuickSplit(const StringArrays *arrays, const Group *group,
+	DynStack *stack);
+static void InsertionSort(char **strings, size_t count, size_t depth);
+static void PushGroup(const StringArrays *arrays, DynStack *stack,
+	TaskGroup *tasks, size_t first, size_t count, size_t depth, int cached);
+
+/*
+*  Function: SortStrings()
+*  Returns 1, or 0 if memory ran out (the array is then untouched).
+*/
+int
+SortStrings(char *strings[], size_t count)
+{
+	StringArrays arrays;
+	Group all;
+
+	if (count < 2)
+		return (1);
+
+	arrays.strings = strings;
+	arrays.aux = (char **)malloc(count * sizeof(char *));
+	arrays.cache = (unsigned char *)malloc(count);
+	if (arrays.aux == NULL || arrays.cache == NULL)
+	{
+		free(arrays.aux);
+		free(arrays.cache);
+		return (0);
+	}
+
+	arrays.pool = NULL;
+	if (count >= 2 * PARALLEL_MIN)
+	{
+		arrays.pool = PoolDefault();
+		if (arrays.pool != NULL && PoolNumThreads(arrays.pool) < 2)
+			arrays.pool = NULL;
+	}
+
+	all.first = 0;
+	all.count = count;
+	all.depth = 0;
+	all.cached = 0;
+	SortGroups(&arrays, all);
+
+	free(arrays.aux);
+	free(arrays.cache);
+	return (1);
+}
+
+/*
+*  Function: SortGroups()
+*  Sorts the group start and every piece it splits into, except the big
+*  buckets handed to the pool, which it waits for.  A piece that cannot
+*  be pushed for lack of memory is sorted on the spot instead.
+*/
+static void
+SortGroups(const StringArrays *arrays, Group start)
+{
+	DynStack stack;
+	TaskGroup tasks;
+	Group group;
+
+	DynStackInit(&stack, sizeof(Group));
+	TaskGroupInit(&tasks);
+	group = start;
+
+	for (;;)
+	{
+		if (group.count <= INSERTION_MAX)
+			InsertionSort(arrays->strings + group.first, group.count,
+				group.depth);
+		else
+		{
+			if (!group.cached)
+				FillCache(arrays, &group);
+			if (group.count >= RADIX_MIN)
+				RadixSplit(arrays, &group, &stack, &tasks);
+			else
+				QuickSplit(arrays, &group, &stack);
+		}
+
+		if (!DynStackPop(&stack, &group))
+			break;
+	}
+
+	if (arrays->pool != NULL)
+		PoolJoin(arrays->pool, &tasks);
+	DynStackFree(&stack);
+}
+
+/*
+*  Function: SortTask()
+*/
+static void
+SortTask(void *arg)
+{
+	StringJob *job = (StringJob *)arg;
+
+	SortGroups(job->arrays, job->group);
+	free(job);
+}
+
+/*
+*  Function: FillCache()
+*/
+static void
+FillCache(const StringArrays *arrays, const Group *group)
+{
+	char **strings = arrays->strings + group->first;
+	unsigned char *cache = arrays->cache + group->first;
+	size_t i;
+
+	for (i = 0; i < group->count; i++)
+		cache[i] = (unsigned char)strings[i][group->depth];
+}
+
+/*
+*  Function: RadixSplit()
+*  Counts the characters, scatters the pointers to their buckets through
+*  aux[], and pushes every bucket but '\0' one character deeper.
+*/
+static void
+RadixSplit(const StringArrays *arrays, const Group *group, DynStack *stack,
+	TaskGroup *tasks)
+{
+	char **strings = arrays->strings + group->first;
+	char **aux = arrays->aux + group->first;
+	const unsigned char *cache = arrays->cache + group->first;
+	size_t counts[BUCKETS];
+	size_t next[BUCKETS];
+	size_t i, position;
+	int b;
+
+	memset(counts, 0, sizeof(counts));
+	for (i = 0; i < group->count; i++)
+		counts[cache[i]]++;
+
+	/* Every string has the same character here: nothing to move */
+	if (counts[cache[0]] == group->count)
+	{
+		if (cache[0] != '\0')
+			PushGroup(arrays, stack, tasks, group->first, group->count,
+				group->depth + 1, 0);
+		return;
+	}
+
+	position = 0;
+	for (b = 0; b < BUCKETS; b++)
+	{
+		next[b] = position;
+		position += counts[b];
+	}
+
+	for (i = 0; i < group->count; i++)
+		aux[next[cache[i]]++] = strings[i];
+	memcpy(strings, aux, group->count * sizeof(char *));
+
+	position = counts[0];
+	for (b = 1; b < BUCKETS; b++)
+	{
+		if (counts[b] > 1)
+			PushGroup(arrays, stack, tasks, group->first + position,
+				counts[b], group->depth + 1, 0);
+		position += counts[b];
+	}
+}
+
+/*
+*  Function: QuickSplit()
+*  Three way partition on the median of three characters: less, equal
+*  and greater.  The less and greater parts keep their cached characters
+*  (same depth), the equal part goes one character deeper.
+*/
+static void
+QuickSplit(const StringArrays *arrays, const Group *group, DynStack *stack)
+{
+	char **strings = arrays->strings + group->first;
+	unsigned char *cache = arrays->cache + group->first;
+	size_t n = group->count;
+	size_t less = 0, i = 0, greater = n;
+	unsigned char a, b, c, pivot, ch;
+	char *temp;
+	Group piece;
+
+	a = cache[0];
+	b = cache[n / 2];
+	c = cache[n - 1];
+	pivot = (a < b) ? ((b < c) ? b : (a < c) ? c : a) :
+		((a < c) ? a : (b < c) ? c : b);
+
+	while (i < greater)
+	{
+		ch = cache[i];
+		if (ch < pivot)
+		{
+			temp = strings[i];
+			strings[i] = strings[less];
+			strings[less] = temp;
+			cache[i] = cache[less];
+			cache[less] = ch;
+			less++;
+			i++;
+		}
+		else if (ch > pivot)
+		{
+			greater--;
+			temp = strings[i];
+			strings[i] = strings[greater];
+			strings[greater] = temp;
+			cache[i] = cache[greater];
+			cache[greater] = ch;
+		}
+		else
+			i++;
+	}
+
+	piece.depth = group->depth;
+	piece.cached = 1;
+	if (less > 1)
+	{
+		piece.first = group->first;
+		piece.count = less;
+		if (!DynStackPush(stack, &piece))
+			SortGroups(arrays, piece);
+	}
+	if (n - greater > 1)
+	{
+		piece.first = group->first + greater;
+		piece.count = n - greater;
+		if (!DynStackPush(stack, &piece))
+			SortGroups(arrays, piece);
+	}
+	if (pivot != '\0' && greater - less > 1)
+	{
+		piece.first = group->first + less;
+		piece.count = greater - less;
+		piece.depth = group->depth + 1;
+		piece.cached = 0;
+		if (!DynStackPush(stack, &piece))
+			SortGroups(arrays, piece);
+	}
+}
+
+/*
+*  Function: PushGroup()
+*  Queues a piece: as a pool task if it is big enough, otherwise on this
+*  thread's stack.
+*/
+static void
+PushGroup(const StringArrays *arrays, DynStack *stack, TaskGroup *tasks,
+	size_t first, size_t count, size_t depth, int cached)
+{
+	StringJob *job = NULL;
+	Group piece;
+
+	piece.first = first;
+	piece.count = count;
+	piece.depth = depth;
+	piece.cached = cached;
+
+	if (arrays->pool != NULL && count >= PARALLEL_MIN)
+		job = (StringJob *)malloc(sizeof(StringJob));
+
+	if (job != NULL)
+	{
+		job->arrays = arrays;
+		job->group = piece;
+		PoolSpawn(arrays->pool, tasks, SortTask, job);
+	}
+	else if (!DynStackPush(stack, &piece))
+		SortGroups(arrays, piece);
+}
+
+/*
+*  Function: InsertionSort()
+*  The strings agree on their first depth characters, so only the rest
+*  are compared.
+*/
+static void
+InsertionSort(char **strings, size_t count, size_t depth)
+{
+	size_t i, j;
+	char *item;
+
+	for (i = 1; i < count; i++)
+	{
+		item = strings[i];
+		for (j = i; j > 0 && strcmp(strings[j - 1] + depth, item + depth) > 0;
+			j--)
+			strings[j] = strings[j - 1];
+		strings[j] = item;
+	}
+}
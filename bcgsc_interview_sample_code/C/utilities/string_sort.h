@@ -0,0 +1,38 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for sorting an array of pointers to C strings into
+*  strcmp() order (bytes compared as unsigned char).  Rather than calling
+*  strcmp() on whole strings over and over, the strings are sorted one
+*  character position at a time, so each character is looked at about
+*  once:
+*	- large groups: MSD radix sort, 256 buckets on the next character.
+*	- middle sized groups: multikey quicksort, three way on the next
+*	  character.
+*	- small groups: insertion sort, comparing from the first character
+*	  not yet known to be equal.
+*  The current character of every string is copied into a byte array
+*  first, so the counting and partitioning run over contiguous memory
+*  instead of following a pointer per comparison.  Big buckets are sorted
+*  in parallel on the default thread pool.  Not stable (equal strings are
+*  identical anyway unless their addresses matter).
+*  Compile with string_sort.c, dyn_stack.c, thread_pool.c, work_deque.c
+*  and -pthread.
+*/
+
+#ifndef _STRING_SORT_H_
+#define _STRING_SORT_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Function Prototypes */
+int SortStrings(char *strings[], size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
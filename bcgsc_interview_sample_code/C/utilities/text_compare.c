@@ -0,0 +1,229 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: String comparison.  See text_compare.h for the interface.
+*
+*  The vector kernels compare a block of each string with pcmpeqb and
+*  look for a 0 bit in the movemask.  The last block is loaded so that
+*  it ends at the end of the strings, overlapping the one before when
+*  the length is not a multiple of the block; the bytes before it are
+*  already known to match, so the first 0 bit is still the first
+*  mismatch.  Strings shorter than a block are compared 8 bytes at a
+*  time in plain C.
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "simd_search.h"
+#include "text_compare.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_KERNELS
+#include <immintrin.h>
+#define AVX2 __attribute__((target("avx2")))
+#define SSE2 __attribute__((target("sse2")))
+#define FIRST_BIT(mask) __builtin_ctz(mask)
+#endif
+
+/* Function Prototypes (local) */
+static size_t MismatchScalar(const unsigned char *a, const unsigned char *b,
+	size_t length);
+
+#ifdef HAVE_X86_KERNELS
+static size_t MismatchSse2(const unsigned char *a, const unsigned char *b,
+	size_t length);
+static size_t MismatchAvx2(const unsigned char *a, const unsigned char *b,
+	size_t length);
+#endif
+
+/*
+*  Function: TextMismatch()
+*  The first i with a[i] != b[i], or length if there is none.
+*/
+size_t
+TextMismatch(const char *a, const char *b, size_t length)
+{
+	const unsigned char *x = (const unsigned char *)a;
+	const unsigned char *y = (const unsigned char *)b;
+
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		if (length >= 32)
+			return (MismatchAvx2(x, y, length));
+		/* Fall through - an AVX2 CPU has SSE2 too */
+	case SIMD_SSE2:
+		if (length >= 16)
+			return (MismatchSse2(x, y, length));
+		break;
+	}
+#endif
+	return (MismatchScalar(x, y, length));
+}
+
+/*
+*  Function: TextEqual()
+*  Nonzero if a and b are the same length and hold the same bytes.
+*/
+int
+TextEqual(const char *a, size_t a_length, const char *b, size_t b_length)
+{
+	if (a_length != b_length)
+		return (0);
+	if (a == b)
+		return (1);
+	return (TextMismatch(a, b, a_length) == a_length);
+}
+
+/*
+*  Function: TextCompare()
+*  Negative, 0 or positive as a sorts before, with or after b: by the
+*  first differing byte (as unsigned char), then by length.
+*/
+int
+TextCompare(const char *a, size_t a_length, const char *b, size_t b_length)
+{
+	size_t shorter = (a_length < b_length) ? a_length : b_length;
+	size_t at = (a == b) ? shorter : TextMismatch(a, b, shorter);
+
+	if (at < shorter)
+		return ((int)(unsigned char)a[at] - (int)(unsigned char)b[at]);
+	return ((a_length > b_length) - (a_length < b_length));
+}
+
+/*
+*  Function: TextHash()
+*  Mixes the text in 8 bytes at a time, the length first so strings
+*  padded with '\0' bytes differ, and finishes with the mix of
+*  splitmix64 so every bit of the result depends on every byte.
+*/
+unsigned long long
+TextHash(const char *text, size_t length)
+{
+	uint64_t hash = 0x9e3779b97f4a7c15ULL ^ (uint64_t)length, chunk;
+
+	for (; length >= 8; text += 8, length -= 8)
+	{
+		memcpy(&chunk, text, 8);
+		hash = (hash ^ chunk) * 0xbf58476d1ce4e5b9ULL;
+		hash ^= hash >> 29;
+	}
+	if (length > 0)
+	{
+		chunk = 0;
+		memcpy(&chunk, text, length);
+		hash = (hash ^ chunk) * 0xbf58476d1ce4e5b9ULL;
+	}
+
+	hash ^= hash >> 32;
+	hash *= 0x94d049bb133111ebULL;
+	hash ^= hash >> 29;
+	return (hash);
+}
+
+/*
+*  Function: TextKeyInit()
+*  The text is not copied and must last as long as the key.
+*/
+void
+TextKeyInit(TextKey *key, const char *text, size_t length)
+{
+	key->text = text;
+	key->length = length;
+	key->hash = TextHash(text, length);
+}
+
+/*
+*  Function: TextKeyEqual()
+*  The hashes and lengths first; the bytes only if both agree.
+*/
+int
+TextKeyEqual(const TextKey *a, const TextKey *b)
+{
+	if (a->hash != b->hash || a->length != b->length)
+		return (0);
+	return (TextEqual(a->text, a->length, b->text, b->length));
+}
+
+/*
+*  Function: MismatchScalar()
+*  8 bytes a step while they agree, then a byte at a time.
+*/
+static size_t
+MismatchScalar(const unsigned char *a, const unsigned char *b, size_t length)
+{
+	uint64_t x, y;
+	size_t i = 0;
+
+	for (; i + 8 <= length; i += 8)
+	{
+		memcpy(&x, a + i, 8);
+		memcpy(&y, b + i, 8);
+		if (x != y)
+			break;
+	}
+	for (; i < length; i++)
+		if (a[i] != b[i])
+			return (i);
+	return (length);
+}
+
+#ifdef HAVE_X86_KERNELS
+
+/*
+*  Function: MismatchSse2()
+*  length is at least 16.
+*/
+SSE2 static size_t
+MismatchSse2(const unsigned char *a, const unsigned char *b, size_t length)
+{
+	unsigned int same;
+	size_t i;
+
+	for (i = 0; i + 16 <= length; i += 16)
+	{
+		same = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(
+			_mm_loadu_si128((const __m128i *)(a + i)),
+			_mm_loadu_si128((const __m128i *)(b + i))));
+		if (same != 0xffff)
+			return (i + FIRST_BIT(~same));
+	}
+	if (i == length)
+		return (length);
+
+	i = length - 16;
+	same = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(
+		_mm_loadu_si128((const __m128i *)(a + i)),
+		_mm_loadu_si128((const __m128i *)(b + i))));
+	return (same != 0xffff ? i + FIRST_BIT(~same) : length);
+}
+
+/*
+*  Function: MismatchAvx2()
+*  length is at least 32.
+*/
+AVX2 static size_t
+MismatchAvx2(const unsigned char *a, const unsigned char *b, size_t length)
+{
+	unsigned int same;
+	size_t i;
+
+	for (i = 0; i + 32 <= length; i += 32)
+	{
+		same = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+			_mm256_loadu_si256((const __m256i *)(a + i)),
+			_mm256_loadu_si256((const __m256i *)(b + i))));
+		if (same != 0xffffffffU)
+			return (i + FIRST_BIT(~same));
+	}
+	if (i == length)
+		return (length);
+
+	i = length - 32;
+	same = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+		_mm256_loadu_si256((const __m256i *)(a + i)),
+		_mm256_loadu_si256((const __m256i *)(b + i))));
+	return (same != 0xffffffffU ? i + FIRST_BIT(~same) : length);
+}
+
+#endif
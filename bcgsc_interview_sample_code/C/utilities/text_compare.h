@@ -0,0 +1,53 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for comparing strings whose lengths are known, so
+*  nothing is read past either end and no '\0' is needed.
+*
+*	TextMismatch()		Where two runs of bytes first differ; the
+*				vector kernels compare 32 (or 16) bytes a
+*				step.
+*	TextEqual()		Same length and same bytes.  Different
+*				lengths answer at once.
+*	TextCompare()		Three way, as memcmp() on the common part
+*				then the shorter first, so "ab" < "abc".
+*	TextHash()		A 64 bit hash of the bytes.
+*	TextKeyInit/Equal()	A string with its hash worked out once, for
+*				keys looked up again and again: keys whose
+*				hashes differ are unequal without looking at
+*				a byte, and the bytes are only compared for
+*				a real match (or a rare collision).
+*
+*  Compile with text_compare.c and simd_search.c.
+*/
+
+#ifndef _TEXT_COMPARE_H_
+#define _TEXT_COMPARE_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct text_key {
+	const char *text;	/* Not copied */
+	size_t length;
+	unsigned long long hash;
+} TextKey;
+
+/* Function Prototypes */
+size_t TextMismatch(const char *a, const char *b, size_t length);
+int TextEqual(const char *a, size_t a_length, const char *b,
+	size_t b_length);
+int TextCompare(const char *a, size_t a_length, const char *b,
+	size_t b_length);
+unsigned long long TextHash(const char *text, size_t length);
+
+void TextKeyInit(TextKey *key, const char *text, size_t length);
+int TextKeyEqual(const TextKey *a, const TextKey *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Reading a text file as lines.  See text_lines.h for the
+*  interface.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "text_lines.h"
+
+#define READ_BLOCK (1 << 20)	/* Bytes asked of fread() at a time */
+
+/* Function Prototypes (local) */
+static size_t SplitLines(char *text, size_t length, char **lines);
+
+/*
+*  Function: TextLinesRead()
+*  Returns 1, or 0 if memory ran out or the file could not be read, in
+*  which case lines is left empty.
+*/
+int
+TextLinesRead(FILE *in, TextLines *lines)
+{
+	size_t length, count;
+
+	lines->text = NULL;
+	lines->lines = NULL;
+	lines->count = 0;
+
+	lines->text = TextReadAll(in, &length);
+	if (lines->text == NULL)
+		return (0);
+
+	/* First pass counts, so the pointers are allocated once */
+	count = SplitLines(lines->text, length, NULL);
+	lines->lines = (char **)malloc((count + 1) * sizeof(char *));
+	if (lines->lines == NULL)
+	{
+		TextLinesFree(lines);
+		return (0);
+	}
+
+	lines->count = SplitLines(lines->text, length, lines->lines);
+	lines->lines[lines->count] = NULL;
+	return (1);
+}
+
+/*
+*  Function: TextLinesFree()
+*/
+void
+TextLinesFree(TextLines *lines)
+{
+	free(lines->text);
+	free(lines->lines);
+	lines->text = NULL;
+	lines->lines = NULL;
+	lines->count = 0;
+}
+
+/*
+*  Function: TextReadAll()
+*  The rest of the stream in one malloc()ed buffer, with room for one
+*  more byte, so a last line without a line end can be ended or the
+*  whole text made a string.  Returns NULL if memory ran out or the
+*  stream could not be read.
+*/
+char *
+TextReadAll(FILE *in, size_t *length)
+{
+	char *text = NULL, *bigger;
+	size_t used = 0, capacity = 0, got;
+
+	do
+	{
+		if (capacity - used < READ_BLOCK + 1)
+		{
+			capacity = capacity ? 2 * capacity : READ_BLOCK + 1;
+			bigger = (char *)realloc(text, capacity);
+			if (bigger == NULL)
+			{
+				free(text);
+				return (NULL);
+			}
+			text = bigger;
+		}
+		got = fread(text + used, 1, READ_BLOCK, in);
+		used += got;
+	} while (got == READ_BLOCK);
+
+	if (ferror(in))
+	{
+		free(text);
+		return (NULL);
+	}
+
+	*length = used;
+	return (text);
+}
+
+/*
+*  Function: SplitLines()
+*  Counts the lines of text.  If lines is not NULL, also ends each one
+*  with '\0' and records where it starts.
+*/
+static size_t
+SplitLines(char *text, size_t length, char **lines)
+{
+	char *start = text, *end = text + length, *newline;
+	size_t count = 0;
+
+	while (start < end)
+	{
+		newline = (char *)memchr(start, '\n', end - start);
+		if (newline == NULL)
+			newline = end;	/* TextReadAll() left room for the '\0' */
+
+		if (lines != NULL)
+		{
+			lines[count] = start;
+			if (newline > start && newline[-1] == '\r')
+				newline[-1] = '\0';
+			*newline = '\0';
+		}
+		count++;
+		start = newline + 1;
+	}
+	return (count);
+}
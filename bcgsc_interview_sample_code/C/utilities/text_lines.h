@@ -0,0 +1,38 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for reading a whole text file as an array of lines,
+*  with no limit on the number or length of the lines.  The file is read
+*  in large blocks into one buffer, each line end is overwritten with
+*  '\0' and lines[] points at the start of every line, so there is one
+*  allocation for the text and one for the pointers however many lines
+*  there are.  A "\r\n" line end is taken off as well, and a last line
+*  with no line end still counts.  TextReadAll() is the block reader on
+*  its own, for callers that want the file as one string.
+*/
+
+#ifndef _TEXT_LINES_H_
+#define _TEXT_LINES_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct text_lines {
+	char *text;		/* The file, lines ended by '\0' */
+	char **lines;		/* Start of each line within text */
+	size_t count;		/* Number of lines */
+} TextLines;
+
+/* Function Prototypes */
+int TextLinesRead(FILE *in, TextLines *lines);
+void TextLinesFree(TextLines *lines);
+char *TextReadAll(FILE *in, size_t *length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
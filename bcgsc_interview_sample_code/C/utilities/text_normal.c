@@ -0,0 +1,292 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Tidying text in place.  See text_normal.h for the interface.
+*
+*  TextNormalize() reads at one index and writes at another that never
+*  gets ahead of it, since every change drops characters.  Blanks, line
+*  ends and the first character of each word go one at a time; the rest
+*  of a word goes to MoveWord(), whose vector kernels stop at the first
+*  byte that is ' ' or below.  While nothing has been dropped yet (the
+*  two indexes agree) and the case is kept, a word is not written at
+*  all.  Once they differ a whole vector may still be stored: it ends
+*  no later than the one just loaded, so it only covers bytes already
+*  read.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "simd_search.h"
+#include "text_normal.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_KERNELS
+#include <immintrin.h>
+#define AVX2 __attribute__((target("avx2")))
+#define SSE2 __attribute__((target("sse2")))
+#define FIRST_BIT(mask) __builtin_ctz(mask)
+#endif
+
+#define NORMAL_BLOCK (1 << 20)	/* Bytes read at a time by TextNormalFile() */
+
+#define IS_BLANK(c) ((c) == ' ' || (c) == '\t' || (c) == '\r' || \
+	(c) == '\v' || (c) == '\f')
+#define IS_RANGE(c, first) ((unsigned char)((c) - (first)) < 26)
+
+/* Function Prototypes (local) */
+static unsigned char FirstCase(unsigned char c, int rule);
+static size_t MoveWord(unsigned char *dest, const unsigned char *src,
+	size_t length, unsigned char first);
+static size_t MoveScalar(unsigned char *dest, const unsigned char *src,
+	size_t length, unsigned char first);
+
+#ifdef HAVE_X86_KERNELS
+static size_t MoveSse2(unsigned char *dest, const unsigned char *src,
+	size_t length, unsigned char first);
+static size_t MoveAvx2(unsigned char *dest, const unsigned char *src,
+	size_t length, unsigned char first);
+#endif
+
+/*
+*  Function: TextNormalize()
+*  Tidies length bytes of text as text_normal.h describes and returns
+*  how many are left; the '\n' line ends are kept.
+*/
+size_t
+TextNormalize(char *text, size_t length, int rule)
+{
+	unsigned char *bytes = (unsigned char *)text;
+	size_t read = 0, write = 0, moved;
+	unsigned char c, first;
+	int start = 1;		/* Nothing written yet on this line */
+	int space = 0;		/* Blanks since the last word */
+
+	/* The letters whose case the rest of a word flips, 0 for none */
+	if (rule == TEXT_CASE_LOWER || rule == TEXT_CASE_TITLE)
+		first = 'A';
+	else if (rule == TEXT_CASE_UPPER)
+		first = 'a';
+	else
+		first = 0;
+
+	while (read < length)
+	{
+		c = bytes[read++];
+		if (c == '\n')
+		{
+			bytes[write++] = '\n';
+			start = 1;
+			space = 0;
+			continue;
+		}
+		if (IS_BLANK(c))
+		{
+			space = 1;
+			continue;
+		}
+
+		if (space && !start)
+			bytes[write++] = ' ';
+		bytes[write++] = FirstCase(c, rule);
+		start = 0;
+		space = 0;
+
+		moved = MoveWord(bytes + write, bytes + read, length - read, first);
+		read += moved;
+		write += moved;
+	}
+	return (write);
+}
+
+/*
+*  Function: TextNormalFile()
+*  Reads the rest of in a block at a time.  The whole lines of each
+*  block are tidied and handed to func; a line cut by the end of the
+*  block is moved to the front to be read on with the next (the buffer
+*  doubles if one line fills it).  Returns 1, or 0 if func stopped it,
+*  in could not be read or memory ran out.
+*/
+int
+TextNormalFile(FILE *in, int rule, TextNormalFunc func, void *arg)
+{
+	char *buffer, *bigger;
+	size_t capacity = NORMAL_BLOCK, filled = 0, got, whole;
+	int ok = 1;
+
+	buffer = (char *)malloc(capacity);
+	if (buffer == NULL)
+		return (0);
+
+	for (;;)
+	{
+		if (filled == capacity)
+		{
+			bigger = (char *)realloc(buffer, 2 * capacity);
+			if (bigger == NULL)
+			{
+				ok = 0;
+				break;
+			}
+			buffer = bigger;
+			capacity *= 2;
+		}
+
+		got = fread(buffer + filled, 1, capacity - filled, in);
+		if (got == 0)
+		{
+			if (ferror(in))
+				ok = 0;
+			else if (filled > 0)
+				ok = func(arg, buffer, TextNormalize(buffer, filled, rule));
+			break;
+		}
+
+		/* Just past the last '\n' read, looking only at the new bytes */
+		for (whole = filled + got; whole > filled; whole--)
+			if (buffer[whole - 1] == '\n')
+				break;
+		filled += got;
+		if (whole == 0 || buffer[whole - 1] != '\n')
+			continue;
+
+		ok = func(arg, buffer, TextNormalize(buffer, whole, rule));
+		if (!ok)
+			break;
+		memmove(buffer, buffer + whole, filled - whole);
+		filled -= whole;
+	}
+
+	free(buffer);
+	return (ok);
+}
+
+/*
+*  Function: FirstCase()
+*  The first character of a word under the rule.
+*/
+static unsigned char
+FirstCase(unsigned char c, int rule)
+{
+	if ((rule == TEXT_CASE_UPPER || rule == TEXT_CASE_TITLE) &&
+		IS_RANGE(c, 'a'))
+		return ((unsigned char)(c ^ 0x20));
+	if (rule == TEXT_CASE_LOWER && IS_RANGE(c, 'A'))
+		return ((unsigned char)(c ^ 0x20));
+	return (c);
+}
+
+/*
+*  Function: MoveWord()
+*  Moves src to dest (dest <= src) up to the first byte that is ' ' or
+*  below, flipping the case of letters in first..first + 25 unless
+*  first is 0.  Returns how many bytes were moved.
+*/
+static size_t
+MoveWord(unsigned char *dest, const unsigned char *src, size_t length,
+	unsigned char first)
+{
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		return (MoveAvx2(dest, src, length, first));
+	case SIMD_SSE2:
+		return (MoveSse2(dest, src, length, first));
+	}
+#endif
+	return (MoveScalar(dest, src, length, first));
+}
+
+/*
+*  Function: MoveScalar()
+*/
+static size_t
+MoveScalar(unsigned char *dest, const unsigned char *src, size_t length,
+	unsigned char first)
+{
+	size_t i;
+
+	for (i = 0; i < length && src[i] > ' '; i++)
+		dest[i] = (first != 0 && IS_RANGE(src[i], first)) ?
+			(unsigned char)(src[i] ^ 0x20) : src[i];
+	return (i);
+}
+
+#ifdef HAVE_X86_KERNELS
+
+/*
+*  Function: MoveSse2()
+*  16 bytes a step, the rest in plain C.
+*/
+SSE2 static size_t
+MoveSse2(unsigned char *dest, const unsigned char *src, size_t length,
+	unsigned char first)
+{
+	const __m128i blank = _mm_set1_epi8(' ');
+	const __m128i start = _mm_set1_epi8((char)first);
+	const __m128i span = _mm_set1_epi8(25);
+	const __m128i flip = _mm_set1_epi8(first != 0 ? 0x20 : 0);
+	__m128i block, offset;
+	unsigned int stop;
+	size_t i;
+
+	for (i = 0; i + 16 <= length; i += 16)
+	{
+		block = _mm_loadu_si128((const __m128i *)(src + i));
+		stop = (unsigned int)_mm_movemask_epi8(
+			_mm_cmpeq_epi8(_mm_min_epu8(block, blank), block));
+		if (stop != 0)
+			return (i + MoveScalar(dest + i, src + i, FIRST_BIT(stop),
+				first));
+
+		if (first != 0)
+		{
+			offset = _mm_sub_epi8(block, start);
+			block = _mm_xor_si128(block, _mm_and_si128(flip,
+				_mm_cmpeq_epi8(_mm_min_epu8(offset, span), offset)));
+		}
+		else if (dest == src)
+			continue;
+		_mm_storeu_si128((__m128i *)(dest + i), block);
+	}
+	return (i + MoveScalar(dest + i, src + i, length - i, first));
+}
+
+/*
+*  Function: MoveAvx2()
+*  32 bytes a step, the rest in plain C.
+*/
+AVX2 static size_t
+MoveAvx2(unsigned char *dest, const unsigned char *src, size_t length,
+	unsigned char first)
+{
+	const __m256i blank = _mm256_set1_epi8(' ');
+	const __m256i start = _mm256_set1_epi8((char)first);
+	const __m256i span = _mm256_set1_epi8(25);
+	const __m256i flip = _mm256_set1_epi8(first != 0 ? 0x20 : 0);
+	__m256i block, offset;
+	unsigned int stop;
+	size_t i;
+
+	for (i = 0; i + 32 <= length; i += 32)
+	{
+		block = _mm256_loadu_si256((const __m256i *)(src + i));
+		stop = (unsigned int)_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(_mm256_min_epu8(block, blank), block));
+		if (stop != 0)
+			return (i + MoveScalar(dest + i, src + i, FIRST_BIT(stop),
+				first));
+
+		if (first != 0)
+		{
+			offset = _mm256_sub_epi8(block, start);
+			block = _mm256_xor_si256(block, _mm256_and_si256(flip,
+				_mm256_cmpeq_epi8(_mm256_min_epu8(offset, span), offset)));
+		}
+		else if (dest == src)
+			continue;
+		_mm256_storeu_si256((__m256i *)(dest + i), block);
+	}
+	return (i + MoveScalar(dest + i, src + i, length - i, first));
+}
+
+#endif
@@ -0,0 +1,52 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for tidying lines of text in place: each run of
+*  blanks (space, tab, \v, \f, \r) inside a line becomes one space,
+*  blanks at either end of a line are dropped, and a case rule is
+*  applied to the letters A to Z and a to z.  A line is never made
+*  longer, so the text is rewritten where it lies with no second buffer.
+*
+*	TextNormalize()		Tidies a buffer of lines (or one line) and
+*				returns its new length.  The rest of a word
+*				after its first character is found, moved
+*				and case converted 32 bytes a step.
+*	TextNormalFile()	Streams a file through TextNormalize() a
+*				block of whole lines at a time, handing each
+*				tidied block to a function (to write out,
+*				say); memory does not grow with the file.
+*
+*  A word is a run of characters that are not blanks or '\n'.  Under
+*  TEXT_CASE_TITLE the first character of a word is made upper case
+*  and the rest lower case, so "  mcDONALD   jOHN " becomes
+*  "Mcdonald John".  Lines that are all blanks become empty lines.
+*  Compile with text_normal.c and simd_search.c.
+*/
+
+#ifndef _TEXT_NORMAL_H_
+#define _TEXT_NORMAL_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TEXT_CASE_KEEP 0
+#define TEXT_CASE_LOWER 1
+#define TEXT_CASE_UPPER 2
+#define TEXT_CASE_TITLE 3
+
+/* Gets each block of tidied lines, all '\n' ended but perhaps the last
+   of the file; return 0 to stop */
+typedef int (*TextNormalFunc)(void *arg, char *text, size_t length);
+
+/* Function Prototypes */
+size_t TextNormalize(char *text, size_t length, int rule);
+int TextNormalFile(FILE *in, int rule, TextNormalFunc func, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
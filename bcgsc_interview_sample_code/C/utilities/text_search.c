@@ -0,0 +1,448 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Substring search.  See text_search.h for the interface.
+*
+*  The vector filter (after Mula) loads the text at i and at i + m - 1
+*  for m the pattern length, so lane k of the two loads holds the first
+*  and last byte of the window at i + k.  Comparing them with the
+*  pattern's first and last bytes and anding the results leaves a bit
+*  per window worth a closer look; on ordinary text that is rare.  The
+*  compare of the middle is bounded by the pattern length, and long
+*  patterns go to Two-Way instead, so no text makes it quadratic.
+*
+*  Two-Way splits the pattern at a critical factorisation u v, matches v
+*  left to right then u right to left, and on a mismatch shifts by an
+*  amount that never skips a match; for a periodic pattern it remembers
+*  how much of the window already matched.
+*/
+
+#include <string.h>
+#include "simd_search.h"
+#include "text_search.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_KERNELS
+#include <immintrin.h>
+#define AVX2 __attribute__((target("avx2")))
+#define SSE2 __attribute__((target("sse2")))
+#define FIRST_BIT(mask) __builtin_ctz(mask)
+#endif
+
+/* Function Prototypes (local) */
+static int Same(const unsigned char *a, const unsigned char *b, size_t n);
+static size_t FilterScalar(const unsigned char *text, size_t length,
+	const unsigned char *pattern, size_t pattern_length);
+static size_t CriticalSplit(const unsigned char *pattern, size_t length,
+	size_t *period);
+static size_t TwoWay(const TextFinder *finder, const unsigned char *text,
+	size_t length);
+
+#ifdef HAVE_X86_KERNELS
+static size_t FilterSse2(const unsigned char *text, size_t length,
+	const unsigned char *pattern, size_t pattern_length);
+static size_t FilterAvx2(const unsigned char *text, size_t length,
+	const unsigned char *pattern, size_t pattern_length);
+#endif
+
+/*
+*  Function: TextFind()
+*  Returns the position of the first match, TEXT_NOT_FOUND if none.  An
+*  empty pattern matches at 0.
+*/
+size_t
+TextFind(const char *text, size_t length, const char *pattern,
+	size_t pattern_length)
+{
+	TextFinder finder;
+
+	/* Only Two-Way needs the tables, don't fill them in otherwise */
+	if (pattern_length < TEXT_TWO_WAY_MIN)
+	{
+		finder.pattern = pattern;
+		finder.length = pattern_length;
+	}
+	else
+		TextFinderInit(&finder, pattern, pattern_length);
+	return (TextFinderFind(&finder, text, length));
+}
+
+/*
+*  Function: TextFindChar()
+*/
+size_t
+TextFindChar(const char *text, size_t length, int ch)
+{
+	const char *at = (const char *)memchr(text, ch, length);
+
+	return (at ? (size_t)(at - text) : TEXT_NOT_FOUND);
+}
+
+/*
+*  Function: TextFinderInit()
+*/
+void
+TextFinderInit(TextFinder *finder, const char *pattern, size_t length)
+{
+	const unsigned char *bytes = (const unsigned char *)pattern;
+	size_t i;
+
+	finder->pattern = pattern;
+	finder->length = length;
+	finder->split = 0;
+	finder->period = 0;
+	finder->periodic = 0;
+	if (length < TEXT_TWO_WAY_MIN)
+		return;
+
+	finder->split = CriticalSplit(bytes, length, &finder->period);
+	if (memcmp(bytes, bytes + finder->period, finder->split) == 0)
+		finder->periodic = 1;
+	else
+		finder->period = ((finder->split > length - finder->split) ?
+			finder->split : length - finder->split) + 1;
+
+	for (i = 0; i < 256; i++)
+		finder->shift[i] = length;
+	for (i = 0; i < length; i++)
+		finder->shift[bytes[i]] = length - 1 - i;
+}
+
+/*
+*  Function: TextFinderFind()
+*/
+size_t
+TextFinderFind(const TextFinder *finder, const char *text, size_t length)
+{
+	const unsigned char *bytes = (const unsigned char *)text;
+	const unsigned char *pattern = (const unsigned char *)finder->pattern;
+	size_t m = finder->length;
+
+	if (m == 0)
+		return (0);
+	if (m > length)
+		return (TEXT_NOT_FOUND);
+	if (m == 1)
+		return (TextFindChar(text, length, pattern[0]));
+	if (m >= TEXT_TWO_WAY_MIN)
+		return (TwoWay(finder, bytes, length));
+
+#ifdef HAVE_X86_KERNELS
+	switch (SimdSearchLevel())
+	{
+	case SIMD_AVX2:
+		return (FilterAvx2(bytes, length, pattern, m));
+	case SIMD_SSE2:
+		return (FilterSse2(bytes, length, pattern, m));
+	}
+#endif
+	return (FilterScalar(bytes, length, pattern, m));
+}
+
+/*
+*  Function: TextMatchesInit()
+*  An empty pattern has no matches here.
+*/
+void
+TextMatchesInit(TextMatches *matches, const char *text, size_t length,
+	const char *pattern, size_t pattern_length)
+{
+	TextFinderInit(&matches->finder, pattern, pattern_length);
+	matches->text = text;
+	matches->length = length;
+	matches->next = (pattern_length > 0) ? 0 : length + 1;
+}
+
+/*
+*  Function: TextMatchesNext()
+*  Position of the next match, or TEXT_NOT_FOUND when there are no more.
+*/
+size_t
+TextMatchesNext(TextMatches *matches)
+{
+	size_t at;
+
+	if (matches->next > matches->length)
+		return (TEXT_NOT_FOUND);
+
+	at = TextFinderFind(&matches->finder, matches->text + matches->next,
+		matches->length - matches->next);
+	if (at == TEXT_NOT_FOUND)
+	{
+		matches->next = matches->length + 1;
+		return (TEXT_NOT_FOUND);
+	}
+
+	at += matches->next;
+	matches->next = at + matches->finder.length;
+	return (at);
+}
+
+/*
+*  Function: Same()
+*  The middle of a short pattern: a few bytes, cheaper compared here
+*  than through a call to memcmp().
+*/
+static inline int
+Same(const unsigned char *a, const unsigned char *b, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		if (a[i] != b[i])
+			return (0);
+	return (1);
+}
+
+/*
+*  Function: FilterScalar()
+*  memchr() to each first byte, then the last byte, then the middle.
+*  Also finishes the text past the vector kernels' last full step.
+*/
+static size_t
+FilterScalar(const unsigned char *text, size_t length,
+	const unsigned char *pattern, size_t pattern_length)
+{
+	const unsigned char *at = text, *last;
+	size_t m = pattern_length;
+
+	if (m > length)
+		return (TEXT_NOT_FOUND);
+	last = text + (length - m);
+
+	while ((at = (const unsigned char *)memchr(at, pattern[0],
+		(size_t)(last - at) + 1)) != NULL)
+	{
+		if (at[m - 1] == pattern[m - 1] &&
+			Same(at + 1, pattern + 1, m - 2))
+			return ((size_t)(at - text));
+		if (at++ == last)
+			break;
+	}
+	return (TEXT_NOT_FOUND);
+}
+
+#ifdef HAVE_X86_KERNELS
+/*
+*  Function: FilterSse2()
+*/
+static SSE2 size_t
+FilterSse2(const unsigned char *text, size_t length,
+	const unsigned char *pattern, size_t pattern_length)
+{
+	const __m128i first = _mm_set1_epi8((char)pattern[0]);
+	const __m128i last = _mm_set1_epi8((char)pattern[pattern_length - 1]);
+	size_t m = pattern_length, i, rest;
+	__m128i head, tail;
+	unsigned int mask;
+
+	for (i = 0; i + m - 1 + 16 <= length; i += 16)
+	{
+		head = _mm_loadu_si128((const __m128i *)(text + i));
+		tail = _mm_loadu_si128((const __m128i *)(text + i + m - 1));
+		mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(
+			_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+		while (mask != 0)
+		{
+			if (Same(text + i + FIRST_BIT(mask) + 1, pattern + 1,
+				m - 2))
+				return (i + FIRST_BIT(mask));
+			mask &= mask - 1;
+		}
+	}
+
+	rest = FilterScalar(text + i, length - i, pattern, m);
+	return ((rest == TEXT_NOT_FOUND) ? rest : i + rest);
+}
+
+/*
+*  Function: FilterAvx2()
+*/
+static AVX2 size_t
+FilterAvx2(const unsigned char *text, size_t length,
+	const unsigned char *pattern, size_t pattern_length)
+{
+	const __m256i first = _mm256_set1_epi8((char)pattern[0]);
+	const __m256i last = _mm256_set1_epi8((char)pattern[pattern_length - 1]);
+	size_t m = pattern_length, i, rest;
+	__m256i head, tail;
+	unsigned int mask;
+
+	for (i = 0; i + m - 1 + 32 <= length; i += 32)
+	{
+		head = _mm256_loadu_si256((const __m256i *)(text + i));
+		tail = _mm256_loadu_si256((const __m256i *)(text + i + m - 1));
+		mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(
+			_mm256_cmpeq_epi8(head, first),
+			_mm256_cmpeq_epi8(tail, last)));
+		while (mask != 0)
+		{
+			if (Same(text + i + FIRST_BIT(mask) + 1, pattern + 1,
+				m - 2))
+				return (i + FIRST_BIT(mask));
+			mask &= mask - 1;
+		}
+	}
+
+	rest = FilterScalar(text + i, length - i, pattern, m);
+	return ((rest == TEXT_NOT_FOUND) ? rest : i + rest);
+}
+#endif
+
+/*
+*  Function: CriticalSplit()
+*  The critical factorisation: the later start of the maximal suffixes
+*  for the byte order and its reverse, with the period of that suffix.
+*  (j, k, p walk the candidates as in Crochemore and Perrin; suffix
+*  starts at "-1" so that pattern[suffix + k] is pattern[k - 1].)
+*/
+static size_t
+CriticalSplit(const unsigned char *pattern, size_t length, size_t *period)
+{
+	size_t suffix, j, k, p, reverse_suffix, reverse_period;
+	unsigned char a, b;
+
+	suffix = (size_t)-1;
+	j = 0;
+	k = p = 1;
+	while (j + k < length)
+	{
+		a = pattern[j + k];
+		b = pattern[suffix + k];
+		if (a < b)
+		{
+			j += k;
+			k = 1;
+			p = j - suffix;
+		}
+		else if (a == b)
+		{
+			if (k != p)
+				k++;
+			else
+			{
+				j += p;
+				k = 1;
+			}
+		}
+		else
+		{
+			suffix = j++;
+			k = p = 1;
+		}
+	}
+	*period = p;
+
+	reverse_suffix = (size_t)-1;
+	j = 0;
+	k = p = 1;
+	while (j + k < length)
+	{
+		a = pattern[j + k];
+		b = pattern[reverse_suffix + k];
+		if (b < a)
+		{
+			j += k;
+			k = 1;
+			p = j - reverse_suffix;
+		}
+		else if (a == b)
+		{
+			if (k != p)
+				k++;
+			else
+			{
+				j += p;
+				k = 1;
+			}
+		}
+		else
+		{
+			reverse_suffix = j++;
+			k = p = 1;
+		}
+	}
+	reverse_period = p;
+
+	if (reverse_suffix + 1 < suffix + 1)
+		return (suffix + 1);
+	*period = reverse_period;
+	return (reverse_suffix + 1);
+}
+
+/*
+*  Function: TwoWay()
+*  The window is text[j, j + m).  Its last byte is looked up first: if
+*  the pattern cannot end there the window moves on at once.
+*/
+static size_t
+TwoWay(const TextFinder *finder, const unsigned char *text, size_t length)
+{
+	const unsigned char *pattern = (const unsigned char *)finder->pattern;
+	size_t m = finder->length, split = finder->split;
+	size_t period = finder->period;
+	size_t j = 0, i, shift, memory = 0;
+
+	if (finder->periodic)
+	{
+		/* memory: bytes at the window start known to match */
+		while (j <= length - m)
+		{
+			shift = finder->shift[text[j + m - 1]];
+			if (shift > 0)
+			{
+				if (memory != 0 && shift < period)
+					shift = m - period;
+				memory = 0;
+				j += shift;
+				continue;
+			}
+
+			i = (split > memory) ? split : memory;
+			while (i < m - 1 && pattern[i] == text[i + j])
+				i++;
+			if (i >= m - 1)
+			{
+				i = split - 1;
+				while (memory < i + 1 && pattern[i] == text[i + j])
+					i--;
+				if (i + 1 < memory + 1)
+					return (j);
+				j += period;
+				memory = m - period;
+			}
+			else
+			{
+				j += i - split + 1;
+				memory = 0;
+			}
+		}
+	}
+	else
+	{
+		while (j <= length - m)
+		{
+			shift = finder->shift[text[j + m - 1]];
+			if (shift > 0)
+			{
+				j += shift;
+				continue;
+			}
+
+			i = split;
+			while (i < m - 1 && pattern[i] == text[i + j])
+				i++;
+			if (i >= m - 1)
+			{
+				i = split - 1;
+				while (i != (size_t)-1 && pattern[i] == text[i + j])
+					i--;
+				if (i == (size_t)-1)
+					return (j);
+				j += period;
+			}
+			else
+				j += i - split + 1;
+		}
+	}
+	return (TEXT_NOT_FOUND);
+}
@@ -0,0 +1,71 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for finding a string in a block of text (bytes, not
+*  '\0' ended, so any text can be searched).  Which method is used
+*  depends on the length of the pattern:
+*	- 1 byte: memchr(), which the C library vectorises.
+*	- short: a vector filter, 16 or 32 positions a step, keeping the
+*	  positions whose first and last bytes both match, then comparing
+*	  the bytes between.
+*	- TEXT_TWO_WAY_MIN bytes or more: the Two-Way algorithm
+*	  (Crochemore and Perrin), linear time whatever the text and pattern,
+*	  skipping ahead on the last byte of the window as in Horspool.
+*  The vector level is the one simd_search.c picked for the CPU (see
+*  SimdSearchSetLevel()).
+*
+*	TextFind()		First match of a pattern, once.
+*	TextFinderInit/Find()	The same, with the pattern prepared once for
+*				searching many texts.
+*	TextMatchesInit/Next()	Every match in a text in turn (matches do not
+*				overlap; search again from a match + 1 for
+*				those that do).
+*
+*  Compile with text_search.c and simd_search.c (C11 atomics).
+*/
+
+#ifndef _TEXT_SEARCH_H_
+#define _TEXT_SEARCH_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TEXT_NOT_FOUND ((size_t)-1)
+#define TEXT_TWO_WAY_MIN 32
+
+typedef struct text_finder {
+	const char *pattern;	/* Not copied, must outlive the finder */
+	size_t length;
+	size_t split;		/* Two-Way: critical factorisation */
+	size_t period;
+	int periodic;		/* Two-Way: pattern[0, split) repeats */
+	size_t shift[256];	/* Two-Way: skip on the window's last byte */
+} TextFinder;
+
+typedef struct text_matches {
+	TextFinder finder;
+	const char *text;
+	size_t length;
+	size_t next;		/* Where the search resumes */
+} TextMatches;
+
+/* Function Prototypes */
+size_t TextFind(const char *text, size_t length, const char *pattern,
+	size_t pattern_length);
+size_t TextFindChar(const char *text, size_t length, int ch);
+
+void TextFinderInit(TextFinder *finder, const char *pattern, size_t length);
+size_t TextFinderFind(const TextFinder *finder, const char *text,
+	size_t length);
+
+void TextMatchesInit(TextMatches *matches, const char *text, size_t length,
+	const char *pattern, size_t pattern_length);
+size_t TextMatchesNext(TextMatches *matches);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,612 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Work-stealing thread pool built on work_deque.c.  See
+*  thread_pool.h for the interface.
+*
+*  Where a task goes:
+*	- forked by one of this pool's workers: onto that worker's deque.
+*	- anything else (e.g. main()): onto a shared injection queue.
+*  Where a worker looks for work, in order: its own deque (newest first,
+*  good for cache), the injection queue, then other workers' deques
+*  (oldest first, which are the biggest pieces of a divide and conquer).
+*/
+
+#define _POSIX_C_SOURCE 200809L	/* nanosleep() under -std=c11 */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <time.h>
+#include "work_deque.h"
+#include "thread_pool.h"
+
+#define SPINS_BEFORE_SLEEP 64
+
+typedef struct task {
+	TaskFunc func;
+	void *arg;
+	TaskGroup *group;	/* NULL for PoolSubmit() tasks */
+	struct task *next;	/* Link in the injection queue */
+} Task;
+
+typedef struct worker {
+	ThreadPool *pool;
+	WorkDeque deque;
+	pthread_t thread;
+	unsigned int seed;	/* For picking steal victims */
+} Worker;
+
+struct thread_pool {
+	Worker *workers;
+	int num_threads;
+
+	pthread_mutex_t lock;	/* Guards the injection queue and sleeping */
+	pthread_cond_t wake;
+	Task *inject_head;
+	Task *inject_tail;
+	atomic_long injected;	/* Length of the injection queue */
+
+	atomic_long queued;	/* Tasks waiting to be started */
+	atomic_long outstanding;	/* Tasks not yet finished */
+	atomic_int sleepers;
+	atomic_int shutdown;
+};
+
+typedef struct range_task {
+	ThreadPool *pool;
+	long low;
+	long high;
+	long grain;
+	RangeFunc func;
+	void *arg;
+	int heap;		/* 1 if RangeSplit() must free it */
+} RangeTask;
+
+/* The worker running on this thread, NULL for non-pool threads */
+static __thread Worker *tls_worker = NULL;
+
+static ThreadPool *default_pool = NULL;
+static pthread_once_t default_once = PTHREAD_ONCE_INIT;
+
+/* Function Prototypes (local) */
+static void *WorkerMain(void *arg);
+static void PushTask(ThreadPool *pool, Task *task);
+static Task *TakeTask(ThreadPool *pool);
+static void RunTask(ThreadPool *pool, Task *task);
+static int HelpOnce(ThreadPool *pool);
+static void WaitTurn(ThreadPool *pool, int *spins);
+static int QueueTask(ThreadPool *pool, TaskGroup *group, TaskFunc func,
+	void *arg);
+static void RangeSplit(void *arg);
+static void MakeDefaultPool(void);
+static void FreeDefaultPool(void);
+
+/*
+*  Function: PoolCreate()
+*  Starts num_threads workers (one per online core if num_threads <= 0).
+*  Returns NULL if the pool could not be set up.
+*/
+ThreadPool *
+PoolCreate(int num_threads)
+{
+	ThreadPool *pool;
+	int i;
+
+	if (num_threads <= 0)
+		num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (num_threads <= 0)
+		num_threads = 1;
+
+	pool = (ThreadPool *)calloc(1, sizeof(ThreadPool));
+	if (pool == NULL)
+		return (NULL);
+
+	pool->workers = (Worker *)calloc(num_threads, sizeof(Worker));
+	if (pool->workers == NULL)
+	{
+		free(pool);
+		return (NULL);
+	}
+
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->wake, NULL);
+	atomic_init(&pool->injected, 0);
+	atomic_init(&pool->queued, 0);
+	atomic_init(&pool->outstanding, 0);
+	atomic_init(&pool->sleepers, 0);
+	atomic_init(&pool->shutdown, 0);
+
+	/* Every deque must exist before any worker may try to steal */
+	for (i = 0; i < num_threads; i++)
+	{
+		pool->workers[i].pool = pool;
+		pool->workers[i].seed = 2654435761u * (i + 1);
+		if (!WorkDequeInit(&pool->workers[i].deque))
+			break;
+	}
+
+	if (i < num_threads)
+	{
+		while (i-- > 0)
+			WorkDequeDestroy(&pool->workers[i].deque);
+		free(pool->workers);
+		free(pool);
+		return (NULL);
+	}
+
+	/* Workers read num_threads to pick victims, so set it first */
+	pool->num_threads = num_threads;
+	for (i = 0; i < num_threads; i++)
+		if (pthread_create(&pool->workers[i].thread, NULL, WorkerMain,
+			&pool->workers[i]) != 0)
+			break;
+
+	if (i < num_threads)
+	{
+		/* Stop the ones that did start, nothing has been queued yet */
+		pthread_mutex_lock(&pool->lock);
+		atomic_store(&pool->shutdown, 1);
+		pthread_cond_broadcast(&pool->wake);
+		pthread_mutex_unlock(&pool->lock);
+
+		while (i-- > 0)
+			pthread_join(pool->workers[i].thread, NULL);
+		for (i = 0; i < num_threads; i++)
+			WorkDequeDestroy(&pool->workers[i].deque);
+		pthread_cond_destroy(&pool->wake);
+		pthread_mutex_destroy(&pool->lock);
+		free(pool->workers);
+		free(pool);
+		return (NULL);
+	}
+
+	return (pool);
+}
+
+/*
+*  Function: PoolDestroy()
+*  Runs every task still queued, then stops and frees the workers.
+*/
+void
+PoolDestroy(ThreadPool *pool)
+{
+	int i;
+
+	if (pool == NULL)
+		return;
+
+	PoolWaitAll(pool);
+
+	pthread_mutex_lock(&pool->lock);
+	atomic_store(&pool->shutdown, 1);
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (i = 0; i < pool->num_threads; i++)
+	{
+		pthread_join(pool->workers[i].thread, NULL);
+		WorkDequeDestroy(&pool->workers[i].deque);
+	}
+
+	pthread_cond_destroy(&pool->wake);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->workers);
+	free(pool);
+}
+
+/*
+*  Function: PoolDefault()
+*  A process wide pool with one worker per core, made on first use and
+*  destroyed at exit.  Returns NULL if it could not be made.
+*/
+ThreadPool *
+PoolDefault(void)
+{
+	pthread_once(&default_once, MakeDefaultPool);
+	return (default_pool);
+}
+
+static void
+MakeDefaultPool(void)
+{
+	default_pool = PoolCreate(0);
+	if (default_pool != NULL)
+		atexit(FreeDefaultPool);
+}
+
+static void
+FreeDefaultPool(void)
+{
+	PoolDestroy(default_pool);
+	default_pool = NULL;
+}
+
+/*
+*  Function: PoolNumThreads()
+*/
+int
+PoolNumThreads(const ThreadPool *pool)
+{
+	return (pool->num_threads);
+}
+
+/*
+*  Function: PoolSubmit()
+*  Queues func(arg) to run on some worker.  Returns 1 if it was queued,
+*  0 if it has already been run here instead (pool is NULL or memory
+*  ran out), so callers can pass PoolDefault() without checking it.
+*/
+int
+PoolSubmit(ThreadPool *pool, TaskFunc func, void *arg)
+{
+	return (QueueTask(pool, NULL, func, arg));
+}
+
+/*
+*  Function: PoolWaitAll()
+*  Helps run tasks until every task submitted or spawned has finished.
+*  Not to be called from inside a task, use a TaskGroup there.
+*/
+void
+PoolWaitAll(ThreadPool *pool)
+{
+	int spins = 0;
+
+	if (pool == NULL)
+		return;
+
+	while (atomic_load_explicit(&pool->outstanding,
+		memory_order_acquire) > 0)
+		WaitTurn(pool, &spins);
+}
+
+/*
+*  Function: TaskGroupInit()
+*/
+void
+TaskGroupInit(TaskGroup *group)
+{
+	atomic_init(&group->pending, 0);
+}
+
+/*
+*  Function: PoolSpawn()
+*  Forks func(arg) as part of 'group'.  Return value as for PoolSubmit().
+*/
+int
+PoolSpawn(ThreadPool *pool, TaskGroup *group, TaskFunc func, void *arg)
+{
+	return (QueueTask(pool, group, func, arg));
+}
+
+/*
+*  Function: PoolJoin()
+*  Returns once every task spawned into 'group' has finished.  A worker
+*  runs queued tasks while it waits, other threads just wait.
+*/
+void
+PoolJoin(ThreadPool *pool, TaskGroup *group)
+{
+	int spins = 0;
+
+	if (pool == NULL)
+		return;
+
+	while (atomic_load_explicit(&group->pending,
+		memory_order_acquire) > 0)
+		WaitTurn(pool, &spins);
+}
+
+/*
+*  Function: PoolParallelFor()
+*  Calls func(arg, lo, hi) over pieces of [low, high) no bigger than
+*  'grain', splitting the range in halves so idle workers steal big
+*  pieces first.  Returns when the whole range is done.
+*/
+void
+PoolParallelFor(ThreadPool *pool, long low, long high, long grain,
+	RangeFunc func, void *arg)
+{
+	RangeTask whole;
+
+	if (grain < 1)
+		grain = 1;
+
+	if (high - low <= grain || pool == NULL)
+	{
+		if (high > low)
+			func(arg, low, high);
+		return;
+	}
+
+	whole.pool = pool;
+	whole.low = low;
+	whole.high = high;
+	whole.grain = grain;
+	whole.func = func;
+	whole.arg = arg;
+	whole.heap = 0;
+	RangeSplit(&whole);
+}
+
+/*
+*  Function: RangeSplit()
+*  Keeps the left half of the range, spawns the right half, until the
+*  piece left is small enough to run.
+*/
+static void
+RangeSplit(void *arg)
+{
+	RangeTask *range = (RangeTask *)arg;
+	RangeTask *right;
+	TaskGroup group;
+	long low = range->low;
+	long high = range->high;
+	long mid;
+
+	TaskGroupInit(&group);
+
+	while (high - low > range->grain)
+	{
+		mid = low + (high - low) / 2;
+
+		right = (RangeTask *)malloc(sizeof(RangeTask));
+		if (right == NULL)
+			break;
+		*right = *range;
+		right->low = mid;
+		right->high = high;
+		right->heap = 1;
+
+		PoolSpawn(range->pool, &group, RangeSplit, right);
+		high = mid;
+	}
+
+	range->func(range->arg, low, high);
+	PoolJoin(range->pool, &group);
+
+	if (range->heap)
+		free(range);
+}
+
+/*
+*  Function: QueueTask()
+*/
+static int
+QueueTask(ThreadPool *pool, TaskGroup *group, TaskFunc func, void *arg)
+{
+	Task *task;
+
+	task = (pool != NULL) ? (Task *)malloc(sizeof(Task)) : NULL;
+	if (task == NULL)
+	{
+		func(arg);
+		return (0);
+	}
+
+	task->func = func;
+	task->arg = arg;
+	task->group = group;
+	task->next = NULL;
+
+	if (group != NULL)
+		atomic_fetch_add_explicit(&group->pending, 1,
+			memory_order_relaxed);
+	atomic_fetch_add(&pool->outstanding, 1);
+
+	PushTask(pool, task);
+	return (1);
+}
+
+/*
+*  Function: PushTask()
+*  Puts the task on this thread's deque if it is one of our workers,
+*  otherwise on the injection queue, then wakes a sleeper if any.
+*/
+static void
+PushTask(ThreadPool *pool, Task *task)
+{
+	Worker *me = tls_worker;
+
+	/* Count it before anyone can take it, so 'queued' never lies low */
+	atomic_fetch_add(&pool->queued, 1);
+
+	if (me == NULL || me->pool != pool ||
+		!WorkDequePush(&me->deque, task))
+	{
+		pthread_mutex_lock(&pool->lock);
+		if (pool->inject_tail != NULL)
+			pool->inject_tail->next = task;
+		else
+			pool->inject_head = task;
+		pool->inject_tail = task;
+		atomic_fetch_add(&pool->injected, 1);
+		pthread_mutex_unlock(&pool->lock);
+	}
+
+	if (atomic_load(&pool->sleepers) > 0)
+	{
+		pthread_mutex_lock(&pool->lock);
+		pthread_cond_signal(&pool->wake);
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+/*
+*  Function: TakeTask()
+*  Returns a task for this thread to run, or NULL if none was found.
+*/
+static Task *
+TakeTask(ThreadPool *pool)
+{
+	Worker *me = tls_worker;
+	Task *task = NULL;
+	void *item;
+	int i, start, victim, tries;
+
+	if (me != NULL && me->pool != pool)
+		me = NULL;
+
+	if (me != NULL)
+		task = (Task *)WorkDequePop(&me->deque);
+
+	if (task == NULL && atomic_load(&pool->injected) > 0)
+	{
+		pthread_mutex_lock(&pool->lock);
+		task = pool->inject_head;
+		if (task != NULL)
+		{
+			pool->inject_head = task->next;
+			if (pool->inject_head == NULL)
+				pool->inject_tail = NULL;
+			atomic_fetch_sub(&pool->injected, 1);
+		}
+		pthread_mutex_unlock(&pool->lock);
+	}
+
+	if (task == NULL)
+	{
+		/* Start at a random victim so thieves spread out */
+		if (me != NULL)
+		{
+			me->seed ^= me->seed << 13;
+			me->seed ^= me->seed >> 17;
+			me->seed ^= me->seed << 5;
+			start = (int)(me->seed % pool->num_threads);
+		}
+		else
+			start = 0;
+
+		for (i = 0; i < pool->num_threads && task == NULL; i++)
+		{
+			victim = (start + i) % pool->num_threads;
+			if (&pool->workers[victim] == me)
+				continue;
+
+			for (tries = 0; tries < 4; tries++)
+			{
+				item = WorkDequeSteal(&pool->workers[victim].deque);
+				if (item != WORK_DEQUE_ABORT)
+				{
+					task = (Task *)item;
+					break;
+				}
+			}
+		}
+	}
+
+	if (task != NULL)
+		atomic_fetch_sub(&pool->queued, 1);
+
+	return (task);
+}
+
+/*
+*  Function: RunTask()
+*/
+static void
+RunTask(ThreadPool *pool, Task *task)
+{
+	TaskGroup *group = task->group;
+
+	task->func(task->arg);
+	free(task);
+
+	if (group != NULL)
+		atomic_fetch_sub_explicit(&group->pending, 1,
+			memory_order_release);
+	atomic_fetch_sub_explicit(&pool->outstanding, 1, memory_order_release);
+}
+
+/*
+*  Function: HelpOnce()
+*  Runs one queued task if there is one.  Returns 1 if it did.
+*/
+static int
+HelpOnce(ThreadPool *pool)
+{
+	Task *task = TakeTask(pool);
+
+	if (task == NULL)
+		return (0);
+
+	RunTask(pool, task);
+	return (1);
+}
+
+/*
+*  Function: WaitTurn()
+*  One step of waiting in PoolJoin() or PoolWaitAll().  Workers help by
+*  running a task.  Other threads must not: they have no deque, so every
+*  task they ran would come off the FIFO injection queue and a recursive
+*  fork-join would unwind breadth first on their stack.  They back off
+*  instead, yielding first and then sleeping briefly.
+*/
+static void
+WaitTurn(ThreadPool *pool, int *spins)
+{
+	struct timespec nap;
+
+	if (tls_worker != NULL && tls_worker->pool == pool)
+	{
+		if (HelpOnce(pool))
+			return;
+	}
+
+	if (++(*spins) < SPINS_BEFORE_SLEEP)
+	{
+		sched_yield();
+		return;
+	}
+
+	nap.tv_sec = 0;
+	nap.tv_nsec = 50000;
+	nanosleep(&nap, NULL);
+}
+
+/*
+*  Function: WorkerMain()
+*  Runs tasks until shutdown.  After a short spell of finding nothing the
+*  worker sleeps until PushTask() signals that work has been queued.
+*/
+static void *
+WorkerMain(void *arg)
+{
+	Worker *me = (Worker *)arg;
+	ThreadPool *pool = me->pool;
+	int idle = 0;
+
+	tls_worker = me;
+
+	while (1)
+	{
+		if (HelpOnce(pool))
+		{
+			idle = 0;
+			continue;
+		}
+
+		if (++idle < SPINS_BEFORE_SLEEP)
+		{
+			sched_yield();
+			continue;
+		}
+
+		pthread_mutex_lock(&pool->lock);
+		atomic_fetch_add(&pool->sleepers, 1);
+		while (!atomic_load(&pool->shutdown) &&
+			atomic_load(&pool->queued) == 0)
+			pthread_cond_wait(&pool->wake, &pool->lock);
+		atomic_fetch_sub(&pool->sleepers, 1);
+		pthread_mutex_unlock(&pool->lock);
+
+		if (atomic_load(&pool->shutdown) &&
+			atomic_load(&pool->queued) == 0)
+			break;
+		idle = 0;
+	}
+
+	tls_worker = NULL;
+	return (NULL);
+}
@@ -0,0 +1,65 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for a small work-stealing thread pool.  Each worker
+*  owns a Chase-Lev deque (work_deque.c).  Tasks forked by a worker go on
+*  its own deque, idle workers steal from the others.  Two styles of use:
+*
+*	Submit:		PoolSubmit(pool, func, arg); ... PoolWaitAll(pool);
+*	Fork-join:	TaskGroup group;
+*			TaskGroupInit(&group);
+*			PoolSpawn(pool, &group, func, arg);  (as many as wanted)
+*			PoolJoin(pool, &group);
+*
+*  A worker waiting in PoolJoin() runs other tasks rather than blocking,
+*  so fork-join may be nested inside tasks to any depth.
+*  Compile with -pthread and C11 atomics.
+*/
+
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+/* Same layout in C and C++, so C++ callers can share TaskGroup */
+#ifdef __cplusplus
+#include <atomic>
+typedef std::atomic_long PoolCounter;
+#else
+#include <stdatomic.h>
+typedef atomic_long PoolCounter;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*TaskFunc)(void *arg);
+
+/* Called with a sub-range [low, high) of a PoolParallelFor() range */
+typedef void (*RangeFunc)(void *arg, long low, long high);
+
+typedef struct task_group {
+	PoolCounter pending;	/* Tasks spawned into the group, not yet done */
+} TaskGroup;
+
+typedef struct thread_pool ThreadPool;
+
+/* Function Prototypes */
+ThreadPool *PoolCreate(int num_threads);	/* 0 = one per core */
+void PoolDestroy(ThreadPool *pool);
+ThreadPool *PoolDefault(void);
+int PoolNumThreads(const ThreadPool *pool);
+
+int PoolSubmit(ThreadPool *pool, TaskFunc func, void *arg);
+void PoolWaitAll(ThreadPool *pool);
+
+void TaskGroupInit(TaskGroup *group);
+int PoolSpawn(ThreadPool *pool, TaskGroup *group, TaskFunc func, void *arg);
+void PoolJoin(ThreadPool *pool, TaskGroup *group);
+
+void PoolParallelFor(ThreadPool *pool, long low, long high, long grain,
+	RangeFunc func, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,613 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Word frequencies.  See word_freq.h for the interface.
+*
+*  A slot is empty while its word is NULL.  The capacity is a power of
+*  two and a word's home slot is the low bits of its hash; the full hash
+*  is kept in the slot so a probe only compares text when the hashes
+*  agree, and growing never hashes a word again.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "word_freq.h"
+#include "fast_input.h"
+#include "sort_lib.h"
+#include "thread_pool.h"
+
+#define INITIAL_SLOTS 1024	/* Must be a power of two */
+#define ARENA_BLOCK (1 << 20)	/* Bytes of word text per arena block */
+#define PIECE_MIN (8 << 20)	/* Smallest piece counted on its own thread */
+
+#define IS_WORD(c) ((unsigned char)(((c) | 0x20) - 'a') < 26 || \
+	(unsigned char)((c) - '0') < 10 || (unsigned char)(c) >= 0x80)
+
+typedef struct slot {
+	uint64_t hash;
+	unsigned long long count;
+	const char *word;
+	size_t length;
+} Slot;
+
+/* Arena blocks are chained so they can be freed; the text follows */
+typedef struct arena_block {
+	struct arena_block *next;
+} ArenaBlock;
+
+struct word_freq {
+	Slot *slots;
+	size_t capacity;	/* Slots, a power of two */
+	size_t size;		/* Distinct words */
+	unsigned long long total;
+	int fold;
+	ArenaBlock *blocks;
+	char *arena_next;	/* Free space in the newest block */
+	size_t arena_left;
+	char *scratch;		/* A word being folded */
+	size_t scratch_size;
+};
+
+typedef struct freq_job {
+	const char *data;
+	size_t *bounds;		/* Piece p is bounds[p]..bounds[p + 1] */
+	WordFreq **tables;
+	int fold;
+} FreqJob;
+
+/* Function Prototypes (local) */
+static uint64_t Hash(const char *word, size_t length);
+static Slot *Find(const WordFreq *table, const char *word, size_t length,
+	uint64_t hash);
+static int Insert(WordFreq *table, const char *word, size_t length,
+	uint64_t hash, unsigned long long count);
+static int Grow(WordFreq *table);
+static const char *ArenaCopy(WordFreq *table, const char *word,
+	size_t length);
+static int AddWord(WordFreq *table, const char *word, size_t length);
+static int AppendWord(char **buffer, size_t *size, size_t *length,
+	const char *data, size_t n);
+static void FreqPieces(void *arg, long low, long high);
+static int MoreFrequent(const void *a, const void *b);
+
+/*
+*  Function: WordFreqCreate()
+*  An empty table; with fold set, capital letters are counted as small
+*  ones.  Returns NULL if memory ran out.
+*/
+WordFreq *
+WordFreqCreate(int fold)
+{
+	WordFreq *table = (WordFreq *)calloc(1, sizeof(WordFreq));
+
+	if (table == NULL)
+		return (NULL);
+
+	table->slots = (Slot *)calloc(INITIAL_SLOTS, sizeof(Slot));
+	if (table->slots == NULL)
+	{
+		free(table);
+		return (NULL);
+	}
+	table->capacity = INITIAL_SLOTS;
+	table->fold = fold;
+	return (table);
+}
+
+/*
+*  Function: WordFreqFree()
+*/
+void
+WordFreqFree(WordFreq *table)
+{
+	ArenaBlock *block, *next;
+
+	if (table == NULL)
+		return;
+
+	for (block = table->blocks; block != NULL; block = next)
+	{
+		next = block->next;
+		free(block);
+	}
+	free(table->scratch);
+	free(table->slots);
+	free(table);
+}
+
+/*
+*  Function: WordFreqSize()
+*  The number of distinct words.
+*/
+size_t
+WordFreqSize(const WordFreq *table)
+{
+	return (table->size);
+}
+
+/*
+*  Function: WordFreqTotal()
+*  The number of words counted, repeats and all.
+*/
+unsigned long long
+WordFreqTotal(const WordFreq *table)
+{
+	return (table->total);
+}
+
+/*
+*  Function: WordFreqAdd()
+*  Counts word count more times.  The word is taken as given, without
+*  folding.  Returns 1, or 0 if memory ran out.
+*/
+int
+WordFreqAdd(WordFreq *table, const char *word, size_t length,
+	unsigned long long count)
+{
+	uint64_t hash = Hash(word, length);
+	Slot *slot = Find(table, word, length, hash);
+
+	if (slot->word != NULL)
+	{
+		slot->count += count;
+		table->total += count;
+		return (1);
+	}
+	return (Insert(table, word, length, hash, count));
+}
+
+/*
+*  Function: WordFreqCount()
+*  How many times word has been counted.
+*/
+unsigned long long
+WordFreqCount(const WordFreq *table, const char *word, size_t length)
+{
+	Slot *slot = Find(table, word, length, Hash(word, length));
+
+	return (slot->word != NULL ? slot->count : 0);
+}
+
+/*
+*  Function: WordFreqText()
+*  Counts the words in text.  If rest is not NULL a word running to the
+*  end of the text is taken to go on in the next block: it is not
+*  counted and *rest is set to its length (0 if the text ends between
+*  words).  Returns 1, or 0 if memory ran out.
+*/
+int
+WordFreqText(WordFreq *table, const char *text, size_t length,
+	size_t *rest)
+{
+	size_t i = 0, start;
+
+	if (rest != NULL)
+		*rest = 0;
+
+	for (;;)
+	{
+		while (i < length && !IS_WORD(text[i]))
+			i++;
+		if (i == length)
+			return (1);
+
+		start = i;
+		while (i < length && IS_WORD(text[i]))
+			i++;
+		if (i == length && rest != NULL)
+		{
+			*rest = i - start;
+			return (1);
+		}
+		if (!AddWord(table, text + start, i - start))
+			return (0);
+	}
+}
+
+/*
+*  Function: WordFreqFile()
+*  Counts the words of in from where it is.  Returns 1, or 0 if a read
+*  failed or memory ran out.
+*/
+int
+WordFreqFile(WordFreq *table, FILE *in)
+{
+	FastInput input;
+	ThreadPool *pool = NULL;
+	FreqJob job;
+	const char *data;
+	char *carry = NULL;
+	size_t length, rest, start, carry_size = 0, carry_length = 0;
+	size_t num_pieces = 1, p, b;
+	int ok = 1;
+
+	if (!FastInputOpen(&input, in))
+		return (0);
+
+	if (!FastInputMapped(&input))
+	{
+		/* A word cut by the end of a block is carried into the next */
+		while (ok && (length = FastInputBlock(&input, &data)) > 0)
+		{
+			start = 0;
+			if (carry_length > 0)
+			{
+				while (start < length && IS_WORD(data[start]))
+					start++;
+				ok = AppendWord(&carry, &carry_size, &carry_length,
+					data, start);
+				if (!ok || start == length)
+					continue;
+				ok = AddWord(table, carry, carry_length);
+				carry_length = 0;
+			}
+			if (ok)
+				ok = WordFreqText(table, data + start, length - start,
+					&rest);
+			if (ok && rest > 0)
+				ok = AppendWord(&carry, &carry_size, &carry_length,
+					data + length - rest, rest);
+		}
+		if (ok && carry_length > 0)
+			ok = AddWord(table, carry, carry_length);
+		ok = ok && !FastInputError(&input);
+		free(carry);
+		FastInputClose(&input);
+		return (ok);
+	}
+
+	length = FastInputBlock(&input, &data);
+	if (length >= 2 * PIECE_MIN)
+	{
+		pool = PoolDefault();
+		if (pool != NULL && PoolNumThreads(pool) >= 2)
+		{
+			/* One piece, and so one table to merge, a thread */
+			num_pieces = length / PIECE_MIN;
+			if (num_pieces > (size_t)PoolNumThreads(pool))
+				num_pieces = (size_t)PoolNumThreads(pool);
+		}
+	}
+
+	job.bounds = NULL;
+	job.tables = NULL;
+	if (num_pieces > 1)
+	{
+		job.bounds = (size_t *)malloc((num_pieces + 1) * sizeof(size_t));
+		job.tables = (WordFreq **)calloc(num_pieces, sizeof(WordFreq *));
+	}
+	if (job.bounds == NULL || job.tables == NULL)
+	{
+		ok = WordFreqText(table, data, length, NULL);
+		free(job.bounds);
+		free(job.tables);
+		FastInputClose(&input);
+		return (ok);
+	}
+
+	/* Each cut is moved on past the word it falls in */
+	job.data = data;
+	job.fold = table->fold;
+	job.bounds[0] = 0;
+	for (p = 1; p < num_pieces; p++)
+	{
+		b = p * (length / num_pieces);
+		while (b < length && IS_WORD(data[b]))
+			b++;
+		job.bounds[p] = (b > job.bounds[p - 1]) ? b : job.bounds[p - 1];
+	}
+	job.bounds[num_pieces] = length;
+
+	PoolParallelFor(pool, 0, (long)num_pieces, 1, FreqPieces, &job);
+
+	for (p = 0; p < num_pieces; p++)
+	{
+		if (job.tables[p] == NULL)
+			ok = 0;
+		else if (ok)
+			ok = WordFreqMerge(table, job.tables[p]);
+		WordFreqFree(job.tables[p]);
+	}
+	free(job.bounds);
+	free(job.tables);
+	FastInputClose(&input);
+	return (ok);
+}
+
+/*
+*  Function: WordFreqMerge()
+*  Adds the counts of from into into.  Returns 1, or 0 if memory ran
+*  out.
+*/
+int
+WordFreqMerge(WordFreq *into, const WordFreq *from)
+{
+	const Slot *slot, *last = from->slots + from->capacity;
+	Slot *found;
+
+	for (slot = from->slots; slot < last; slot++)
+	{
+		if (slot->word == NULL)
+			continue;
+		found = Find(into, slot->word, slot->length, slot->hash);
+		if (found->word != NULL)
+		{
+			found->count += slot->count;
+			into->total += slot->count;
+		}
+		else if (!Insert(into, slot->word, slot->length, slot->hash,
+			slot->count))
+			return (0);
+	}
+	return (1);
+}
+
+/*
+*  Function: WordFreqTop()
+*  Fills top with the n most frequent words, most first and ties in
+*  byte order, and returns how many it filled (fewer than n if there
+*  are not that many words, 0 if memory ran out).  The words point into
+*  the table.
+*/
+size_t
+WordFreqTop(const WordFreq *table, WordCount top[], size_t n)
+{
+	SortTop best;
+	WordCount entry;
+	const Slot *slot, *last = table->slots + table->capacity;
+	void *items;
+	size_t count;
+
+	if (n == 0 || !SortTopInit(&best, n, sizeof(WordCount), MoreFrequent))
+		return (0);
+
+	for (slot = table->slots; slot < last; slot++)
+	{
+		if (slot->word == NULL)
+			continue;
+		entry.word = slot->word;
+		entry.length = slot->length;
+		entry.count = slot->count;
+		SortTopAdd(&best, &entry);
+	}
+
+	items = SortTopFinish(&best, &count);
+	memcpy(top, items, count * sizeof(WordCount));
+	SortTopFree(&best);
+	return (count);
+}
+
+/*
+*  Function: Hash()
+*  Mixes the word in 8 bytes at a time, then finishes as MurmurHash3's
+*  64 bit finaliser does so the low bits depend on every byte.
+*/
+static uint64_t
+Hash(const char *word, size_t length)
+{
+	uint64_t hash = (uint64_t)length * 0x9e3779b97f4a7c15ULL, chunk;
+
+	for (; length >= 8; word += 8, length -= 8)
+	{
+		memcpy(&chunk, word, 8);
+		hash = (hash ^ chunk) * 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 32;
+	}
+	if (length > 0)
+	{
+		chunk = 0;
+		memcpy(&chunk, word, length);
+		hash = (hash ^ chunk) * 0xff51afd7ed558ccdULL;
+	}
+
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return (hash);
+}
+
+/*
+*  Function: Find()
+*  The slot holding word, or the empty slot where it would go.
+*/
+static Slot *
+Find(const WordFreq *table, const char *word, size_t length, uint64_t hash)
+{
+	size_t mask = table->capacity - 1, i = (size_t)hash & mask;
+	Slot *slot;
+
+	for (;; i = (i + 1) & mask)
+	{
+		slot = &table->slots[i];
+		if (slot->word == NULL ||
+			(slot->hash == hash && slot->length == length &&
+			memcmp(slot->word, word, length) == 0))
+			return (slot);
+	}
+}
+
+/*
+*  Function: Insert()
+*  Adds a word not in the table, copying its text to the arena.
+*/
+static int
+Insert(WordFreq *table, const char *word, size_t length, uint64_t hash,
+	unsigned long long count)
+{
+	Slot *slot;
+	const char *copy;
+
+	if (10 * (table->size + 1) > 7 * table->capacity && !Grow(table))
+		return (0);
+
+	copy = ArenaCopy(table, word, length);
+	if (copy == NULL)
+		return (0);
+
+	slot = Find(table, word, length, hash);
+	slot->hash = hash;
+	slot->count = count;
+	slot->word = copy;
+	slot->length = length;
+	table->size++;
+	table->total += count;
+	return (1);
+}
+
+/*
+*  Function: Grow()
+*  Doubles the slots, placing every word again by its kept hash.
+*/
+static int
+Grow(WordFreq *table)
+{
+	size_t capacity = 2 * table->capacity, mask = capacity - 1, i, j;
+	Slot *slots = (Slot *)calloc(capacity, sizeof(Slot));
+
+	if (slots == NULL)
+		return (0);
+
+	for (i = 0; i < table->capacity; i++)
+	{
+		if (table->slots[i].word == NULL)
+			continue;
+		for (j = (size_t)table->slots[i].hash & mask;
+			slots[j].word != NULL; j = (j + 1) & mask)
+			;
+		slots[j] = table->slots[i];
+	}
+
+	free(table->slots);
+	table->slots = slots;
+	table->capacity = capacity;
+	return (1);
+}
+
+/*
+*  Function: ArenaCopy()
+*  A lasting copy of word.  A new block is started when the newest is
+*  too full; a word longer than a block gets a block of its own.
+*/
+static const char *
+ArenaCopy(WordFreq *table, const char *word, size_t length)
+{
+	ArenaBlock *block;
+	size_t size = (length > ARENA_BLOCK) ? length : ARENA_BLOCK;
+	char *copy;
+
+	if (length > table->arena_left || table->blocks == NULL)
+	{
+		block = (ArenaBlock *)malloc(sizeof(ArenaBlock) + size);
+		if (block == NULL)
+			return (NULL);
+		block->next = table->blocks;
+		table->blocks = block;
+		table->arena_next = (char *)(block + 1);
+		table->arena_left = size;
+	}
+
+	copy = table->arena_next;
+	memcpy(copy, word, length);
+	table->arena_next += length;
+	table->arena_left -= length;
+	return (copy);
+}
+
+/*
+*  Function: AddWord()
+*  Counts one word of a text, folding it first if the table folds.
+*/
+static int
+AddWord(WordFreq *table, const char *word, size_t length)
+{
+	char *bigger;
+	size_t i;
+
+	if (!table->fold)
+		return (WordFreqAdd(table, word, length, 1));
+
+	if (length > table->scratch_size)
+	{
+		bigger = (char *)realloc(table->scratch, 2 * length);
+		if (bigger == NULL)
+			return (0);
+		table->scratch = bigger;
+		table->scratch_size = 2 * length;
+	}
+	for (i = 0; i < length; i++)
+		table->scratch[i] = ((unsigned char)(word[i] - 'A') < 26) ?
+			(char)(word[i] | 0x20) : word[i];
+	return (WordFreqAdd(table, table->scratch, length, 1));
+}
+
+/*
+*  Function: AppendWord()
+*  Adds n bytes of data to the end of a growing buffer.
+*/
+static int
+AppendWord(char **buffer, size_t *size, size_t *length, const char *data,
+	size_t n)
+{
+	char *bigger;
+	size_t needed = *length + n;
+
+	if (needed > *size)
+	{
+		bigger = (char *)realloc(*buffer, 2 * needed);
+		if (bigger == NULL)
+			return (0);
+		*buffer = bigger;
+		*size = 2 * needed;
+	}
+	memcpy(*buffer + *length, data, n);
+	*length = needed;
+	return (1);
+}
+
+/*
+*  Function: FreqPieces()
+*  Counts pieces low..high - 1 of a mapped file, each into a table of
+*  its own, left NULL if memory ran out.
+*/
+static void
+FreqPieces(void *arg, long low, long high)
+{
+	FreqJob *job = (FreqJob *)arg;
+	size_t start;
+	long p;
+
+	for (p = low; p < high; p++)
+	{
+		job->tables[p] = WordFreqCreate(job->fold);
+		if (job->tables[p] == NULL)
+			continue;
+		start = job->bounds[p];
+		if (!WordFreqText(job->tables[p], job->data + start,
+			job->bounds[p + 1] - start, NULL))
+		{
+			WordFreqFree(job->tables[p]);
+			job->tables[p] = NULL;
+		}
+	}
+}
+
+/*
+*  Function: MoreFrequent()
+*  Orders WordCounts by count, largest first, then by their bytes.
+*/
+static int
+MoreFrequent(const void *a, const void *b)
+{
+	const WordCount *x = (const WordCount *)a, *y = (const WordCount *)b;
+	size_t shorter = (x->length < y->length) ? x->length : y->length;
+	int order;
+
+	if (x->count != y->count)
+		return ((x->count > y->count) ? -1 : 1);
+	order = memcmp(x->word, y->word, shorter);
+	if (order != 0)
+		return (order);
+	return ((x->length > y->length) - (x->length < y->length));
+}
@@ -0,0 +1,68 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for counting how often each word occurs in a text.
+*  A word is a run of letters, digits and bytes of 128 and up (so UTF-8
+*  letters stay inside words); anything else separates words.  With
+*  fold set, A to Z count as a to z.
+*
+*  The counts are kept in an open addressing hash table (linear probing,
+*  grown at 70% full), one slot per distinct word holding its hash, its
+*  count and where its text is.  The text of every word is copied once,
+*  when first seen, into large blocks of an arena that are freed
+*  together, so counting any number of words makes no allocation per
+*  word.
+*
+*	WordFreqCreate/Free()	A table.
+*	WordFreqAdd()		Counts a word given n times.
+*	WordFreqText()		Counts the words of a block of text.
+*	WordFreqFile()		Counts the words of a file.  A large mapped
+*				file is cut into one piece per thread, at
+*				word boundaries, each counted into its own
+*				table on the thread pool, and the tables
+*				merged at the end.
+*	WordFreqMerge()		Adds one table's counts into another.
+*	WordFreqTop()		The n most frequent words, most first.
+*
+*  Compile with word_freq.c, fast_input.c, sort_lib.c, thread_pool.c,
+*  work_deque.c and -pthread.
+*/
+
+#ifndef _WORD_FREQ_H_
+#define _WORD_FREQ_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct word_freq WordFreq;
+
+typedef struct word_count {
+	const char *word;	/* Not '\0' ended; belongs to the table */
+	size_t length;
+	unsigned long long count;
+} WordCount;
+
+/* Function Prototypes */
+WordFreq *WordFreqCreate(int fold);
+void WordFreqFree(WordFreq *table);
+size_t WordFreqSize(const WordFreq *table);
+unsigned long long WordFreqTotal(const WordFreq *table);
+
+int WordFreqAdd(WordFreq *table, const char *word, size_t length,
+	unsigned long long count);
+unsigned long long WordFreqCount(const WordFreq *table, const char *word,
+	size_t length);
+int WordFreqText(WordFreq *table, const char *text, size_t length,
+	size_t *rest);
+int WordFreqFile(WordFreq *table, FILE *in);
+int WordFreqMerge(WordFreq *into, const WordFreq *from);
+size_t WordFreqTop(const WordFreq *table, WordCount top[], size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
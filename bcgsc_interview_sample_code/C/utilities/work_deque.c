@@ -0,0 +1,228 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Chase-Lev work-stealing deque, following the C11 memory
+*  ordering given by Le, Pop, Cohen and Zappa Nardelli (PPoPP 2013).
+*  See work_deque.h for the interface.
+*/
+
+#include <stdlib.h>
+#include "work_deque.h"
+
+/* Function Prototypes (local) */
+static DequeRing *NewRing(long size);
+static DequeRing *GrowRing(WorkDeque *deque, DequeRing *ring, long top,
+	long bottom);
+
+/*
+*  Function: NewRing()
+*/
+static DequeRing *
+NewRing(long size)
+{
+	DequeRing *ring;
+	long i;
+
+	ring = (DequeRing *)malloc(sizeof(DequeRing));
+	if (ring == NULL)
+		return (NULL);
+
+	ring->items = malloc(size * sizeof(*ring->items));
+	if (ring->items == NULL)
+	{
+		free(ring);
+		return (NULL);
+	}
+
+	for (i = 0; i < size; i++)
+		atomic_init(&ring->items[i], NULL);
+
+	ring->size = size;
+	ring->older = NULL;
+	return (ring);
+}
+
+/*
+*  Function: GrowRing()
+*  Copies the live items into a ring twice the size and publishes it.
+*  Only the owner calls this, thieves may still be reading the old ring
+*  so it is chained on rather than freed.
+*/
+static DequeRing *
+GrowRing(WorkDeque *deque, DequeRing *ring, long top, long bottom)
+{
+	DequeRing *bigger;
+	long i;
+	void *item;
+
+	bigger = NewRing(ring->size * 2);
+	if (bigger == NULL)
+		return (NULL);
+
+	for (i = top; i < bottom; i++)
+	{
+		item = atomic_load_explicit(&ring->items[i & (ring->size - 1)],
+			memory_order_relaxed);
+		atomic_store_explicit(&bigger->items[i & (bigger->size - 1)],
+			item, memory_order_relaxed);
+	}
+
+	bigger->older = ring;
+	atomic_store_explicit(&deque->ring, bigger, memory_order_release);
+	return (bigger);
+}
+
+/*
+*  Function: WorkDequeInit()
+*  Returns 1 on success, 0 if memory ran out.
+*/
+int
+WorkDequeInit(WorkDeque *deque)
+{
+	DequeRing *ring;
+
+	ring = NewRing(WORK_DEQUE_MIN_SIZE);
+	if (ring == NULL)
+		return (0);
+
+	atomic_init(&deque->top, 0);
+	atomic_init(&deque->bottom, 0);
+	atomic_init(&deque->ring, ring);
+	return (1);
+}
+
+/*
+*  Function: WorkDequeDestroy()
+*  Frees the current ring and every retired one.  No other thread may be
+*  using the deque.
+*/
+void
+WorkDequeDestroy(WorkDeque *deque)
+{
+	DequeRing *ring;
+	DequeRing *older;
+
+	ring = atomic_load_explicit(&deque->ring, memory_order_relaxed);
+	while (ring != NULL)
+	{
+		older = ring->older;
+		free(ring->items);
+		free(ring);
+		ring = older;
+	}
+	atomic_store_explicit(&deque->ring, NULL, memory_order_relaxed);
+}
+
+/*
+*  Function: WorkDequePush()
+*  Owner only.  Returns 0 if the ring needed to grow and memory ran out.
+*/
+int
+WorkDequePush(WorkDeque *deque, void *item)
+{
+	long bottom, top;
+	DequeRing *ring;
+
+	bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	ring = atomic_load_explicit(&deque->ring, memory_order_relaxed);
+
+	if (bottom - top > ring->size - 1)
+	{
+		ring = GrowRing(deque, ring, top, bottom);
+		if (ring == NULL)
+			return (0);
+	}
+
+	atomic_store_explicit(&ring->items[bottom & (ring->size - 1)], item,
+		memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+	return (1);
+}
+
+/*
+*  Function: WorkDequePop()
+*  Owner only.  Takes the most recently pushed item, or returns NULL if
+*  the deque is empty (or a thief took the last item first).
+*/
+void *
+WorkDequePop(WorkDeque *deque)
+{
+	long bottom, top;
+	DequeRing *ring;
+	void *item;
+
+	bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+	ring = atomic_load_explicit(&deque->ring, memory_order_relaxed);
+	atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		/* Already empty, undo the claim */
+		atomic_store_explicit(&deque->bottom, bottom + 1,
+			memory_order_relaxed);
+		return (NULL);
+	}
+
+	item = atomic_load_explicit(&ring->items[bottom & (ring->size - 1)],
+		memory_order_relaxed);
+
+	if (top == bottom)
+	{
+		/* Last item, race the thieves for it */
+		if (!atomic_compare_exchange_strong_explicit(&deque->top, &top,
+			top + 1, memory_order_seq_cst, memory_order_relaxed))
+			item = NULL;
+		atomic_store_explicit(&deque->bottom, bottom + 1,
+			memory_order_relaxed);
+	}
+
+	return (item);
+}
+
+/*
+*  Function: WorkDequeSteal()
+*  Any thread.  Takes the oldest item.  Returns NULL if the deque is
+*  empty, or WORK_DEQUE_ABORT if another thread got there first (the
+*  caller may simply try again or try another deque).
+*/
+void *
+WorkDequeSteal(WorkDeque *deque)
+{
+	long bottom, top;
+	DequeRing *ring;
+	void *item;
+
+	top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+	if (top >= bottom)
+		return (NULL);
+
+	ring = atomic_load_explicit(&deque->ring, memory_order_acquire);
+	item = atomic_load_explicit(&ring->items[top & (ring->size - 1)],
+		memory_order_relaxed);
+
+	if (!atomic_compare_exchange_strong_explicit(&deque->top, &top,
+		top + 1, memory_order_seq_cst, memory_order_relaxed))
+		return (WORK_DEQUE_ABORT);
+
+	return (item);
+}
+
+/*
+*  Function: WorkDequeSize()
+*  A snapshot only, it may be out of date by the time it is used.
+*/
+long
+WorkDequeSize(WorkDeque *deque)
+{
+	long bottom, top;
+
+	bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	return (bottom > top ? bottom - top : 0);
+}
@@ -0,0 +1,50 @@
+/* Author: Malachi Griffith
+*  Date: Oct. 19 2026
+*  Purpose: Interface for a Chase-Lev work-stealing deque.  One thread
+*  (the owner) pushes and pops at the bottom like a stack, any number of
+*  other threads may steal from the top.  The owner never takes a lock,
+*  thieves only race each other on a single compare-and-swap.  The ring
+*  buffer doubles when it fills, old rings are kept until the deque is
+*  destroyed so a slow thief can never read freed memory.
+*  Needs C11 atomics (gcc -std=c11 or later).
+*/
+
+#ifndef _WORK_DEQUE_H_
+#define _WORK_DEQUE_H_
+
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WORK_DEQUE_MIN_SIZE 64
+
+/* Returned by WorkDequeSteal() when another thief won the race */
+#define WORK_DEQUE_ABORT ((void *)-1)
+
+typedef struct deque_ring {
+	long size;			/* Always a power of 2 */
+	_Atomic(void *) *items;
+	struct deque_ring *older;	/* Retired ring, freed on destroy */
+} DequeRing;
+
+typedef struct work_deque {
+	atomic_long top;		/* Next item a thief will take */
+	atomic_long bottom;		/* Next free slot for the owner */
+	_Atomic(DequeRing *) ring;
+} WorkDeque;
+
+/* Function Prototypes */
+int WorkDequeInit(WorkDeque *deque);
+void WorkDequeDestroy(WorkDeque *deque);
+int WorkDequePush(WorkDeque *deque, void *item);	/* owner only */
+void *WorkDequePop(WorkDeque *deque);			/* owner only */
+void *WorkDequeSteal(WorkDeque *deque);			/* any thread */
+long WorkDequeSize(WorkDeque *deque);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -3,14 +3,27 @@
 *  Purpose: Function that searches for target item in first element of array
 *  arr and Returns index of target or NOT_FOUND.
 *  Pre: target and first n elements of array arr are defined n>=0.
+*  search_many() answers a whole list of targets, indexing arr once with
+*  the search index in bcgsc_interview_sample_code/C/utilities so each
+*  target costs O(log n) instead of a pass over arr.
+*  Compile: U=../../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -pthread -c -I$U function_search.c, and link with
+*           $U/search_index.c $U/sort_lib.c $U/thread_pool.c
+*           $U/work_deque.c
 */
 
+#include "search_index.h"
+
 #define NOT_FOUND -1
 
+int search(const int arr[], int target, int n);
+void search_many(const int arr[], int n, const int targets[], int where[],
+	int num_targets);
+
 int
 search (const int arr[],	/* input- array to search */
 	int 	target,		/* input value searched for */
-	int 	n 		/* input - number of elements to search */
+	int 	n) 		/* input - number of elements to search */
 {
 	int i,
 	found = 0,	/* whether or not the target has been found */
@@ -34,3 +47,35 @@ search (const int arr[],	/* input- array to search */
 	
 	return(where);
 }
+/*
+*  Function: search_many
+*  where[i] gets search(arr, targets[i], n) for each of the num_targets
+*  targets: the first index of the target, or NOT_FOUND.
+*/
+void
+search_many(const int arr[],	/* input - array to search */
+	int	n,		/* input - number of elements to search */
+	const int targets[],	/* input - values searched for */
+	int	where[],	/* output - index of each target */
+	int	num_targets)	/* input - number of targets */
+{
+	SearchIndex index;
+	long position;
+	int i;
+
+	/* Out of memory for the index, search the slow way */
+	if (!SearchIndexBuild(&index, arr, n, SEARCH_FIRST))
+	{
+		for (i = 0; i < num_targets; i++)
+			where[i] = search(arr, targets[i], n);
+		return;
+	}
+
+	for (i = 0; i < num_targets; i++)
+	{
+		position = SearchIndexFind(&index, targets[i]);
+		where[i] = (position == SEARCH_NOT_FOUND) ? NOT_FOUND : (int)position;
+	}
+
+	SearchIndexFree(&index);
+}
@@ -6,6 +6,13 @@
 *  It then prints the number of occurences of each lower and upper case 
 *  letter of the alphabet.  Letters that do not appear in the data file will
 *  not be shown as 0, but simply omitted from the print out.
+*  The file may be of any size: it is counted as a whole with the byte
+*  histogram (ByteCountFile) in bcgsc_interview_sample_code/C/utilities,
+*  which maps it into memory and counts large files on several threads,
+*  rather than one fscanf() per character into a 100 character array.
+*  Compile: U=../../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -pthread -I$U letters.c $U/byte_count.c $U/fast_input.c
+*           $U/simd_search.c $U/thread_pool.c $U/work_deque.c
 */
 
 /* Note: Upper case letters correspond to 65-90 (A-Z) in ASCII.
@@ -14,25 +21,27 @@
 
 
 #include <stdio.h>
-#define MAX_DATA 100   /* Max number of letters processed from data file */
+#include "byte_count.h"
 #define MAX_LETTERS 26 /* Max array size for tallying number of each letter.*/
 
 /* Function Prototype */
-void read_array(char data[], int *size);
-void process_array(const char data[], int size, int upper[], int lower[]);
-void print_array(const int upper[], const int lower[]);
+int read_counts(ByteCounts *counts);
+void process_array(const ByteCounts *counts, unsigned long long upper[],
+		   unsigned long long lower[]);
+void print_array(const unsigned long long upper[],
+		 const unsigned long long lower[]);
 
 main()
 {
-	int size_local;
-	char letters[MAX_DATA];
+	ByteCounts counts;
 	
-	int upper[MAX_LETTERS] = {0};
-	int lower[MAX_LETTERS] = {0};
+	unsigned long long upper[MAX_LETTERS] = {0};
+	unsigned long long lower[MAX_LETTERS] = {0};
 
-	read_array(letters, &size_local);
+	if (!read_counts(&counts))
+		return(1);
 
-	process_array(letters, size_local, upper, lower);
+	process_array(&counts, upper, lower);
 
 	print_array(upper, lower);
  
@@ -40,52 +49,44 @@ main()
 }
 
 /*
-*  Function: read_array
+*  Function: read_counts
+*  Counts every byte of the data file.  Returns 0 if it can not be read.
 */
-void 
-read_array(char data[], int *size)
+int
+read_counts(ByteCounts *counts)
 {
-	char ch;
-	int i = 0;
+	int ok;
 
 	/* Open the input file */
 	FILE *input_data;
 	input_data = fopen("letters.dat", "r");
-
-	fscanf(input_data, "%c", &ch);
-
-	while(!feof(input_data))
+	if (input_data == NULL)
 	{
-		data[i] = ch;
-		fscanf(input_data, "%c", &ch);
-		i++;
+		fprintf(stderr, "letters: cannot open letters.dat\n");
+		return(0);
 	}
-	*size = i;
+
+	ok = ByteCountFile(input_data, counts);
 	fclose(input_data);
+	if (!ok)
+		fprintf(stderr, "letters: cannot read letters.dat\n");
+	return(ok);
 }
 
 /*
 *  Function: process_array
+*  Picks the letters out of the count of every byte value.
 */
 void 
-process_array(const char data[], int size, int upper[], int lower[])
+process_array(const ByteCounts *counts, unsigned long long upper[],
+	      unsigned long long lower[])
 {
 	int i;
-	char ch_value;
 
-	for(i = 0; i <= size; i++)
+	for(i = 0; i < MAX_LETTERS; i++)
 	{
-		if (data[i] >= 65 && data[i] <= 90)
-		{
-			ch_value = data[i] - 65;
-			upper[ch_value]++;
-		}		
-		
-		if (data[i] >= 97 && data[i] <= 122)
-		{
-			ch_value = data[i] - 97;
-			lower[ch_value]++;
-		}
+		upper[i] = counts->counts[65 + i];
+		lower[i] = counts->counts[97 + i];
 	}
 }
 
@@ -94,7 +95,8 @@ process_array(const char data[], int size, int upper[], int lower[])
 *  Function: print_array
 */
 void 
-print_array(const int upper[], const int lower[])
+print_array(const unsigned long long upper[],
+	    const unsigned long long lower[])
 {
 	char ch;
 	int i;
@@ -111,7 +113,7 @@ print_array(const int upper[], const int lower[])
 	{
 		if (upper[i] > 0)
 			fprintf(output_data, 
-				"\tThe occurence of letter %c was %d\n",
+				"\tThe occurence of letter %c was %llu\n",
 				ch, upper[i]);
 		ch++;
 	}
@@ -124,7 +126,7 @@ print_array(const int upper[], const int lower[])
 	{
 		if (lower[i] > 0)
 			fprintf(output_data,
-				"\tThe occurence of letter %c was %d\n",
+				"\tThe occurence of letter %c was %llu\n",
 				ch, lower[i]);
 		ch++;
 	}
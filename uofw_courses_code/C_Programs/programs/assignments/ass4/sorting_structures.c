@@ -9,11 +9,22 @@
 *  within property class, by selling price (ascending).
 *  Finally the sorted list of data will be printed out to the file,
 *  "sorting_structures.print".
+*  The array grows as the file is read, so there is no limit on the
+*  number of sales.  The sort is the shared stable key column radix sort
+*  (SortByKeys) in bcgsc_interview_sample_code/C/utilities, and the
+*  file is read and its numbers parsed by fast_input.c from there.
+*  Compile: U=../../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -pthread -I$U sorting_structures.c $U/sort_lib.c
+*           $U/fast_input.c $U/thread_pool.c $U/work_deque.c
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "fast_input.h"
+#include "sort_lib.h"
 
-#define MAX_PROPERTIES 25  /* Max # of entries in data file */
+#define START_PROPERTIES 64  /* Room for this many before the array grows */
 
 #define COM_RATE1 0.045    /* Commission rate for class 1 property */
 #define COM_RATE2 0.050    /* Commission rate for class 2 property */
@@ -28,53 +39,110 @@ typedef struct {
 	}Sale;
 
 /* Function Prototypes */
-void read_array(Sale sales_record[], int *size);
+Sale *read_array(int *size);
 void sort_array(Sale sales_record[], int size);
-int find_min (Sale sales_record[], int start, int end);
+uint64_t class_key (const void *sale);
+uint64_t price_key (const void *sale);
+int compare_sales (const void *a, const void *b);
 void display_array(Sale sales_record[], int size);
 
 main()
 {
 	int size_local; /* Number of properties actually found in datafile */
 
-	Sale sales_record[MAX_PROPERTIES]; /* Array of structures */
+	Sale *sales_record; /* Array of structures, sized by read_array() */
 	
 	/* Call user defined functions */
-	read_array(sales_record, &size_local);
+	sales_record = read_array(&size_local);
+	if (sales_record == NULL)
+		return (1);
+
 	sort_array(sales_record, size_local);
 	display_array(sales_record, size_local);
+
+	free(sales_record);
+	return (0);
 }
 
 /*
 *  Function: read_array()
 *  Reads data from the data file "assign4.dat" and enters them into an
 *  array of structures of type Sale.  
-*  Pre: The sales_record array was defined in main.  
-*  Post: The array is filled as long as their is data in the datafile
-*  	 and the number of entries found is counted and updated in main
-*  	 as size_local. 
+*  Pre: size points to main's size_local.
+*  Post: Returns the array, allocated with malloc() and doubled in size
+*  	 whenever it fills, holding every entry in the datafile.  The
+*  	 number of entries found is updated in main as size_local.
+*  	 Returns NULL if the file can not be opened or memory runs out.
 */
-void
-read_array(Sale sales_record[], int *size)
+Sale *
+read_array(int *size)
 {
 	FILE *input_data;  /* File pointer for input datafile */
+	FastInput input;   /* Reads it in blocks */
+	long property_class;
+	double selling_price;
+	Sale *sales_record;  /* The array being filled */
+	Sale *bigger;	     /* The array after growing */
+	size_t capacity = START_PROPERTIES;  /* Entries the array has room for */
 	int i = 0; 	   /* Counter in while loop and loop control 
-			    * variable in for loop.
+			    * variable in for loop. */
 	
 	/* Open the file for reading data */
 	input_data = fopen("assign4.dat", "r");
+	if (input_data == NULL)
+	{
+		printf("\n**Can not open assign4.dat**\n");
+		return (NULL);
+	}
 
-	/* Get an initial priming set of data from the file. */
-	fscanf(input_data, "%d%lf", &sales_record[i].property_class,
-	       &sales_record[i].selling_price);
+	sales_record = (Sale *)malloc(capacity * sizeof(Sale));
+	if (sales_record == NULL || !FastInputOpen(&input, input_data))
+	{
+		free(sales_record);
+		fclose(input_data);
+		return (NULL);
+	}
 
 	/* Continue to get data and count the entries until the file ends. */
-	while(!feof(input_data))
+	while (FastInputLong(&input, &property_class) &&
+	       FastInputDouble(&input, &selling_price))
 	{
+		if (property_class < INT_MIN || property_class > INT_MAX)
+		{
+			printf("\n**Property class %ld is out of range**\n",
+			       property_class);
+			free(sales_record);
+			FastInputClose(&input);
+			fclose(input_data);
+			return (NULL);
+		}
+		sales_record[i].property_class = (int)property_class;
+		sales_record[i].selling_price = selling_price;
 		i++;
-		fscanf(input_data, "%d%lf", &sales_record[i].property_class,
-	               &sales_record[i].selling_price);
+		if ((size_t)i == capacity)
+		{
+			/* Double it only while the count still fits in an int
+			 * and the size in bytes in a size_t. */
+			bigger = NULL;
+			if (capacity <= (size_t)INT_MAX / 2 &&
+			    capacity <= (size_t)-1 / 2 / sizeof(Sale))
+			{
+				capacity *= 2;
+				bigger = (Sale *)realloc(sales_record,
+							 capacity * sizeof(Sale));
+			}
+			if (bigger == NULL)
+			{
+				printf("\n**Out of memory after %d sales**\n", i);
+				free(sales_record);
+				FastInputClose(&input);
+				fclose(input_data);
+				return (NULL);
+			}
+			sales_record = bigger;
+		}
 	}
+	FastInputClose(&input);
 	*size = i;  /* Tells main() how many entries need to be processed */
 
 	/* Determine and input the commission earned for each record */
@@ -97,6 +165,7 @@ read_array(Sale sales_record[], int *size)
 			printf("\n**Error in Data File - Invalid Class**\n");
 	}
 	fclose(input_data);
+	return (sales_record);
 }
 
 /*
@@ -106,70 +175,58 @@ read_array(Sale sales_record[], int *size)
 *  Pre: The array of structures, 'sales_record' and number of entries, 'size'
 *  	are defined. 
 *  Post: Rearranges the order of the structures in the array until they 
-*	 are completely sorted.
+*	 are completely sorted.  Sales that tie on class and price keep
+*	 the order they had in the datafile.
 */
 void 
 sort_array(Sale sales_record[], int size)
 {
-	Sale temp_record;  /* Temp structure to facilitate swapping */
-	int index; 	   /* Loop control variable */
-	int current; 	   /* Position of current min found by find_min() */
+	/* Key columns, most significant first */
+	SortKeyFunc keys[2] = {class_key, price_key};
 
-	/* Examine every position in the array and at each position place 
-	*  the current min value at that position unless there already */
-	for (index = 0; index < size -1; index++)
-	{
-		current = find_min(sales_record, index, size);
-		
-		/* As long as the current min differs from the position
-		*  being considered, do a swap. */
-		if (index != current)
-		{
-			temp_record = sales_record[index];
-			sales_record[index] = sales_record[current];
-			sales_record[current] = temp_record;
-		}
-	}
+	/* The radix sort needs scratch memory, the introsort does not */
+	if (!SortByKeys(sales_record, size, sizeof(Sale), keys, 2))
+		SortIntro(sales_record, size, sizeof(Sale), compare_sales);
 }
 
 /*
-*  Function: find_min()
-*  This function is a helper function that finds the current minimum value
-*  from a given starting point sent to the end of the array.
-*  Pre: The sales_record array, starting point, and size of the array are
-*       defined.
-*  Post: The position of the current minimum value within the subarray is
-* 	 returned to sort_array as an integer.
+*  Function: class_key() and price_key()
+*  The two key columns for sort_array(), as unsigned numbers that sort
+*  in the same order as the class and price themselves.
+*/
+uint64_t
+class_key (const void *sale)
+{
+	return (SortKeyInt(((const Sale *)sale)->property_class));
+}
+
+uint64_t
+price_key (const void *sale)
+{
+	return (SortKeyDouble(((const Sale *)sale)->selling_price));
+}
+
+/*
+*  Function: compare_sales()
+*  The same ordering as a comparison, for when SortByKeys() runs out of
+*  memory: property class first, then selling price within the same class.
+*  Pre: a and b point to two Sale structures.
+*  Post: Returns -ve if a comes first, +ve if b comes first, 0 if they
+*	 tie on both class and price.
 */
 int 
-find_min (Sale sales_record[], int start, int end)
+compare_sales (const void *a, const void *b)
 {
-	int current;  /* Current minimum position */
-	int i; 	      /* Loop control variable */
- 
-	current = start; /* Initially set current min to the first position
-			 *  in the subarray being considered. */
-
-	/* Scan through the subarray */
-	for (i = start + 1; i < end; i++)
-	{
-	/* If the property class is LOWER than the current minimum then 
-	*  this position is definitely a new minimum position */ 
-	   if (sales_record[i].property_class < 
-	       sales_record[current].property_class)
-			current = i;
-
-	/* If the property class is the SAME as the current minimum then
-	*  this position is only a new minimum if the selling price is 
-	*  also lower!. */
-	   else if ((sales_record[i].property_class ==
-	   	    sales_record[current].property_class) && 
-		    (sales_record[i].selling_price <
-		     sales_record[current].selling_price))
-			current = i;
-	}
+	const Sale *first = (const Sale *)a;
+	const Sale *second = (const Sale *)b;
+
+	/* A LOWER property class always comes first */
+	if (first->property_class != second->property_class)
+		return (first->property_class < second->property_class ? -1 : 1);
 
-	return (current);  /* Return the new current minimum to sort_array */
+	/* Same class, so the lower selling price comes first */
+	return ((first->selling_price > second->selling_price) -
+		(first->selling_price < second->selling_price));
 }
 
 /*
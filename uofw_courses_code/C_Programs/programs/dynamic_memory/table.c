@@ -2,11 +2,15 @@
 *  Date: Nov. 21 2002 
 *  Purpose: Illustrate the use of tables constructed as an array of 
 *  structures.  
+*  Compile: U=../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -pthread -I$U table.c $U/sort_lib.c $U/thread_pool.c
+*           $U/work_deque.c
 */
 
 #include <stdio.h>
 #include <stdlib.h>  /* Needed for dynamic memory allocation */
 #include <string.h>
+#include "sort_lib.h"
 
 #define MAX_CHAR 8
 #define TABLE_SIZE 5
@@ -21,6 +25,7 @@ typedef struct {
 void Read_table(Inventory []);
 void Print_table(Inventory []);
 void Sort_table(Inventory []);
+int Compare_parts(const void *, const void *);
 
 main()
 {
@@ -82,45 +87,21 @@ Print_table(Inventory inventory_table[TABLE_SIZE])
 
 /*
 *  Function: Sort_table()
-*  This function performs a bubble sort on a table of type Inventory 
+*  Sorts a table of type Inventory by part number, using the shared
+*  introsort (sort_lib.c) in place of a bubble sort.
 */
 void
 Sort_table(Inventory inventory_table[TABLE_SIZE])
 {
-	Inventory temp;
-
-	int limit;
-	int exchange;
-	int index;
-	int flag;
-
-	index = 0;
-	limit = TABLE_SIZE - 1;
-	flag = 1;
-	exchange = 0;
-
-	while (flag)  /* ie. while flag is 1 not 0. */
-	{
-		flag = 0; /* Will be changed back to 1 if exchange occurs */
-
-		for (index = 0; index < limit; index++)
-		{
-			/* Compare first part number to next one, etc. */
-			if(strcmp(inventory_table[index].part_number,
-			   inventory_table[index + 1].part_number) > 0)
-			   {
-			   /* If bigger it 'floats' up (swaps with next) */ 
-			   temp = inventory_table[index];
-			   inventory_table[index]=inventory_table[index+1];
-			   inventory_table[index+1] = temp;
-			   flag = 1; /* Because an exchange has occured */
-			   /* Update position of last exchange */ 
-			   exchange = index; 
-			   }
-		}
-		/* Position of last exchange for that pass.  If an exchange 
-		*  occured, another pass will take place, etc. until no
-		*  exchanges occur. */
-		limit = exchange;
-	}
+	SortIntro(inventory_table, TABLE_SIZE, sizeof(Inventory), Compare_parts);
+}
+/*
+*  Function: Compare_parts()
+*  Orders two Inventory rows by part number.
+*/
+int
+Compare_parts(const void *a, const void *b)
+{
+	return (strcmp(((const Inventory *)a)->part_number,
+		((const Inventory *)b)->part_number));
 }
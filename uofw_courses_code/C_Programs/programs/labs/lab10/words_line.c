@@ -3,35 +3,94 @@
 /* Author: Malachi Griffith
 *  Date: Nov. 7 2002 
 *  Purpose: Will count the number of words in a line.
+*  It now counts the lines, words and characters of whole files of any
+*  size, as wc does: a word is a run of characters that are not spaces,
+*  tabs or line ends.  The counting is ByteWordsFile() from
+*  bcgsc_interview_sample_code/C/utilities/byte_count.c, which maps the
+*  file into memory, splits a large one into pieces counted in parallel
+*  on the thread pool (a word crossing into the next piece is counted
+*  once) and tests 32 characters at a time.
+*
+*  Usage: words_line [file ...]
+*  With no file sentence.dat is counted; "-" is the standard input.
+*  With more than one file a total is printed too.
+*
+*  Compile: U=../../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -pthread -I$U words_line.c $U/byte_count.c $U/fast_input.c
+*           $U/simd_search.c $U/thread_pool.c $U/work_deque.c
 */
 
 #include <stdio.h>
+#include <string.h>
+#include "byte_count.h"
 
-#define MAX_SIZE 81
+/* Function Prototypes */
+int count_file(const char *file_name, ByteWords *words);
+void print_counts(const ByteWords *words, const char *name);
 
-main()
+int
+main(int argc, char *argv[])
 {
-	char string[MAX_SIZE];
-	int i;
-	int word_count = 0;
+	ByteWords words, total;
+	int i, status = 0;
 
-	FILE *input_string;
-	input_string = fopen("sentence.dat", "r");
-
-	fgets(string, MAX_SIZE, input_string);
-	
-	printf("\n");
+	if (argc < 2)
+	{
+		if (!count_file("sentence.dat", &words))
+			return(1);
+		print_counts(&words, "sentence.dat");
+		return(0);
+	}
 
-	for(i = 0; string[i] != '\0'; i++)
+	ByteWordsInit(&total);
+	for (i = 1; i < argc; i++)
 	{
-		printf("%c", string[i]);
-		if (string[i] == ' ' || string[i] == '.')
-			word_count++;	
+		if (!count_file(argv[i], &words))
+		{
+			status = 1;
+			continue;
+		}
+		print_counts(&words, argv[i]);
+		total.lines += words.lines;
+		total.words += words.words;
+		total.bytes += words.bytes;
 	}
-	printf("\nThe word count for this sentence is %d\n\n", word_count);
+
+	if (argc > 2)
+		print_counts(&total, "total");
+	return(status);
 }
 
+/*
+*  Counts the lines, words and characters of file_name ("-" for the
+*  standard input).  Returns 0, having said why, if it can not be read.
+*/
+int
+count_file(const char *file_name, ByteWords *words)
+{
+	FILE *input;
+	int ok;
 
+	if (strcmp(file_name, "-") == 0)
+		return(ByteWordsFile(stdin, words));
 
+	input = fopen(file_name, "r");
+	if (input == NULL)
+	{
+		fprintf(stderr, "words_line: cannot open %s\n", file_name);
+		return(0);
+	}
 
+	ok = ByteWordsFile(input, words);
+	fclose(input);
+	if (!ok)
+		fprintf(stderr, "words_line: cannot read %s\n", file_name);
+	return(ok);
+}
 
+void
+print_counts(const ByteWords *words, const char *name)
+{
+	printf("%8llu %8llu %8llu %s\n", words->lines, words->words,
+		words->bytes, name);
+}
@@ -31,9 +31,10 @@ main()
 	
 	while (ch != '\n')
 	{
-		string1[i] = ch;
-		i++;
-		scanf("%c", &ch);
+		if (i < MAX_SIZE)
+			string1[i++] = ch;
+		if (scanf("%c", &ch) != 1)
+			break;
 	} 
 	size1 = i;
 
@@ -44,9 +45,10 @@ main()
 
 	while (ch != '\n')
 	{
-		string2[i] = ch;
-		i++;
-		scanf("%c", &ch);
+		if (i < MAX_SIZE)
+			string2[i++] = ch;
+		if (scanf("%c", &ch) != 1)
+			break;
 	}
 	size2 = i;
 
@@ -74,7 +76,7 @@ compare(char str1[], char str2[], int size1, int size2)
 
 	compare_size = size1;
 
-	for (i = 0; i <= compare_size; i++)
+	for (i = 0; i < compare_size; i++)
 	{
 		if (str1[i] != str2[i])
 		{
@@ -3,9 +3,16 @@
 *  Purpose: Reads the first ten thousand digits of PI from a 
 *  file and inputs them into a linked list.  Each node contains 
 *  one digit and a link field to the next node.
+*  The file is read in blocks (or mapped into memory) by the fast input
+*  layer in bcgsc_interview_sample_code/C/utilities rather than with one
+*  fscanf() per digit.
+*  Compile: U=../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -I$U digits_pi.c $U/fast_input.c
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include "fast_input.h"
 
 typedef struct node{
 	char digit;
@@ -44,35 +51,56 @@ main()
 void
 CreateList(NodePtr *head, NodePtr *last)
 {
-	char ch;
+	const char *block;
+	size_t length, i;
 	NodePtr temp;
 	FILE *input_data;
-
+	FastInput input;
 
 	input_data = fopen("digits_pi.dat", "r");
-	
-	fscanf(input_data, "%c", &ch); 
+	if (input_data == NULL)
+	{
+		fprintf(stderr, "Cannot open digits_pi.dat\n");
+		return;
+	}
+	if (!FastInputOpen(&input, input_data))
+	{
+		fclose(input_data);
+		return;
+	}
 
-	while(!feof(input_data))
+	/* Each block is as much of the file as was read at once */
+	while ((length = FastInputBlock(&input, &block)) > 0)
 	{
-		/* Create the new node */
-		temp = (NodePtr)malloc(sizeof(Node));
-		temp->digit = ch;
-		temp->link = NULL;
-
-		/* Attach node to end of list */
-		if (*last)  /* If not NULL */
-			(*last)->link = temp;
-
-		/* Update the last pointer */
-		(*last) = temp;	
-
-		/* Update the head pointer if first node */
-		if (!(*head))
-			(*head) = temp;
-		
-		fscanf(input_data, "%c", &ch); 
+		for (i = 0; i < length; i++)
+		{
+			/* Create the new node */
+			temp = (NodePtr)malloc(sizeof(Node));
+			if (temp == NULL)
+			{
+				fprintf(stderr, "Not enough memory for the digits.\n");
+				FastInputClose(&input);
+				fclose(input_data);
+				return;
+			}
+			temp->digit = block[i];
+			temp->link = NULL;
+
+			/* Attach node to end of list */
+			if (*last)  /* If not NULL */
+				(*last)->link = temp;
+
+			/* Update the last pointer */
+			(*last) = temp;	
+
+			/* Update the head pointer if first node */
+			if (!(*head))
+				(*head) = temp;
+		}
 	}
+
+	FastInputClose(&input);
+	fclose(input_data);
 }
 
 /*
@@ -4,45 +4,65 @@
 *  output file until EOF is reached.  At that time a summary of 
 *  the number of upper case, lower case, exclamation points, and space
 *  characters is printed.
+*  The file is read in large blocks (or mapped into memory) by
+*  fast_input.c, each block is echoed with one fwrite(), and the classes
+*  are counted 32 characters a step by CharCountClasses(), both from
+*  bcgsc_interview_sample_code/C/utilities, in place of an fscanf(),
+*  an fprintf() and the islower() ... isspace() tests per character.
+*  Compile: U=../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -I$U char_type.c $U/char_class.c $U/fast_input.c
+*           $U/simd_search.c
 */
 
 #include <stdio.h>
+#include "char_class.h"
+#include "fast_input.h"
 
 main()
 {
-	int spaces = 0, upper = 0, lower = 0, punc = 0, lines = 0;
-	char ch;
+	CharCounts counts = {0};
+	FastInput input;
+	const char *block;
+	size_t length;
 	FILE *input_data;
 	FILE *output_data;
 
 	input_data = fopen("text.dat", "r");
+	if (input_data == NULL)
+	{
+		fprintf(stderr, "char_type: cannot open text.dat\n");
+		return(1);
+	}
 	output_data = fopen("text.print", "w");
+	if (output_data == NULL)
+	{
+		fprintf(stderr, "char_type: cannot open text.print\n");
+		fclose(input_data);
+		return(1);
+	}
 
-	fscanf(input_data, "%c", &ch);
+	if (!FastInputOpen(&input, input_data))
+	{
+		fprintf(stderr, "char_type: out of memory\n");
+		fclose(input_data);
+		fclose(output_data);
+		return(1);
+	}
 
-	while (!feof(input_data))
+	while ((length = FastInputBlock(&input, &block)) > 0)
 	{
-		if (islower(ch))
-			lower++;
-		else if (isupper(ch))
-			upper++;
-		else if (ispunct(ch))
-			punc++;
-		else if (isspace(ch))
-			spaces++;
-		
-		if (ch == '\n')
-			lines++;
-
-	fprintf(output_data, "%c", ch);
-	fscanf(input_data, "%c", &ch);
+		CharCountClasses(&counts, block, length);
+		fwrite(block, 1, length, output_data);
 	}
+	if (FastInputError(&input))
+		fprintf(stderr, "char_type: cannot read text.dat\n");
+	FastInputClose(&input);
 
 	fprintf(output_data, "\n");
-	fprintf(output_data, "Number of lines is %d\n", lines);
-	fprintf(output_data, "Number of uppercase is %d\n", upper); 
-	fprintf(output_data, "Number of lowercase is %d\n", lower);
-	fprintf(output_data, "Number of punctuations is %d\n", punc); 
+	fprintf(output_data, "Number of lines is %llu\n", counts.lines);
+	fprintf(output_data, "Number of uppercase is %llu\n", counts.upper);
+	fprintf(output_data, "Number of lowercase is %llu\n", counts.lower);
+	fprintf(output_data, "Number of punctuations is %llu\n", counts.punct);
 
 	fclose(input_data);
 	fclose(output_data);
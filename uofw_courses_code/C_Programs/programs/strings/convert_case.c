@@ -2,10 +2,17 @@
 *  Date: Nov. 23 2002  
 *  Purpose: Converts the lowercase letters of its string argument to 
 *  uppercase leaving other characters unchanged.
+*  string_toupper() converts the whole string with CharToUpper() from
+*  bcgsc_interview_sample_code/C/utilities/char_class.c, 32 characters
+*  a step, rather than testing islower() on each character with a
+*  strlen() call every time round the loop.
+*  Compile: U=../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -I$U convert_case.c $U/char_class.c $U/simd_search.c
 */
 
 #include <stdio.h>
-#include <ctype.h>
+#include <string.h>
+#include "char_class.h"
 
 #define STRSIZ 80
 
@@ -29,11 +36,7 @@ main()
 char *
 string_toupper(char *str)
 {
-	int i;
-
-	for (i = 0; i < strlen(str); ++i)
-		if (islower(str[i]))
-			str[i] = toupper(str[i]);
+	CharToUpper(str, str, strlen(str));
 
 	return(str);
 }
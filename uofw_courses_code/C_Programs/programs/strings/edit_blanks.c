@@ -3,63 +3,48 @@
 *  Purpose: The function trim blanks takes as it's input a string with leading
 *  and trailing blanks.  It then removes the leadingand trailing blanks and 
 *  returns the edited string.
+*  The trimming is now done in place by TextNormalize() from
+*  bcgsc_interview_sample_code/C/utilities/text_normal.c, which also
+*  turns each run of blanks inside the string into one space.  The line
+*  is read with fgets(), so a long one can no longer overrun to_trim.
+*  Compile: U=../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -I$U edit_blanks.c $U/text_normal.c $U/simd_search.c
 */
 
 #include <stdio.h>
 #include <string.h>
+#include "text_normal.h"
 
 #define MAX_LENGTH 81
 
 /* Function Prototype */
-void trim_blanks(const char to_trim[], char trimmed[]);
+void trim_blanks(char to_trim[]);
 
 main()
 {
 	char to_trim[MAX_LENGTH] = {"Hello this is me"};
-	char trimmed[MAX_LENGTH];
-	
+
 	printf("Enter a string please, \n>");
-	gets(to_trim);
+	if (fgets(to_trim, MAX_LENGTH, stdin) == NULL)
+		return(1);
 
-	trim_blanks(to_trim, trimmed);
+	trim_blanks(to_trim);
 
 	printf("\nThe edited string is: \n");
-	puts(trimmed);
+	puts(to_trim);
+	return(0);
 }
 
 /*
 *  Function: trim_blanks
+*  Drops the newline fgets() kept, then tidies the string where it is.
 */
 void
-trim_blanks(const char to_trim[], char trimmed[])
+trim_blanks(char to_trim[])
 {
-	int i;
-	int first_non_blank;
-	int last_non_blank;
-	int difference;
-	
-	/* Find subscript of first nonblank in to_trim */
-	for(i = 0; i <= MAX_LENGTH - 1; i++)
-	{
-		if(to_trim[i] != ' ')
-		{
-			first_non_blank = i;
-			break;
-		}
-	}
-
-	/* find subscript of last nonblank in to_trim */
-	for(i = first_non_blank; i <= MAX_LENGTH - 1; i++)
-	{
-		if(to_trim[i] != ' ' && to_trim[i] != '\n' && to_trim[i] != '\0')
-			last_non_blank = i;
-	}
-	difference = (last_non_blank - first_non_blank) + 1;
+	size_t length;
 
-	/* Use strncpy to store trimmed string in trimmed */
-		strncpy(trimmed, &to_trim[first_non_blank], difference);
-		trimmed[difference] = '\0';
+	length = strcspn(to_trim, "\n");
+	length = TextNormalize(to_trim, length, TEXT_CASE_KEEP);
+	to_trim[length] = '\0';
 }
-
-
-
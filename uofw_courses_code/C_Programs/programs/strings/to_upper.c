@@ -3,25 +3,29 @@
 *  Purpose: Illustrate the use of the <ctype.h> function toupper().
 *  This function converts a string to uppercase.  The <ctype.h> library is
 *  the character classification/conversion library. 
+*  The conversion is now CharToUpper() from
+*  bcgsc_interview_sample_code/C/utilities/char_class.c, which converts
+*  32 characters a step (with the same result as toupper() for ASCII)
+*  instead of calling toupper() for each one.
+*  Compile: U=../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -I$U to_upper.c $U/char_class.c $U/simd_search.c
 */
 
 #include <stdio.h>
 #include <string.h>
-#include <ctype.h>
+#include "char_class.h"
 
 #define SIZE 81
 
 main()
 {
 	char str[SIZE];
-	int i;
 	int length;
 
 	strcpy(str, "this is a test");
 	length = strlen(str);
 
-	for(i = 0; i < length; i++)
-		str[i] = toupper(str[i]);
+	CharToUpper(str, str, length);
 	printf("%s", str);
 	printf("\n");
 }
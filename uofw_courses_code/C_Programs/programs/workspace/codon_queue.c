@@ -1,16 +1,28 @@
 /* Author: Malachi Griffith
 *  Date: Dec. 15 2002 
 *  Purpose: Use a Queue to store and display codon data.
+*  The data file is read a word at a time by the fast input layer in
+*  bcgsc_interview_sample_code/C/utilities (mapped into memory or read
+*  in blocks) rather than by fscanf() behind a feof() test.  Words too
+*  long for their field are cut short instead of overrunning it.
+*  Compile: U=../../../../bcgsc_interview_sample_code/C/utilities
+*           gcc -I$U codon_queue.c $U/fast_input.c
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include "fast_input.h"
+
+#define ABBREV_SIZE 5
+#define FULLNAME_SIZE 20
+#define CODON_SIZE 5
 
 typedef struct node{
 		char letter;
-		char abbrev[5];
-		char fullname[20];
-		char codon[5];
+		char abbrev[ABBREV_SIZE];
+		char fullname[FULLNAME_SIZE];
+		char codon[CODON_SIZE];
 		struct node *link;
 	} Node;
 
@@ -19,6 +31,9 @@ typedef Node *NodePtr;
 /* Function Prototypes */
 void Enqueue(NodePtr *front_ptr, NodePtr *last_ptr, char letter, 
 	     char abbrev[], char fullname[], char codon[]);
+int ReadCodon(FastInput *input, char *letter, char abbrev[],
+	      char fullname[], char codon[]);
+int ReadWord(FastInput *input, char word[], size_t size);
 void PrintQueue(NodePtr node_ptr);
 void Dequeue(NodePtr *front_ptr, NodePtr *last_ptr);
 int IsEmpty(NodePtr node_ptr);
@@ -30,32 +45,82 @@ main()
 	NodePtr last = NULL;
 	
 	char letter;
-	char abbrev[5];
-	char fullname[20];
-	char codon[5];
+	char abbrev[ABBREV_SIZE];
+	char fullname[FULLNAME_SIZE];
+	char codon[CODON_SIZE];
 	
 	FILE *input_data;
+	FastInput input;
 	
 	input_data = fopen("codon.dat", "r");
+	if (input_data == NULL)
+	{
+		fprintf(stderr, "Cannot open codon.dat\n");
+		return(1);
+	}
+	if (!FastInputOpen(&input, input_data))
+	{
+		fclose(input_data);
+		return(1);
+	}
 
 	/* Create the list */
-	fscanf(input_data, " %c %s %s %s", &letter, abbrev, fullname, codon);
-
-	while(!feof(input_data))
-	{
+	while (ReadCodon(&input, &letter, abbrev, fullname, codon))
 		Enqueue(&front, &last, letter, abbrev, fullname, codon);
-		fscanf(input_data, " %c %s %s %s", &letter, abbrev, 
-			fullname, codon);
-	}
+
+	FastInputClose(&input);
+	fclose(input_data);
 
 	/* Print the list */
 	PrintQueue(front);
 	
 	/* Delete the queue */
-	while (!IsEmpty)
+	while (!IsEmpty(front))
 	{
 		Dequeue(&front, &last);
 	}
+	return(0);
+}
+
+/*
+*  Function: ReadCodon()
+*  Reads one line's worth: the letter, abbreviation, full name and
+*  codon.  Returns 0 when there is not a whole entry left.
+*/
+int
+ReadCodon(FastInput *input, char *letter, char abbrev[], char fullname[],
+	  char codon[])
+{
+	char word[2];
+
+	if (!ReadWord(input, word, sizeof(word)))
+		return(0);
+	*letter = word[0];
+
+	return(ReadWord(input, abbrev, ABBREV_SIZE) &&
+	       ReadWord(input, fullname, FULLNAME_SIZE) &&
+	       ReadWord(input, codon, CODON_SIZE));
+}
+
+/*
+*  Function: ReadWord()
+*  Copies the next word into word[], cut to size - 1 characters.
+*  Returns 0 at the end of the input.
+*/
+int
+ReadWord(FastInput *input, char word[], size_t size)
+{
+	const char *next;
+	size_t length;
+
+	if (!FastInputWord(input, &next, &length))
+		return(0);
+
+	if (length > size - 1)
+		length = size - 1;
+	memcpy(word, next, length);
+	word[length] = '\0';
+	return(1);
 }
 
 /*
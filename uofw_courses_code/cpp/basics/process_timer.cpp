@@ -1,11 +1,18 @@
 #include <iostream>
-#include <ctime>
+#include <chrono>
 using namespace std;
 
+// PROBE_SCOPE() and the probe registry.
+// Compile: g++ -std=c++11 -I../../../bcgsc_interview_sample_code/C++/utilities
+//          process_timer.cpp ../../../bcgsc_interview_sample_code/C++/utilities/probe.cpp
+#include "probe.h"
+
+// Wall clock time on a steady clock.  clock() / CLOCKS_PER_SEC used to
+// truncate to whole seconds (and counted CPU time, not elapsed time).
 class timer 
 {
 private:
-	clock_t start;
+	chrono::steady_clock::time_point start;
 
 public:
 	timer();	// constructor
@@ -14,22 +21,21 @@ public:
 
 timer::timer()
 {
-	start = clock();
+	start = chrono::steady_clock::now();
 }
 
 timer::~timer()
 {
-	clock_t end;
-
-	end = clock();
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
 
-	cout << "Elapsed time: " << (end - start) / CLOCKS_PER_SEC << endl;
+	cout << "Elapsed time: " << elapsed.count() << " seconds" << endl;
 }
 
 
 int main()
 {
 	timer obj;
+	PROBE_SCOPE("main");	// Also shows up in the probe dump at exit.
 	char c;
 
 	// delay ...
@@ -1,17 +1,21 @@
 #include <iostream>
 using namespace std;
 
-#define SIZE 10
+// The characters are kept in a DynamicStack, which grows as needed, so the
+// old fixed SIZE and the "Stack is full" case are gone.
+// Compile: g++ -I../../../bcgsc_interview_sample_code/C++/utilities stack_class.cpp
+#include "dynamic_stack.h"
 
 // Declare a stack class for characters.
 class stack{
-	char stck[SIZE];	// holds the stack.
-	int tos;			// index of the top of the stack.
+	DynamicStack<char> stck;	// holds the stack.
 
 public:
 	stack();	// constructor
 	void push(char ch);  // push character on stack.
+	void push(const char *str);  // push a whole string in one call.
 	char pop();	// Pop character from stack.
+	bool is_empty() const {return stck.empty();}
 };
 
 
@@ -19,32 +23,34 @@ public:
 stack::stack()
 {
 	cout << "Constructing a stack\n";
-	tos = 0;
 }
 
 // Push a character
 void stack::push(char ch)
 {
-	if (tos==SIZE)
-	{
-		cout << "Stack is full\n";
-		return;
-	}
+	stck.push(ch);
+}
+
+// Push every character of a string
+void stack::push(const char *str)
+{
+	size_t len = 0;
+
+	while (str[len] != '\0')
+		len++;
 
-	stck[tos] = ch;
-	tos++;
+	stck.push_bulk(str, len);
 }
 
 // Pop a character.
 char stack::pop()
 {
-	if(tos==0)
+	if(stck.empty())
 	{
 		cout << "Stack is empty\n";
 		return 0;  // Return null on empty stack
 	}
-	tos--;
-	return stck[tos];
+	return stck.pop();
 }
 
 
@@ -64,8 +70,14 @@ int main()
 	for (i=0; i<3; i++)
 		cout << "Pop s1: " << s1.pop() << "\n";
 
-	for (i=0; i<3; i++) 
+	for (i=0; i<3; i++)
 		cout << "Pop s2: " << s2.pop() << "\n";
 
+	// No more SIZE limit, this used to overflow a 10 character stack.
+	s1.push("a stack with no fixed size");
+	while (!s1.is_empty())
+		cout << s1.pop();
+	cout << "\n";
+
 	return 0;
 }
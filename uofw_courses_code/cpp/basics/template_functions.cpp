@@ -1,6 +1,15 @@
 #include <iostream>
 using namespace std;
 
+#include "algorithms.h"
+
+/***
+* Compile: B=../../../bcgsc_interview_sample_code
+*	g++ -I$B/C++/utilities -I$B/C/utilities ... with sort_lib.c,
+*	thread_pool.c, work_deque.c and simd_search.c from $B/C/utilities,
+*	-pthread
+***/
+
 /***
 * When instructions are identical and functions only differ in data type,
 * you can use template functions instead of function overloading.
@@ -20,18 +29,19 @@ template <class T>
 void bubble_sort(T list[], int size)
 {
 	int i;
-	int flg = TRUE;
+	bool flg = true;
 
-	while (flg = TRUE)
+	/* Was "while (flg = TRUE)", an assignment, so it never stopped */
+	while (flg == true)
 	{
-		flg = FALSE;
+		flg = false;
 
 		for (i = 0; i < size-1; i++)
 		{
 			if(list[i+1] < list[i])
 			{
-				swap(list[i], list[i+1]);
-				flg = TRUE;
+				::swap(list[i], list[i+1]);	// Ours, not std::swap
+				flg = true;
 			}
 		}
 	}
@@ -43,4 +53,18 @@ void bubble_sort(T list[], int size)
 *	bubble_sort(arr, 100);
 * The compiler will generate the code for bubble_sort replacing every 
 * occurance of T with int.  Same thing will happen with swap.
-***/
\ No newline at end of file
+***/
+/***
+* bubble_sort is O(n^2), fine for a handful of items but hopeless for a
+* million.  fast_sort takes the same arguments and uses algo_sort() from
+* the algorithms library (algorithms.h): a radix sort for int and double,
+* otherwise the shared introsort (parallel on big arrays), so any T with
+* operator< will do.  The library also has stable_sort, partial_sort,
+* binary_search, merge and partition, all templates like these.
+***/
+
+template <class T>
+void fast_sort(T list[], int size)
+{
+	algo_sort(list, list + size);
+}
\ No newline at end of file